@@ -4,9 +4,20 @@
 /// This is a minimal working example demonstrating free-streaming
 /// of particles in a periodic domain.
 
+#include <vps/particles/dispatch.h>
 #include <vps/particles/particles.h>
 #include <vps/grid/grid.h>
+#include <vps/grid/static_grid.h>
+#include <vps/kernels/cell_index.h>
+#include <vps/kernels/deposit.h>
+#include <vps/kernels/moments.h>
+#include <vps/kernels/pipeline.h>
+#include <vps/kernels/push.h>
+#include <vps/memory/arena.h>
+#include <vps/memory/isa.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -36,69 +47,45 @@ vps::particles::Particles initialize_particles(
     const std::size_t n_v = n_particles_per_cell;  // Velocity points per cell
     const std::size_t total_particles = n_cells * n_v;
     
-    vps::particles::Particles particles(total_particles);
-    
     // Velocity range: -4*v_th to +4*v_th
     const double v_min = -4.0 * v_thermal;
     const double v_max = 4.0 * v_thermal;
     const double dv = (v_max - v_min) / static_cast<double>(n_v);
-    
-    // Generate particles
-    for (std::size_t i = 0; i < n_cells; ++i) {
-        double x = grid.cell_center(i);
+    const double norm = 1.0 / (std::sqrt(2.0 * std::numbers::pi) * v_thermal);
+    
+    // Generate particles: point p is velocity j of cell i, written in one parallel pass
+    vps::particles::Particles particles;
+    particles.fill_with(total_particles, [&](std::size_t p) {
+        const std::size_t i = p / n_v;
+        const std::size_t j = p % n_v;
+        const double x = grid.cell_center(i);
+        const double v = v_min + (static_cast<double>(j) + 0.5) * dv;
         
         // Density perturbation factor
-        double density_factor = 1.0 + epsilon * std::cos(k * x);
+        const double density_factor = 1.0 + epsilon * std::cos(k * x);
         
-        for (std::size_t j = 0; j < n_v; ++j) {
-            double v = v_min + (static_cast<double>(j) + 0.5) * dv;
-            
-            // Maxwellian distribution
-            double f_maxwell = std::exp(-v * v / (2.0 * v_thermal * v_thermal));
-            f_maxwell /= std::sqrt(2.0 * std::numbers::pi) * v_thermal;
-            
-            // Apply density perturbation
-            double f = f_maxwell * density_factor;
-            
-            particles.push_back(x, v, f);
-        }
-    }
+        // Maxwellian distribution
+        const double f_maxwell = norm * std::exp(-v * v / (2.0 * v_thermal * v_thermal));
+        
+        // Apply density perturbation
+        return std::array{x, v, f_maxwell * density_factor};
+    });
     
     return particles;
 }
 
 /// @brief Compute density on grid from particles
 ///
-/// Uses first-order (NGP - Nearest Grid Point) deposition
+/// Uses first-order (NGP - Nearest Grid Point) deposition, locating cells
+/// on mesh (density's grid, or the static grid made from it)
+template <vps::grid::UniformGrid G>
 void compute_density(
     const vps::particles::Particles& particles,
-    const vps::grid::Grid& grid,
-    vps::grid::Field& density)
+    vps::grid::Field& density,
+    const G& mesh)
 {
     density.zero();
-    
-    const double inv_dx = 1.0 / grid.dx();
-    
-    for (std::size_t p = 0; p < particles.size(); ++p) {
-        double x = particles.x(p);
-        double f = particles.f(p);
-        
-        // NGP: deposit to nearest cell
-        std::size_t i = grid.cell_index(x);
-        density[i] += f * inv_dx;
-    }
-}
-
-/// @brief Apply periodic boundary conditions to particles
-void apply_periodic_bc(
-    vps::particles::Particles& particles,
-    const vps::grid::Grid& grid)
-{
-    auto x_span = particles.x();
-    
-    for (std::size_t p = 0; p < particles.size(); ++p) {
-        x_span[p] = grid.wrap_position(x_span[p]);
-    }
+    vps::kernels::deposit_ngp(particles, density, mesh);
 }
 
 /// @brief Print simulation status
@@ -108,6 +95,9 @@ void print_status(
     const vps::particles::Particles& particles,
     const vps::grid::Field& density)
 {
+    // Conservation monitors; the reduction is identical for any thread count
+    const auto m = vps::kernels::moments(particles);
+
     // Find min/max density
     double rho_min = density[0];
     double rho_max = density[0];
@@ -122,6 +112,10 @@ void print_status(
               << " | particles = " << particles.size()
               << " | rho: [" << std::setw(8) << rho_min 
               << ", " << std::setw(8) << rho_max << "]"
+              << std::scientific << std::setprecision(10)
+              << " | M = " << m.mass
+              << " | P = " << std::setw(17) << m.momentum
+              << " | E = " << m.energy
               << std::endl;
 }
 
@@ -135,7 +129,7 @@ int main() {
     // =========================================================================
     
     // Grid parameters
-    const std::size_t n_cells = 64;
+    constexpr std::size_t n_cells = 64;  // Compiled in: visit_grid makes a StaticGrid
     const double x_min = 0.0;
     const double x_max = 2.0 * std::numbers::pi;
     
@@ -143,6 +137,8 @@ int main() {
     const double dt = 0.1;
     const int n_steps = 100;
     const int print_interval = 10;
+    const std::size_t sort_interval = 10;  // Steps between cell re-sorts
+    const bool fast_forward = true;        // No field: jump from one printed step to the next
     
     // Physics parameters
     const double v_thermal = 1.0;
@@ -160,6 +156,8 @@ int main() {
     std::cout << "  Time step:     " << dt << "\n";
     std::cout << "  Total steps:   " << n_steps << "\n";
     std::cout << "  Particles/cell:" << n_particles_per_cell << "\n";
+    std::cout << "  Sort interval: " << sort_interval << "\n";
+    std::cout << "  Fast-forward:  " << (fast_forward ? "on" : "off") << "\n";
     std::cout << "\n";
     
     // Create grid
@@ -171,38 +169,83 @@ int main() {
     // Initialize particles
     auto particles = initialize_particles(grid, n_particles_per_cell, v_thermal, epsilon, k);
     
-    std::cout << "Total particles: " << particles.size() << "\n\n";
+    // Order particles by cell so deposits walk the field sequentially
+    vps::kernels::CellIndex cell_index(grid, sort_interval);
+    cell_index.sort(particles);
+    
+    std::cout << "Total particles: " << particles.size() << "\n";
+    std::cout << "Storage:         "
+              << vps::memory::to_string(particles.allocation_report().backing)
+              << (particles.allocation_report().thp_advised ? " (THP advised)" : "") << "\n";
+    std::cout << "SIMD kernels:    " << vps::memory::to_string(vps::memory::kernel_isa()) << "\n";
+    std::cout << "Parallel grain:  " << vps::particles::parallel_grain() << " points/thread, "
+              << vps::particles::max_workers() << " workers\n\n";
     
     // Compute initial density
-    compute_density(particles, grid, density);
+    compute_density(particles, density, grid);
     
     // =========================================================================
     // Main Time Loop
     // =========================================================================
     
+    // One fused pass per step: push with branchless periodic wrap and NGP
+    // deposit run on each cache-sized chunk of points before the next
+    namespace stage = vps::kernels::stage;
+    auto free_streaming = stage::stream_and_wrap(dt, grid) | stage::index(grid)
+                        | stage::deposit_ngp(density);
+    
+    // Transient kernel buffers come from one arena, rewound every step
+    vps::memory::StepArena scratch;
+    vps::memory::ScratchScope scratch_scope(scratch);
+    
     std::cout << "Starting simulation...\n";
     std::cout << "----------------------------------------------------\n";
     
     print_status(0, 0.0, particles, density);
     
-    for (int step = 1; step <= n_steps; ++step) {
-        // Free streaming: advance positions
-        // x_new = x_old + v * dt
-        vps::particles::advance_positions(particles, dt);
-        
-        // Apply periodic boundary conditions
-        apply_periodic_bc(particles, grid);
-        
-        // Compute density (for diagnostics)
-        compute_density(particles, grid, density);
-        
-        // Print status
-        if (step % print_interval == 0) {
-            print_status(step, static_cast<double>(step) * dt, particles, density);
+    // The field-free jump and the density deposits take a StaticGrid when
+    // the grid has the compiled-in cell count; the fused pipeline keeps the
+    // runtime grid its stages were built with
+    vps::grid::visit_grid<n_cells>(grid, [&](const auto& mesh) {
+        if (fast_forward) {
+            // Without a field x(t) = x0 + v t is exact: one wrapped pass covers all
+            // steps up to the next printed one, and density is only needed there
+            for (int step = 0; step < n_steps;) {
+                scratch.reset();
+                const int next =
+                    std::min(step + print_interval - step % print_interval, n_steps);
+                vps::kernels::fast_forward(particles, mesh, dt,
+                                           static_cast<std::size_t>(next - step));
+                step = next;
+
+                cell_index.resort(particles);
+                if (step % print_interval == 0) {
+                    compute_density(particles, density, mesh);
+                    print_status(step, static_cast<double>(step) * dt, particles, density);
+                }
+            }
+        } else {
+            for (int step = 1; step <= n_steps; ++step) {
+                scratch.reset();
+
+                // Free streaming x_new = x_old + v * dt, periodic BC and density
+                density.zero();
+                free_streaming.run(particles);
+
+                // Keep the cell ordering up to date
+                cell_index.step(particles);
+
+                // Print status
+                if (step % print_interval == 0) {
+                    print_status(step, static_cast<double>(step) * dt, particles, density);
+                }
+            }
         }
-    }
+    });
     
     std::cout << "----------------------------------------------------\n";
+    std::cout << "Scratch arena:   " << scratch.capacity() << " bytes, "
+              << scratch.upstream_allocations() << " heap allocations\n";
     std::cout << "Simulation complete!\n";
     
     return 0;
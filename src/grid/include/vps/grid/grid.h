@@ -5,11 +5,26 @@
 /// @brief 1D uniform spatial grid for Vlasov-Poisson simulations
 ///
 /// This module provides a uniform grid in configuration space (x-direction)
-/// with support for periodic boundary conditions.
+/// with support for periodic boundary conditions. Grid and Field are
+/// templated on precision; Grid/Field are the double-precision defaults and
+/// GridF/FieldF their single-precision counterparts.
+///
+/// The scalar conversions wrap through fmod and are called out of line, so
+/// a loop around them stays scalar. cell_indices, wrap_positions and the
+/// span overload of interpolation_weights do the same work for a whole
+/// span in one SIMD loop. Points within one period of the domain are
+/// wrapped with a conditional add or subtract of L, which is what fmod
+/// computes exactly there. The rare point further out goes through the
+/// scalar path afterwards, so the batch results are bit-identical to it.
+
+#include <vps/memory/buffer.h>
 
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace vps::grid {
@@ -21,6 +36,7 @@ enum class BoundaryCondition {
 };
 
 /// @brief 1D uniform spatial grid
+/// @tparam T Floating-point type of coordinates
 ///
 /// Represents a uniform discretization of a 1D spatial domain [x_min, x_max].
 /// The grid stores cell-centered quantities and provides utilities for:
@@ -37,12 +53,13 @@ enum class BoundaryCondition {
 ///            ^
 ///        cell center at x_min + dx/2
 /// @endcode
-class Grid {
+template <std::floating_point T>
+class BasicGrid {
 public:
     // =========================================================================
     // Type Aliases
     // =========================================================================
-    using value_type = double;
+    using value_type = T;
     using size_type = std::size_t;
 
     // =========================================================================
@@ -55,17 +72,17 @@ public:
     /// @param x_max Right boundary of domain
     /// @param bc Boundary condition type
     /// @throws std::invalid_argument if n_cells == 0 or x_min >= x_max
-    Grid(size_type n_cells, 
-         value_type x_min, 
-         value_type x_max, 
-         BoundaryCondition bc = BoundaryCondition::Periodic);
+    BasicGrid(size_type n_cells, 
+              value_type x_min, 
+              value_type x_max, 
+              BoundaryCondition bc = BoundaryCondition::Periodic);
 
     // Default copy/move
-    Grid(const Grid&) = default;
-    Grid(Grid&&) noexcept = default;
-    Grid& operator=(const Grid&) = default;
-    Grid& operator=(Grid&&) noexcept = default;
-    ~Grid() = default;
+    BasicGrid(const BasicGrid&) = default;
+    BasicGrid(BasicGrid&&) noexcept = default;
+    BasicGrid& operator=(const BasicGrid&) = default;
+    BasicGrid& operator=(BasicGrid&&) noexcept = default;
+    ~BasicGrid() = default;
 
     // =========================================================================
     // Grid Properties
@@ -117,6 +134,24 @@ public:
     [[nodiscard]] std::pair<value_type, value_type> 
     interpolation_weights(value_type x) const noexcept;
 
+    /// @brief Batch cell_index: idx[i] = cell_index(x[i])
+    /// @tparam U Precision of the positions (may differ from the grid's)
+    /// @param x Positions
+    /// @param idx Output cells, idx.size() == x.size()
+    template <std::floating_point U>
+    void cell_indices(std::span<const U> x, std::span<std::uint32_t> idx) const noexcept;
+
+    /// @brief Batch interpolation_weights, with the cells they refer to
+    /// @param x Positions
+    /// @param idx Output cells: idx[i] = cell_index(x[i])
+    /// @param right Output weights of cell idx[i] + 1:
+    ///              right[i] = interpolation_weights(x[i]).second
+    ///
+    /// The left weight is 1 - right[i].
+    template <std::floating_point U>
+    void interpolation_weights(std::span<const U> x, std::span<std::uint32_t> idx,
+                               std::span<value_type> right) const noexcept;
+
     // =========================================================================
     // Boundary Handling
     // =========================================================================
@@ -125,6 +160,9 @@ public:
     /// @param x Position (possibly outside domain)
     /// @return Position wrapped to domain (for periodic BC)
     [[nodiscard]] value_type wrap_position(value_type x) const noexcept;
+
+    /// @brief Batch wrap_position: x[i] = wrap_position(x[i]) in place
+    void wrap_positions(std::span<value_type> x) const noexcept;
     
     /// @brief Wraps index i into valid range [0, n_cells)
     /// @param i Index (possibly negative or >= n_cells)
@@ -142,6 +180,9 @@ public:
     [[nodiscard]] std::vector<value_type> cell_centers() const;
 
 private:
+    /// @brief Clamped cell of a position that is already wrapped
+    [[nodiscard]] size_type cell_of_wrapped(value_type x_wrapped) const noexcept;
+
     size_type n_cells_;       ///< Number of cells
     value_type x_min_;        ///< Left boundary
     value_type x_max_;        ///< Right boundary
@@ -151,30 +192,48 @@ private:
     BoundaryCondition bc_;    ///< Boundary condition
 };
 
+/// @brief Double-precision grid (the default)
+using Grid = BasicGrid<double>;
+
+/// @brief Single-precision grid
+using GridF = BasicGrid<float>;
+
+extern template class BasicGrid<float>;
+extern template class BasicGrid<double>;
+
 // =============================================================================
 // Field Class - Stores quantities on the grid
 // =============================================================================
 
 /// @brief Stores a scalar field on the grid
+/// @tparam T Floating-point type of the field values
 ///
 /// This class manages storage for cell-centered field values like
 /// density, potential, electric field, etc.
-class Field {
+template <std::floating_point T>
+class BasicField {
 public:
-    using value_type = double;
+    using value_type = T;
     using size_type = std::size_t;
+    using grid_type = BasicGrid<T>;
 
     /// @brief Construct field on given grid
     /// @param grid The grid this field lives on
     /// @param initial_value Initial value for all cells
-    explicit Field(const Grid& grid, value_type initial_value = 0.0);
+    explicit BasicField(const grid_type& grid, value_type initial_value = value_type{});
 
-    // Default copy/move
-    Field(const Field&) = default;
-    Field(Field&&) noexcept = default;
-    Field& operator=(const Field&) = default;
-    Field& operator=(Field&&) noexcept = default;
-    ~Field() = default;
+    /// @brief Construct field with an allocation policy, e.g. huge pages
+    /// @param grid The grid this field lives on
+    /// @param initial_value Initial value for all cells
+    /// @param policy How the value array is allocated
+    BasicField(const grid_type& grid, value_type initial_value, memory::AllocationPolicy policy);
+
+    // Deep copy (same policy), owning move
+    BasicField(const BasicField& other);
+    BasicField(BasicField&& other) noexcept;
+    BasicField& operator=(const BasicField& other);
+    BasicField& operator=(BasicField&& other) noexcept;
+    ~BasicField() = default;
 
     // =========================================================================
     // Access
@@ -196,7 +255,10 @@ public:
     [[nodiscard]] const value_type* data() const noexcept;
     
     /// @brief Returns reference to the underlying grid
-    [[nodiscard]] const Grid& grid() const noexcept;
+    [[nodiscard]] const grid_type& grid() const noexcept;
+
+    /// @brief Returns how the value array was actually obtained
+    [[nodiscard]] const memory::AllocationReport& allocation_report() const noexcept;
 
     // =========================================================================
     // Operations
@@ -213,10 +275,20 @@ public:
     [[nodiscard]] value_type interpolate(value_type x) const noexcept;
 
 private:
-    const Grid* grid_;              ///< Pointer to grid (non-owning)
-    std::vector<value_type> data_;  ///< Field values
+    const grid_type* grid_;    ///< Pointer to grid (non-owning)
+    memory::Buffer storage_;   ///< Field values, aligned
+    size_type size_ = 0;       ///< Number of values (== grid cells)
 };
 
+/// @brief Double-precision field (the default)
+using Field = BasicField<double>;
+
+/// @brief Single-precision field
+using FieldF = BasicField<float>;
+
+extern template class BasicField<float>;
+extern template class BasicField<double>;
+
 } // namespace vps::grid
 
 #endif // VPS_GRID_GRID_H
@@ -0,0 +1,320 @@
+#ifndef VPS_GRID_STATIC_GRID_H
+#define VPS_GRID_STATIC_GRID_H
+
+/// @file static_grid.h
+/// @brief Uniform grid with the cell count and boundary condition fixed at compile time
+///
+/// BasicGrid reads n_cells and the boundary condition from members and
+/// converts out of line, so every call tests the boundary condition and
+/// every wrap_index divides by a runtime value. BasicStaticGrid<T, N, BC>
+/// makes both template arguments instead. The boundary branch folds away,
+/// the scalar conversions inline into the caller's loop, and wrap_index is
+/// a constant modulo, or a mask for power-of-two N.
+///
+/// The scalar arithmetic is BasicGrid's, operation for operation: a point
+/// within one period is wrapped by a conditional add or subtract of L, a
+/// point further out by fmod, and the cell is the clamped truncation of
+/// (x - x_min) / dx. Cells and wrapped positions therefore match to_grid()
+/// exactly; weights may differ by a rounding where one side is compiled
+/// with FMA contraction. The batch span calls run to_grid()'s own loops,
+/// cloned per ISA in grid.cpp, so they are bit-identical to Grid's.
+///
+/// Kernels templated on the UniformGrid concept accept either type. Grids
+/// from a configuration file stay runtime Grids; visit_grid hands a kernel
+/// the static grid when the runtime cell count is one of a few compiled
+/// sizes:
+///
+/// @code
+/// visit_grid<256, 1024, 4096>(grid, [&](const auto& g) {
+///     run_simulation(g);   // instantiated for each size, plus Grid itself
+/// });
+/// @endcode
+
+#include <vps/grid/grid.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vps::grid {
+
+// =============================================================================
+// UniformGrid Concept
+// =============================================================================
+
+/// @brief A 1D uniform grid: BasicGrid or BasicStaticGrid
+template <typename G>
+concept UniformGrid = requires(const G& g, typename G::value_type x, std::ptrdiff_t i,
+                               std::span<const typename G::value_type> xs,
+                               std::span<typename G::value_type> ys,
+                               std::span<std::uint32_t> idx) {
+    typename G::value_type;
+    typename G::size_type;
+    { g.n_cells() } -> std::convertible_to<std::size_t>;
+    { g.x_min() } -> std::convertible_to<typename G::value_type>;
+    { g.x_max() } -> std::convertible_to<typename G::value_type>;
+    { g.dx() } -> std::convertible_to<typename G::value_type>;
+    { g.boundary_condition() } -> std::same_as<BoundaryCondition>;
+    { g.cell_index(x) } -> std::convertible_to<std::size_t>;
+    { g.interpolation_weights(x) };
+    { g.wrap_position(x) } -> std::convertible_to<typename G::value_type>;
+    { g.wrap_index(i) } -> std::convertible_to<std::size_t>;
+    // Batch calls the kernels locate a block of points with
+    g.cell_indices(xs, idx);
+    g.interpolation_weights(xs, idx, ys);
+    g.wrap_positions(ys);
+};
+
+// =============================================================================
+// BasicStaticGrid
+// =============================================================================
+
+/// @brief 1D uniform grid with N cells and boundary condition BC fixed at compile time
+/// @tparam T Floating-point type of coordinates
+/// @tparam N Number of cells
+/// @tparam BC Boundary condition
+///
+/// Same cell-centered layout as BasicGrid; only the domain bounds are
+/// runtime values. The equivalent BasicGrid is kept alongside them for
+/// the batch calls.
+template <std::floating_point T, std::size_t N, BoundaryCondition BC = BoundaryCondition::Periodic>
+class BasicStaticGrid {
+    static_assert(N > 0, "Grid must have at least one cell");
+
+public:
+    // =========================================================================
+    // Type Aliases
+    // =========================================================================
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// @brief True if the periodic wrap_index is a mask
+    static constexpr bool power_of_two = std::has_single_bit(N);
+
+    // =========================================================================
+    // Constructors
+    // =========================================================================
+
+    /// @brief Construct a grid over [x_min, x_max)
+    /// @throws std::invalid_argument if x_min >= x_max
+    BasicStaticGrid(value_type x_min, value_type x_max)
+        : x_min_(x_min)
+        , x_max_(x_max)
+        , length_(x_max - x_min)
+        , dx_(length_ / static_cast<value_type>(N))
+        , inv_dx_(value_type{1} / dx_)
+        , runtime_(N, x_min, x_max, BC)  // throws if x_min >= x_max
+    {}
+
+    /// @brief Specialize a runtime grid, e.g. one read from a configuration file
+    /// @throws std::invalid_argument if grid does not have N cells and condition BC
+    explicit BasicStaticGrid(const BasicGrid<T>& grid)
+        : BasicStaticGrid(grid.x_min(), grid.x_max())
+    {
+        if (grid.n_cells() != N || grid.boundary_condition() != BC) {
+            throw std::invalid_argument("Grid does not match the static cell count or boundary");
+        }
+    }
+
+    /// @brief Returns the equivalent runtime grid (for fields and runtime kernels)
+    [[nodiscard]] BasicGrid<T> to_grid() const { return runtime_; }
+
+    // =========================================================================
+    // Grid Properties
+    // =========================================================================
+
+    /// @brief Returns the number of cells, N
+    [[nodiscard]] static constexpr size_type n_cells() noexcept { return N; }
+
+    /// @brief Returns the left boundary
+    [[nodiscard]] value_type x_min() const noexcept { return x_min_; }
+
+    /// @brief Returns the right boundary
+    [[nodiscard]] value_type x_max() const noexcept { return x_max_; }
+
+    /// @brief Returns the domain length
+    [[nodiscard]] value_type length() const noexcept { return length_; }
+
+    /// @brief Returns the cell width (dx)
+    [[nodiscard]] value_type dx() const noexcept { return dx_; }
+
+    /// @brief Returns the boundary condition, BC
+    [[nodiscard]] static constexpr BoundaryCondition boundary_condition() noexcept { return BC; }
+
+    // =========================================================================
+    // Position/Index Conversion
+    // =========================================================================
+
+    /// @brief Returns the cell-center position for cell index i
+    [[nodiscard]] value_type cell_center(size_type i) const noexcept {
+        assert(i < N && "Cell index out of bounds");
+        return x_min_ + (static_cast<value_type>(i) + value_type{0.5}) * dx_;
+    }
+
+    /// @brief Returns the left edge position for cell index i
+    [[nodiscard]] value_type cell_left(size_type i) const noexcept {
+        assert(i < N && "Cell index out of bounds");
+        return x_min_ + static_cast<value_type>(i) * dx_;
+    }
+
+    /// @brief Returns the right edge position for cell index i
+    [[nodiscard]] value_type cell_right(size_type i) const noexcept {
+        assert(i < N && "Cell index out of bounds");
+        return x_min_ + static_cast<value_type>(i + 1) * dx_;
+    }
+
+    /// @brief Returns the cell index containing position x (wrapped first if periodic)
+    [[nodiscard]] size_type cell_index(value_type x) const noexcept {
+        return cell_of_wrapped(wrap_position(x));
+    }
+
+    /// @brief Returns (left_weight, right_weight) of cell_index(x) and the next cell
+    [[nodiscard]] std::pair<value_type, value_type>
+    interpolation_weights(value_type x) const noexcept {
+        const value_type wrapped = wrap_position(x);
+        const value_type right = (wrapped - cell_left(cell_of_wrapped(wrapped))) * inv_dx_;
+        return {value_type{1} - right, right};
+    }
+
+    /// @brief Batch cell_index: idx[i] = cell_index(x[i]), in Grid's cloned SIMD loop
+    template <std::floating_point U>
+    void cell_indices(std::span<const U> x, std::span<std::uint32_t> idx) const noexcept {
+        runtime_.cell_indices(x, idx);
+    }
+
+    /// @brief Batch interpolation_weights, in Grid's cloned SIMD loop
+    template <std::floating_point U>
+    void interpolation_weights(std::span<const U> x, std::span<std::uint32_t> idx,
+                               std::span<value_type> right) const noexcept {
+        runtime_.interpolation_weights(x, idx, right);
+    }
+
+    // =========================================================================
+    // Boundary Handling
+    // =========================================================================
+
+    /// @brief Wraps position x into [x_min, x_max) (periodic), else returns x
+    [[nodiscard]] value_type wrap_position(value_type x) const noexcept {
+        if constexpr (BC == BoundaryCondition::Periodic) {
+            value_type rel;
+            return wrap_once(x, rel) ? x_min_ + rel : wrap_far(x);
+        } else {
+            return x;
+        }
+    }
+
+    /// @brief Batch wrap_position, in place, in Grid's cloned SIMD loop
+    void wrap_positions(std::span<value_type> x) const noexcept {
+        runtime_.wrap_positions(x);
+    }
+
+    /// @brief Wraps index i into [0, N) (periodic), else clamps it
+    [[nodiscard]] static constexpr size_type wrap_index(std::ptrdiff_t i) noexcept {
+        if constexpr (BC == BoundaryCondition::Periodic) {
+            if constexpr (power_of_two) {
+                // Two's complement: the mask also wraps negative i
+                return static_cast<size_type>(i) & (N - 1);
+            } else {
+                constexpr auto n = static_cast<std::ptrdiff_t>(N);
+                i %= n;
+                return static_cast<size_type>(i < 0 ? i + n : i);
+            }
+        } else {
+            return static_cast<size_type>(
+                std::min(std::max(i, std::ptrdiff_t{0}), static_cast<std::ptrdiff_t>(N - 1)));
+        }
+    }
+
+    /// @brief Checks if position x is inside the domain
+    [[nodiscard]] bool contains(value_type x) const noexcept {
+        return x >= x_min_ && x < x_max_;
+    }
+
+    /// @brief Returns a vector of all cell-center positions
+    [[nodiscard]] std::vector<value_type> cell_centers() const {
+        std::vector<value_type> centers(N);
+        for (size_type i = 0; i < N; ++i) {
+            centers[i] = cell_center(i);
+        }
+        return centers;
+    }
+
+private:
+    /// @brief Sets rel to x - x_min wrapped by at most one period
+    /// @return False if one period was not enough (wrap_far must wrap x)
+    [[nodiscard]] bool wrap_once(value_type x, value_type& rel) const noexcept {
+        rel = x - x_min_;
+        rel -= rel >= length_ ? length_ : value_type{0};
+        rel += rel < value_type{0} ? length_ : value_type{0};
+        // Bitwise, not short-circuit: the inlined test stays free of branches
+        return (rel >= value_type{0}) & (rel < length_);
+    }
+
+    /// @brief Periodic wrap of a point any number of periods out, as BasicGrid does it
+    [[nodiscard]] value_type wrap_far(value_type x) const noexcept {
+        value_type rel = std::fmod(x - x_min_, length_);
+        if (rel < value_type{0}) {
+            rel += length_;
+        }
+        return x_min_ + rel;
+    }
+
+    /// @brief Clamped cell of a position that is already wrapped
+    [[nodiscard]] size_type cell_of_wrapped(value_type wrapped) const noexcept {
+        return static_cast<size_type>(std::min(std::max((wrapped - x_min_) * inv_dx_, value_type{0}),
+                                               static_cast<value_type>(N - 1)));
+    }
+
+    value_type x_min_;       ///< Left boundary
+    value_type x_max_;       ///< Right boundary
+    value_type length_;      ///< Domain length
+    value_type dx_;          ///< Cell width
+    value_type inv_dx_;      ///< 1/dx
+    BasicGrid<T> runtime_;   ///< Same grid at runtime, for the batch calls
+};
+
+/// @brief Double-precision static grid (the default)
+template <std::size_t N, BoundaryCondition BC = BoundaryCondition::Periodic>
+using StaticGrid = BasicStaticGrid<double, N, BC>;
+
+/// @brief Single-precision static grid
+template <std::size_t N, BoundaryCondition BC = BoundaryCondition::Periodic>
+using StaticGridF = BasicStaticGrid<float, N, BC>;
+
+static_assert(UniformGrid<Grid>);
+static_assert(UniformGrid<StaticGrid<64>>);
+
+// =============================================================================
+// Runtime to Static Dispatch
+// =============================================================================
+
+/// @brief Calls fn with a static grid if grid has one of the cell counts Ns
+/// @tparam Ns Cell counts to compile fn for (periodic)
+/// @param grid Runtime grid, e.g. from a configuration file
+/// @param fn Callable taking `const auto&`; its result is returned
+///
+/// Falls back to fn(grid) for any other cell count, so every
+/// configuration runs. fn must return the same type for every grid type.
+template <std::size_t N, std::size_t... Ns, std::floating_point T, typename Fn>
+decltype(auto) visit_grid(const BasicGrid<T>& grid, Fn&& fn) {
+    if (grid.n_cells() == N && grid.boundary_condition() == BoundaryCondition::Periodic) {
+        return fn(BasicStaticGrid<T, N>(grid));
+    }
+    if constexpr (sizeof...(Ns) == 0) {
+        return fn(grid);
+    } else {
+        return visit_grid<Ns...>(grid, std::forward<Fn>(fn));
+    }
+}
+
+} // namespace vps::grid
+
+#endif // VPS_GRID_STATIC_GRID_H
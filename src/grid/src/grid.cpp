@@ -1,22 +1,111 @@
 #include "vps/grid/grid.h"
 
+#include <vps/memory/isa.h>
+
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
+#include <utility>
 
 namespace vps::grid {
 
+namespace {
+
+/// @brief Cell written for points the periodic fast path leaves to the scalar path
+constexpr std::uint32_t unplaced = 0xffffffffu;
+
+/// @brief Grid constants the batch loops need, passed by value
+///
+/// A copy in the loop's frame cannot alias the output spans, so the
+/// compiler keeps it in registers.
+template <std::floating_point A>
+struct Constants {
+    A lo;       ///< x_min
+    A length;   ///< Domain length L
+    A dx;       ///< Cell width
+    A inv_dx;   ///< 1 / dx, as cached by the Grid
+    A last;     ///< n_cells - 1
+
+    /// @brief Sets rel to x - lo wrapped by at most one period
+    /// @return False if one period was not enough (the scalar path must wrap x)
+    [[nodiscard]] bool wrap_once(A x, A& rel) const noexcept {
+        rel = x - lo;
+        rel -= rel >= length ? length : A{0};
+        rel += rel < A{0} ? length : A{0};
+        // Bitwise, not short-circuit: keeps the loops free of branches
+        return (rel >= A{0}) & (rel < length);
+    }
+
+    /// @brief Clamped cell of a position relative to lo
+    ///
+    /// Clamped before the conversion, so far-out points of a non-periodic
+    /// grid cannot overflow it.
+    [[nodiscard]] std::int32_t cell(A rel) const noexcept {
+        return static_cast<std::int32_t>(std::min(std::max(rel * inv_dx, A{0}), last));
+    }
+};
+
+/// @brief Periodic wrap of n points by one period (fast path)
+/// @return Number of points still outside, left for wrap_position
+template <std::floating_point A>
+VPS_TARGET_CLONES std::size_t wrap_block(Constants<A> c, A* x, std::size_t n) noexcept {
+    std::size_t missed = 0;
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd reduction(+ : missed)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        A rel;
+        const bool hit = c.wrap_once(x[i], rel);
+        missed += static_cast<std::size_t>(!hit);
+        x[i] = hit ? c.lo + rel : x[i];
+    }
+    return missed;
+}
+
+/// @brief Cells of n points, and with Weights their right CIC weights
+/// @return Number of periodic points left as `unplaced`
+template <bool Periodic, bool Weights, std::floating_point A, std::floating_point U>
+VPS_TARGET_CLONES std::size_t locate_block(Constants<A> c, const U* x, std::size_t n,
+                                           std::uint32_t* cell, A* right) noexcept {
+    std::size_t missed = 0;
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd reduction(+ : missed)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        A rel = static_cast<A>(x[i]) - c.lo;
+        bool hit = true;
+        if constexpr (Periodic) {
+            hit = c.wrap_once(static_cast<A>(x[i]), rel);
+            missed += static_cast<std::size_t>(!hit);
+        }
+        // wrap_position returns lo + rel; the cell is taken relative to that
+        const A wrapped = c.lo + rel;
+        const A inner = wrapped - c.lo;
+        const std::int32_t k = c.cell(inner);
+        cell[i] = hit ? static_cast<std::uint32_t>(k) : unplaced;
+        if constexpr (Weights) {
+            right[i] = (wrapped - (c.lo + static_cast<A>(k) * c.dx)) * c.inv_dx;
+        }
+    }
+    return missed;
+}
+
+} // namespace
+
 // =============================================================================
 // Grid Implementation
 // =============================================================================
 
-Grid::Grid(size_type n_cells, value_type x_min, value_type x_max, BoundaryCondition bc)
+template <std::floating_point T>
+BasicGrid<T>::BasicGrid(size_type n_cells, value_type x_min, value_type x_max,
+                        BoundaryCondition bc)
     : n_cells_(n_cells)
     , x_min_(x_min)
     , x_max_(x_max)
     , length_(x_max - x_min)
     , dx_(length_ / static_cast<value_type>(n_cells))
-    , inv_dx_(1.0 / dx_)
+    , inv_dx_(value_type{1} / dx_)
     , bc_(bc)
 {
     if (n_cells == 0) {
@@ -27,80 +116,92 @@ Grid::Grid(size_type n_cells, value_type x_min, value_type x_max, BoundaryCondit
     }
 }
 
-Grid::size_type Grid::n_cells() const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::size_type BasicGrid<T>::n_cells() const noexcept {
     return n_cells_;
 }
 
-Grid::value_type Grid::x_min() const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::x_min() const noexcept {
     return x_min_;
 }
 
-Grid::value_type Grid::x_max() const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::x_max() const noexcept {
     return x_max_;
 }
 
-Grid::value_type Grid::length() const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::length() const noexcept {
     return length_;
 }
 
-Grid::value_type Grid::dx() const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::dx() const noexcept {
     return dx_;
 }
 
-BoundaryCondition Grid::boundary_condition() const noexcept {
+template <std::floating_point T>
+BoundaryCondition BasicGrid<T>::boundary_condition() const noexcept {
     return bc_;
 }
 
-Grid::value_type Grid::cell_center(size_type i) const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::cell_center(size_type i) const noexcept {
     assert(i < n_cells_ && "Cell index out of bounds");
-    return x_min_ + (static_cast<value_type>(i) + 0.5) * dx_;
+    return x_min_ + (static_cast<value_type>(i) + value_type{0.5}) * dx_;
 }
 
-Grid::value_type Grid::cell_left(size_type i) const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::cell_left(size_type i) const noexcept {
     assert(i < n_cells_ && "Cell index out of bounds");
     return x_min_ + static_cast<value_type>(i) * dx_;
 }
 
-Grid::value_type Grid::cell_right(size_type i) const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::cell_right(size_type i) const noexcept {
     assert(i < n_cells_ && "Cell index out of bounds");
     return x_min_ + static_cast<value_type>(i + 1) * dx_;
 }
 
-Grid::size_type Grid::cell_index(value_type x) const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::size_type BasicGrid<T>::cell_index(value_type x) const noexcept {
     // Wrap position first for periodic BC
-    value_type x_wrapped = wrap_position(x);
-    
-    // Compute index
-    auto idx = static_cast<std::ptrdiff_t>((x_wrapped - x_min_) * inv_dx_);
-    
+    return cell_of_wrapped(wrap_position(x));
+}
+
+template <std::floating_point T>
+typename BasicGrid<T>::size_type
+BasicGrid<T>::cell_of_wrapped(value_type x_wrapped) const noexcept {
     // Clamp to valid range (handles edge cases due to floating point)
-    if (idx < 0) idx = 0;
-    if (static_cast<size_type>(idx) >= n_cells_) idx = static_cast<std::ptrdiff_t>(n_cells_ - 1);
-    
+    const value_type idx = std::min(std::max((x_wrapped - x_min_) * inv_dx_, value_type{0}),
+                                    static_cast<value_type>(n_cells_ - 1));
     return static_cast<size_type>(idx);
 }
 
-std::pair<Grid::value_type, Grid::value_type> 
-Grid::interpolation_weights(value_type x) const noexcept {
+template <std::floating_point T>
+std::pair<typename BasicGrid<T>::value_type, typename BasicGrid<T>::value_type>
+BasicGrid<T>::interpolation_weights(value_type x) const noexcept {
     value_type x_wrapped = wrap_position(x);
     
-    // Position relative to left edge of containing cell
-    size_type idx = cell_index(x_wrapped);
+    // Position relative to left edge of containing cell (wrapped only once)
+    size_type idx = cell_of_wrapped(x_wrapped);
     value_type x_left = cell_left(idx);
     
     // Weight is distance from left edge, normalized by dx
     value_type right_weight = (x_wrapped - x_left) * inv_dx_;
-    value_type left_weight = 1.0 - right_weight;
+    value_type left_weight = value_type{1} - right_weight;
     
     return {left_weight, right_weight};
 }
 
-Grid::value_type Grid::wrap_position(value_type x) const noexcept {
+template <std::floating_point T>
+typename BasicGrid<T>::value_type BasicGrid<T>::wrap_position(value_type x) const noexcept {
     if (bc_ == BoundaryCondition::Periodic) {
         // Use fmod for wrapping
         value_type x_rel = x - x_min_;
         x_rel = std::fmod(x_rel, length_);
-        if (x_rel < 0.0) {
+        if (x_rel < value_type{0}) {
             x_rel += length_;
         }
         return x_min_ + x_rel;
@@ -109,7 +210,71 @@ Grid::value_type Grid::wrap_position(value_type x) const noexcept {
     return x;
 }
 
-Grid::size_type Grid::wrap_index(std::ptrdiff_t i) const noexcept {
+template <std::floating_point T>
+template <std::floating_point U>
+void BasicGrid<T>::cell_indices(std::span<const U> x,
+                                std::span<std::uint32_t> idx) const noexcept {
+    assert(idx.size() == x.size() && "Output span must match the positions");
+    const Constants<T> c{x_min_, length_, dx_, inv_dx_, static_cast<T>(n_cells_ - 1)};
+    T* const no_weights = nullptr;
+    if (bc_ != BoundaryCondition::Periodic) {
+        locate_block<false, false>(c, x.data(), x.size(), idx.data(), no_weights);
+        return;
+    }
+    if (locate_block<true, false>(c, x.data(), x.size(), idx.data(), no_weights) == 0) {
+        return;
+    }
+    for (size_type i = 0; i < x.size(); ++i) {
+        if (idx[i] == unplaced) {
+            idx[i] = static_cast<std::uint32_t>(cell_index(static_cast<T>(x[i])));
+        }
+    }
+}
+
+template <std::floating_point T>
+template <std::floating_point U>
+void BasicGrid<T>::interpolation_weights(std::span<const U> x, std::span<std::uint32_t> idx,
+                                         std::span<value_type> right) const noexcept {
+    assert(idx.size() == x.size() && right.size() == x.size() &&
+           "Output spans must match the positions");
+    const Constants<T> c{x_min_, length_, dx_, inv_dx_, static_cast<T>(n_cells_ - 1)};
+    if (bc_ != BoundaryCondition::Periodic) {
+        locate_block<false, true>(c, x.data(), x.size(), idx.data(), right.data());
+        return;
+    }
+    if (locate_block<true, true>(c, x.data(), x.size(), idx.data(), right.data()) == 0) {
+        return;
+    }
+    for (size_type i = 0; i < x.size(); ++i) {
+        if (idx[i] == unplaced) {
+            const auto xi = static_cast<T>(x[i]);
+            idx[i] = static_cast<std::uint32_t>(cell_index(xi));
+            right[i] = interpolation_weights(xi).second;
+        }
+    }
+}
+
+template <std::floating_point T>
+void BasicGrid<T>::wrap_positions(std::span<value_type> x) const noexcept {
+    if (bc_ != BoundaryCondition::Periodic) {
+        return;
+    }
+    const Constants<T> c{x_min_, length_, dx_, inv_dx_, static_cast<T>(n_cells_ - 1)};
+    if (wrap_block(c, x.data(), x.size()) == 0) {
+        return;
+    }
+    // Misses were left as they were, so the same test finds them again;
+    // a wrapped hit always passes it
+    for (auto& xi : x) {
+        T rel;
+        if (!c.wrap_once(xi, rel)) {
+            xi = wrap_position(xi);
+        }
+    }
+}
+
+template <std::floating_point T>
+typename BasicGrid<T>::size_type BasicGrid<T>::wrap_index(std::ptrdiff_t i) const noexcept {
     if (bc_ == BoundaryCondition::Periodic) {
         std::ptrdiff_t n = static_cast<std::ptrdiff_t>(n_cells_);
         i = i % n;
@@ -124,11 +289,13 @@ Grid::size_type Grid::wrap_index(std::ptrdiff_t i) const noexcept {
     return static_cast<size_type>(i);
 }
 
-bool Grid::contains(value_type x) const noexcept {
+template <std::floating_point T>
+bool BasicGrid<T>::contains(value_type x) const noexcept {
     return x >= x_min_ && x < x_max_;
 }
 
-std::vector<Grid::value_type> Grid::cell_centers() const {
+template <std::floating_point T>
+std::vector<typename BasicGrid<T>::value_type> BasicGrid<T>::cell_centers() const {
     std::vector<value_type> centers(n_cells_);
     for (size_type i = 0; i < n_cells_; ++i) {
         centers[i] = cell_center(i);
@@ -140,54 +307,114 @@ std::vector<Grid::value_type> Grid::cell_centers() const {
 // Field Implementation
 // =============================================================================
 
-Field::Field(const Grid& grid, value_type initial_value)
+template <std::floating_point T>
+BasicField<T>::BasicField(const grid_type& grid, value_type initial_value)
+    : BasicField(grid, initial_value, memory::AllocationPolicy{})
+{}
+
+template <std::floating_point T>
+BasicField<T>::BasicField(const grid_type& grid, value_type initial_value,
+                          memory::AllocationPolicy policy)
     : grid_(&grid)
-    , data_(grid.n_cells(), initial_value)
+    , storage_(grid.n_cells() * sizeof(value_type), policy)
+    , size_(grid.n_cells())
+{
+    fill(initial_value);
+}
+
+template <std::floating_point T>
+BasicField<T>::BasicField(const BasicField& other)
+    : grid_(other.grid_)
+    , storage_(other.size_ * sizeof(value_type), other.storage_.policy())
+    , size_(other.size_)
+{
+    std::copy_n(other.data(), size_, data());
+}
+
+template <std::floating_point T>
+BasicField<T>::BasicField(BasicField&& other) noexcept
+    : grid_(other.grid_)
+    , storage_(std::move(other.storage_))
+    , size_(std::exchange(other.size_, 0))
 {}
 
-Field::value_type& Field::operator[](size_type i) noexcept {
-    assert(i < data_.size() && "Index out of bounds");
-    return data_[i];
+template <std::floating_point T>
+BasicField<T>& BasicField<T>::operator=(BasicField&& other) noexcept {
+    grid_ = other.grid_;
+    storage_ = std::move(other.storage_);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+template <std::floating_point T>
+BasicField<T>& BasicField<T>::operator=(const BasicField& other) {
+    if (this != &other) {
+        BasicField copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <std::floating_point T>
+typename BasicField<T>::value_type& BasicField<T>::operator[](size_type i) noexcept {
+    assert(i < size_ && "Index out of bounds");
+    return data()[i];
 }
 
-const Field::value_type& Field::operator[](size_type i) const noexcept {
-    assert(i < data_.size() && "Index out of bounds");
-    return data_[i];
+template <std::floating_point T>
+const typename BasicField<T>::value_type&
+BasicField<T>::operator[](size_type i) const noexcept {
+    assert(i < size_ && "Index out of bounds");
+    return data()[i];
 }
 
-Field::size_type Field::size() const noexcept {
-    return data_.size();
+template <std::floating_point T>
+typename BasicField<T>::size_type BasicField<T>::size() const noexcept {
+    return size_;
 }
 
-std::span<Field::value_type> Field::values() noexcept {
-    return data_;
+template <std::floating_point T>
+std::span<typename BasicField<T>::value_type> BasicField<T>::values() noexcept {
+    return {data(), size_};
 }
 
-std::span<const Field::value_type> Field::values() const noexcept {
-    return data_;
+template <std::floating_point T>
+std::span<const typename BasicField<T>::value_type> BasicField<T>::values() const noexcept {
+    return {data(), size_};
 }
 
-Field::value_type* Field::data() noexcept {
-    return data_.data();
+template <std::floating_point T>
+typename BasicField<T>::value_type* BasicField<T>::data() noexcept {
+    return static_cast<value_type*>(storage_.data());
 }
 
-const Field::value_type* Field::data() const noexcept {
-    return data_.data();
+template <std::floating_point T>
+const typename BasicField<T>::value_type* BasicField<T>::data() const noexcept {
+    return static_cast<const value_type*>(storage_.data());
 }
 
-const Grid& Field::grid() const noexcept {
+template <std::floating_point T>
+const typename BasicField<T>::grid_type& BasicField<T>::grid() const noexcept {
     return *grid_;
 }
 
-void Field::fill(value_type val) noexcept {
-    std::fill(data_.begin(), data_.end(), val);
+template <std::floating_point T>
+const memory::AllocationReport& BasicField<T>::allocation_report() const noexcept {
+    return storage_.report();
+}
+
+template <std::floating_point T>
+void BasicField<T>::fill(value_type val) noexcept {
+    std::fill_n(data(), size_, val);
 }
 
-void Field::zero() noexcept {
-    fill(0.0);
+template <std::floating_point T>
+void BasicField<T>::zero() noexcept {
+    fill(value_type{});
 }
 
-Field::value_type Field::interpolate(value_type x) const noexcept {
+template <std::floating_point T>
+typename BasicField<T>::value_type BasicField<T>::interpolate(value_type x) const noexcept {
     // Get cell index and weights
     size_type idx = grid_->cell_index(x);
     auto [w_left, w_right] = grid_->interpolation_weights(x);
@@ -196,7 +423,40 @@ Field::value_type Field::interpolate(value_type x) const noexcept {
     size_type idx_next = grid_->wrap_index(static_cast<std::ptrdiff_t>(idx) + 1);
     
     // Linear interpolation
-    return w_left * data_[idx] + w_right * data_[idx_next];
+    const value_type* values = data();
+    return w_left * values[idx] + w_right * values[idx_next];
 }
 
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template class BasicGrid<float>;
+template class BasicGrid<double>;
+
+template void BasicGrid<float>::cell_indices(std::span<const float>,
+                                             std::span<std::uint32_t>) const noexcept;
+template void BasicGrid<float>::cell_indices(std::span<const double>,
+                                             std::span<std::uint32_t>) const noexcept;
+template void BasicGrid<double>::cell_indices(std::span<const float>,
+                                              std::span<std::uint32_t>) const noexcept;
+template void BasicGrid<double>::cell_indices(std::span<const double>,
+                                              std::span<std::uint32_t>) const noexcept;
+
+template void BasicGrid<float>::interpolation_weights(std::span<const float>,
+                                                      std::span<std::uint32_t>,
+                                                      std::span<float>) const noexcept;
+template void BasicGrid<float>::interpolation_weights(std::span<const double>,
+                                                      std::span<std::uint32_t>,
+                                                      std::span<float>) const noexcept;
+template void BasicGrid<double>::interpolation_weights(std::span<const float>,
+                                                       std::span<std::uint32_t>,
+                                                       std::span<double>) const noexcept;
+template void BasicGrid<double>::interpolation_weights(std::span<const double>,
+                                                       std::span<std::uint32_t>,
+                                                       std::span<double>) const noexcept;
+
+template class BasicField<float>;
+template class BasicField<double>;
+
 } // namespace vps::grid
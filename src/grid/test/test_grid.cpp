@@ -2,7 +2,10 @@
 #include <vps/grid/grid.h>
 
 #include <cmath>
+#include <cstdint>
 #include <numbers>
+#include <span>
+#include <vector>
 
 namespace vps::grid::test {
 
@@ -208,6 +211,79 @@ TEST(GridTest, InterpolationWeights_RightEdge) {
     EXPECT_NEAR(w_right, 0.9, 1e-10);
 }
 
+// =============================================================================
+// Batch Conversion Tests
+// =============================================================================
+
+namespace {
+
+/// @brief Positions inside, one period out, many periods out and on the edges
+std::vector<double> batch_positions(const Grid& g) {
+    std::vector<double> x;
+    for (int i = 0; i < 1000; ++i) {
+        x.push_back(g.x_min() + g.length() * (static_cast<double>(i) * 0.00731 - 1.5));
+    }
+    for (const double edge : {g.x_min(), g.x_max(), g.x_min() - g.length(),
+                              g.x_max() + g.length(), g.x_min() + 7.0 * g.length(),
+                              std::nextafter(g.x_max(), 0.0), std::nextafter(g.x_min(), -1e9),
+                              -1e-300}) {
+        x.push_back(edge);
+    }
+    return x;
+}
+
+} // namespace
+
+TEST(GridBatchTest, CellIndicesMatchScalar) {
+    const Grid g(37, -1.3, 2.9);
+    const auto x = batch_positions(g);
+    std::vector<std::uint32_t> idx(x.size());
+    g.cell_indices(std::span<const double>(x), std::span(idx));
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(idx[i], g.cell_index(x[i])) << "x = " << x[i];
+    }
+}
+
+TEST(GridBatchTest, InterpolationWeightsMatchScalar) {
+    const Grid g(37, -1.3, 2.9);
+    const auto x = batch_positions(g);
+    std::vector<std::uint32_t> idx(x.size());
+    std::vector<double> right(x.size());
+    g.interpolation_weights(std::span<const double>(x), std::span(idx), std::span(right));
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(idx[i], g.cell_index(x[i])) << "x = " << x[i];
+        ASSERT_EQ(right[i], g.interpolation_weights(x[i]).second) << "x = " << x[i];
+        // Weights belong to the cell cell_index reports, so they stay in [0, 1]
+        ASSERT_GE(right[i], -1e-12);
+        ASSERT_LE(right[i], 1.0 + 1e-12);
+    }
+}
+
+TEST(GridBatchTest, WrapPositionsMatchScalar) {
+    const Grid g(37, -1.3, 2.9);
+    const auto x = batch_positions(g);
+    auto wrapped = x;
+    g.wrap_positions(std::span(wrapped));
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(wrapped[i], g.wrap_position(x[i])) << "x = " << x[i];
+    }
+}
+
+TEST(GridBatchTest, SinglePrecisionPositionsOnDoubleGrid) {
+    const Grid g(16, 0.0, 2.0);
+    std::vector<float> x;
+    for (int i = -40; i < 80; ++i) {
+        x.push_back(0.05f * static_cast<float>(i));
+    }
+    std::vector<std::uint32_t> idx(x.size());
+    std::vector<double> right(x.size());
+    g.interpolation_weights(std::span<const float>(x), std::span(idx), std::span(right));
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(idx[i], g.cell_index(static_cast<double>(x[i])));
+        ASSERT_EQ(right[i], g.interpolation_weights(static_cast<double>(x[i])).second);
+    }
+}
+
 // =============================================================================
 // Field Tests
 // =============================================================================
@@ -350,6 +426,74 @@ TEST(FieldTest, MoveConstruction) {
     Field f2(std::move(f1));
     
     EXPECT_DOUBLE_EQ(f2[5], 42.0);
+    EXPECT_EQ(f1.size(), 0);  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(FieldTest, CopyAssignment) {
+    Grid g(10, 0.0, 10.0);
+    Field f1(g, 1.0);
+    Field f2(g, 2.0);
+
+    f2 = f1;
+    f1[0] = 5.0;
+
+    EXPECT_DOUBLE_EQ(f2[0], 1.0);
+    EXPECT_NE(f2.data(), f1.data());
+}
+
+// =============================================================================
+// Storage Tests
+// =============================================================================
+
+TEST(FieldTest, ValuesAreAligned) {
+    Grid g(13, 0.0, 1.0);
+    Field f(g);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(f.data()) % memory::default_alignment, 0);
+    EXPECT_EQ(f.allocation_report().backing, memory::Backing::Heap);
+}
+
+TEST(FieldTest, HugePagePolicy) {
+    Grid g(1000, 0.0, 1.0);
+    Field f(g, 3.0, memory::AllocationPolicy::huge());
+
+    EXPECT_NE(f.allocation_report().backing, memory::Backing::Heap);
+    EXPECT_DOUBLE_EQ(f[999], 3.0);
+
+    // Copies keep the policy
+    Field copy(f);
+    EXPECT_EQ(copy.allocation_report().backing, f.allocation_report().backing);
+    EXPECT_DOUBLE_EQ(copy[0], 3.0);
+}
+
+// =============================================================================
+// Single-Precision Tests
+// =============================================================================
+
+TEST(GridFTest, Construction) {
+    GridF g(8, 0.0f, 2.0f);
+
+    EXPECT_EQ(g.n_cells(), 8);
+    EXPECT_FLOAT_EQ(g.dx(), 0.25f);
+    EXPECT_FLOAT_EQ(g.cell_center(0), 0.125f);
+}
+
+TEST(GridFTest, WrapAndIndex) {
+    GridF g(4, 0.0f, 4.0f);
+
+    EXPECT_FLOAT_EQ(g.wrap_position(5.5f), 1.5f);
+    EXPECT_FLOAT_EQ(g.wrap_position(-0.5f), 3.5f);
+    EXPECT_EQ(g.cell_index(-0.5f), 3);
+}
+
+TEST(FieldFTest, InterpolateLinear) {
+    GridF g(4, 0.0f, 4.0f);
+    FieldF field(g);
+    for (std::size_t i = 0; i < field.size(); ++i) {
+        field[i] = static_cast<float>(i);
+    }
+
+    EXPECT_FLOAT_EQ(field.interpolate(1.5f), 1.5f);
+    EXPECT_EQ(&field.grid(), &g);
 }
 
 } // namespace vps::grid::test
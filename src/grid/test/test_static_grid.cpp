@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <vps/grid/static_grid.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vps::grid::test {
+
+// =============================================================================
+// Static Grid Construction Tests
+// =============================================================================
+
+TEST(StaticGridTest, MatchesRuntimeGeometry) {
+    const StaticGrid<10> s(-1.0, 4.0);
+    const Grid g(10, -1.0, 4.0);
+
+    static_assert(StaticGrid<10>::n_cells() == 10);
+    EXPECT_EQ(s.dx(), g.dx());
+    EXPECT_EQ(s.length(), g.length());
+    for (std::size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(s.cell_center(i), g.cell_center(i));
+        EXPECT_EQ(s.cell_left(i), g.cell_left(i));
+    }
+    EXPECT_EQ(s.cell_centers(), g.cell_centers());
+}
+
+TEST(StaticGridTest, ConvertsToAndFromRuntimeGrid) {
+    const Grid g(64, 0.0, 2.0);
+    const StaticGrid<64> s(g);
+    EXPECT_EQ(s.x_min(), g.x_min());
+    EXPECT_EQ(s.x_max(), g.x_max());
+
+    const Grid back = s.to_grid();
+    EXPECT_EQ(back.n_cells(), 64u);
+    EXPECT_EQ(back.dx(), g.dx());
+
+    EXPECT_THROW(StaticGrid<32>{g}, std::invalid_argument);
+    EXPECT_THROW((StaticGrid<8>(1.0, 1.0)), std::invalid_argument);
+}
+
+// =============================================================================
+// Wrapping Tests
+// =============================================================================
+
+TEST(StaticGridTest, WrapIndexMatchesRuntime) {
+    const Grid g8(8, 0.0, 1.0);
+    const Grid g10(10, 0.0, 1.0);
+    static_assert(StaticGrid<8>::power_of_two && !StaticGrid<10>::power_of_two);
+    for (std::ptrdiff_t i = -35; i < 35; ++i) {
+        EXPECT_EQ(StaticGrid<8>::wrap_index(i), g8.wrap_index(i)) << i;
+        EXPECT_EQ(StaticGrid<10>::wrap_index(i), g10.wrap_index(i)) << i;
+    }
+}
+
+TEST(StaticGridTest, CellIndexMatchesRuntimeAtEdges) {
+    const StaticGrid<16> s16(-2.0, 2.0);
+    const StaticGrid<12> s12(-2.0, 2.0);
+    const Grid g16(16, -2.0, 2.0);
+    const Grid g12(12, -2.0, 2.0);
+    // Cell edges, and the doubles either side of them, over several periods
+    for (int k = -60; k < 60; ++k) {
+        const double e16 = -2.0 + static_cast<double>(k) * s16.dx();
+        const double e12 = -2.0 + static_cast<double>(k) * s12.dx();
+        for (const double dir : {-1e9, 1e9}) {
+            EXPECT_EQ(s16.cell_index(e16), g16.cell_index(e16)) << e16;
+            EXPECT_EQ(s12.cell_index(e12), g12.cell_index(e12)) << e12;
+            const double n16 = std::nextafter(e16, dir);
+            const double n12 = std::nextafter(e12, dir);
+            EXPECT_EQ(s16.cell_index(n16), g16.cell_index(n16)) << n16;
+            EXPECT_EQ(s12.cell_index(n12), g12.cell_index(n12)) << n12;
+        }
+    }
+}
+
+TEST(StaticGridTest, WrapPositionMatchesRuntime) {
+    const StaticGrid<16> s(-1.3, 2.9);
+    const Grid g(16, -1.3, 2.9);
+    for (int i = -500; i < 500; ++i) {
+        const double x = 0.0731 * static_cast<double>(i);
+        EXPECT_EQ(s.wrap_position(x), g.wrap_position(x)) << x;
+    }
+    const double edge = std::nextafter(s.x_min(), -1e9);
+    EXPECT_EQ(s.wrap_position(edge), g.wrap_position(edge));
+}
+
+// =============================================================================
+// Interpolation Tests
+// =============================================================================
+
+TEST(StaticGridTest, WeightsReferToCellIndex) {
+    const StaticGrid<32> s(0.0, 1.0);
+    for (int i = -1000; i < 1000; ++i) {
+        const double x = 0.00437 * static_cast<double>(i);
+        const auto c = s.cell_index(x);
+        const auto [left, right] = s.interpolation_weights(x);
+        EXPECT_DOUBLE_EQ(left + right, 1.0);
+        EXPECT_GE(right, 0.0);
+        EXPECT_LE(right, 1.0);
+        EXPECT_NEAR(s.cell_left(c) + right * s.dx(), s.wrap_position(x), 1e-12) << x;
+    }
+}
+
+/// @brief Checks every conversion of s against the same call on its runtime grid
+///
+/// Cells, wraps and batch results must match exactly; a scalar weight may
+/// differ by the rounding of cell_left when one side contracts it to an FMA.
+template <typename S>
+void expect_matches_runtime(const S& s, const std::vector<double>& x) {
+    const auto g = s.to_grid();
+    const double tol = 4.0 * std::numeric_limits<double>::epsilon() *
+                       (1.0 + std::abs(s.x_min()) + std::abs(s.x_max())) / s.dx();
+    std::vector<std::uint32_t> idx(x.size()), idx_g(x.size()), cells(x.size()), cells_g(x.size());
+    std::vector<double> right(x.size()), right_g(x.size());
+    s.cell_indices(std::span<const double>(x), std::span(idx));
+    g.cell_indices(std::span<const double>(x), std::span(idx_g));
+    s.interpolation_weights(std::span<const double>(x), std::span(cells), std::span(right));
+    g.interpolation_weights(std::span<const double>(x), std::span(cells_g), std::span(right_g));
+    auto wrapped = x;
+    auto wrapped_g = x;
+    s.wrap_positions(std::span(wrapped));
+    g.wrap_positions(std::span(wrapped_g));
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(s.cell_index(x[i]), g.cell_index(x[i])) << x[i];
+        ASSERT_NEAR(s.interpolation_weights(x[i]).second, g.interpolation_weights(x[i]).second,
+                    tol)
+            << x[i];
+        ASSERT_EQ(s.wrap_position(x[i]), g.wrap_position(x[i])) << x[i];
+        ASSERT_EQ(idx[i], idx_g[i]) << x[i];
+        ASSERT_EQ(cells[i], cells_g[i]) << x[i];
+        ASSERT_EQ(right[i], right_g[i]) << x[i];
+        ASSERT_EQ(wrapped[i], wrapped_g[i]) << x[i];
+        ASSERT_EQ(idx[i], s.cell_index(x[i]));
+    }
+}
+
+TEST(StaticGridTest, MatchesRuntimeGrid) {
+    // Points over several periods, plus every cell edge and its neighbours
+    std::vector<double> x;
+    for (int i = -3000; i < 3000; ++i) {
+        x.push_back(0.00123 * static_cast<double>(i));
+    }
+    const auto add_edges = [&](auto s) {
+        std::vector<double> points = x;
+        for (std::size_t c = 0; c < s.n_cells(); ++c) {
+            const double edge = s.cell_left(c);
+            points.push_back(std::nextafter(edge, -1e9));
+            points.push_back(edge);
+            points.push_back(std::nextafter(edge, 1e9));
+        }
+        points.push_back(std::nextafter(s.x_max(), -1e9));
+        points.push_back(s.x_max());
+        return points;
+    };
+
+    const StaticGrid<24> s24(-1.0, 1.0);
+    const StaticGrid<32> s32(0.1, 0.7);
+    const StaticGrid<20> s20(-0.4, 1.9);
+    expect_matches_runtime(s24, add_edges(s24));
+    expect_matches_runtime(s32, add_edges(s32));
+    expect_matches_runtime(s20, add_edges(s20));
+}
+
+// =============================================================================
+// Dispatch Tests
+// =============================================================================
+
+TEST(StaticGridTest, VisitGridPicksCompiledSize) {
+    const auto kind = [](const auto& g) -> std::size_t {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(g)>, Grid>) {
+            return 0;
+        } else {
+            return g.n_cells();
+        }
+    };
+    EXPECT_EQ((visit_grid<64, 128>(Grid(128, 0.0, 1.0), kind)), 128u);
+    EXPECT_EQ((visit_grid<64, 128>(Grid(64, 0.0, 1.0), kind)), 64u);
+    EXPECT_EQ((visit_grid<64, 128>(Grid(100, 0.0, 1.0), kind)), 0u);
+}
+
+TEST(StaticGridFTest, SinglePrecision) {
+    const StaticGridF<4> s(0.0f, 4.0f);
+    EXPECT_FLOAT_EQ(s.wrap_position(5.5f), 1.5f);
+    EXPECT_FLOAT_EQ(s.wrap_position(-0.5f), 3.5f);
+    EXPECT_EQ(s.cell_index(-0.5f), 3u);
+}
+
+} // namespace vps::grid::test
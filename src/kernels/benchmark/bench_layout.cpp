@@ -0,0 +1,106 @@
+/// @file bench_layout.cpp
+/// @brief SoA vs tiled (AoSoA) particle layout on push and deposit kernels
+///
+/// Sizes span 10^6 to 10^8 points (~2.4 GB per container at the top end);
+/// the TLB advantage of tiles only shows once the working set spans far
+/// more pages than the TLB covers. Compare one kernel across layouts with
+/// e.g. --benchmark_filter='DepositCic'.
+
+#include <vps/grid/grid.h>
+#include <vps/kernels/deposit.h>
+#include <vps/particles/aosoa.h>
+#include <vps/particles/particles.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+constexpr double dt = 0.1;
+constexpr std::size_t n_cells = 1024;
+
+void point_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(1'000'000, 100'000'000)->UseRealTime();
+}
+
+/// Points spread over the whole domain, so deposits touch every cell
+vps::particles::Particles make_particles(std::size_t n) {
+    vps::particles::Particles p(n, 0.0, 1.0, 1.0);
+    auto x = p.x();
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<double>((i * 2654435761u) % n) / static_cast<double>(n);
+    }
+    return p;
+}
+
+void report_points(benchmark::State& state, std::size_t n) {
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(n));
+}
+
+using SoA = vps::particles::Particles;
+template <std::size_t W>
+using Tiled = vps::particles::TiledParticles<double, W>;
+
+// =============================================================================
+// Free streaming
+// =============================================================================
+
+template <typename Layout>
+void BM_AdvancePositions(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    Layout p(make_particles(n));
+
+    for (auto _ : state) {
+        vps::particles::advance_positions(p, dt);
+        benchmark::ClobberMemory();
+    }
+    report_points(state, n);
+}
+BENCHMARK(BM_AdvancePositions<SoA>)->Apply(point_sizes);
+BENCHMARK(BM_AdvancePositions<Tiled<8>>)->Apply(point_sizes);
+BENCHMARK(BM_AdvancePositions<Tiled<16>>)->Apply(point_sizes);
+
+// =============================================================================
+// Deposition
+// =============================================================================
+
+template <typename Layout>
+void BM_DepositNgp(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Layout p(make_particles(n));
+    vps::grid::Grid g(n_cells, 0.0, 1.0);
+    vps::grid::Field rho(g);
+
+    for (auto _ : state) {
+        rho.zero();
+        vps::kernels::deposit_ngp(p, rho);
+        benchmark::DoNotOptimize(rho.data());
+    }
+    report_points(state, n);
+}
+BENCHMARK(BM_DepositNgp<SoA>)->Apply(point_sizes);
+BENCHMARK(BM_DepositNgp<Tiled<8>>)->Apply(point_sizes);
+BENCHMARK(BM_DepositNgp<Tiled<16>>)->Apply(point_sizes);
+
+template <typename Layout>
+void BM_DepositCic(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const Layout p(make_particles(n));
+    vps::grid::Grid g(n_cells, 0.0, 1.0);
+    vps::grid::Field rho(g);
+
+    for (auto _ : state) {
+        rho.zero();
+        vps::kernels::deposit_cic(p, rho);
+        benchmark::DoNotOptimize(rho.data());
+    }
+    report_points(state, n);
+}
+BENCHMARK(BM_DepositCic<SoA>)->Apply(point_sizes);
+BENCHMARK(BM_DepositCic<Tiled<8>>)->Apply(point_sizes);
+BENCHMARK(BM_DepositCic<Tiled<16>>)->Apply(point_sizes);
+
+} // namespace
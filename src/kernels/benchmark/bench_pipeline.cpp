@@ -0,0 +1,106 @@
+/// @file bench_pipeline.cpp
+/// @brief Fused chunked pipeline vs one pass per kernel
+///
+/// Both variants run one free-streaming step: push, periodic wrap and NGP
+/// (or CIC) deposit. The separate-pass variant is what main.cpp did before
+/// the pipeline: three sweeps over the arrays, each a DRAM round trip once
+/// N outgrows the last-level cache. Sizes span 10^5 (cache-resident) to
+/// 10^8 points.
+
+#include <vps/grid/grid.h>
+#include <vps/kernels/deposit.h>
+#include <vps/kernels/pipeline.h>
+#include <vps/particles/particles.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+constexpr double dt = 0.01;
+constexpr std::size_t n_cells = 1024;
+
+void point_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+}
+
+vps::particles::Particles make_particles(std::size_t n) {
+    vps::particles::Particles p;
+    p.fill_with(n, [n](std::size_t i) {
+        const double s = static_cast<double>(i) / static_cast<double>(n);
+        return std::array{s, 0.5 - s, 1.0};
+    });
+    return p;
+}
+
+void report_points(benchmark::State& state, std::size_t n) {
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(n));
+}
+
+// =============================================================================
+// Separate passes
+// =============================================================================
+
+template <bool Cic>
+void BM_SeparatePasses(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const vps::grid::Grid grid(n_cells, 0.0, 1.0);
+    vps::grid::Field rho(grid);
+    auto p = make_particles(n);
+
+    for (auto _ : state) {
+        rho.zero();
+        vps::particles::advance_positions(p, dt);
+        auto x = p.x();
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = grid.wrap_position(x[i]);
+        }
+        if constexpr (Cic) {
+            vps::kernels::deposit_cic(p, rho);
+        } else {
+            vps::kernels::deposit_ngp(p, rho);
+        }
+        benchmark::ClobberMemory();
+    }
+    report_points(state, n);
+}
+BENCHMARK(BM_SeparatePasses<false>)->Apply(point_sizes);
+BENCHMARK(BM_SeparatePasses<true>)->Apply(point_sizes);
+
+// =============================================================================
+// Fused pipeline
+// =============================================================================
+
+template <bool Cic>
+void BM_Pipeline(benchmark::State& state) {
+    namespace stage = vps::kernels::stage;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const vps::grid::Grid grid(n_cells, 0.0, 1.0);
+    vps::grid::Field rho(grid);
+    auto p = make_particles(n);
+
+    auto step = [&] {
+        if constexpr (Cic) {
+            return stage::push(dt) | stage::wrap(grid) | stage::index(grid) |
+                   stage::deposit_cic(rho);
+        } else {
+            return stage::push(dt) | stage::wrap(grid) | stage::index(grid) |
+                   stage::deposit_ngp(rho);
+        }
+    }();
+
+    for (auto _ : state) {
+        rho.zero();
+        step.run(p);
+        benchmark::ClobberMemory();
+    }
+    report_points(state, n);
+}
+BENCHMARK(BM_Pipeline<false>)->Apply(point_sizes);
+BENCHMARK(BM_Pipeline<true>)->Apply(point_sizes);
+
+} // namespace
@@ -0,0 +1,120 @@
+/// @file bench_push.cpp
+/// @brief Fused push kernels vs their per-point equivalents
+///
+/// - stream_and_wrap vs the original time step: one vectorized push, then
+///   a second sweep calling Grid::wrap_position (an fmod) per point.
+/// - kick vs a loop over Field::interpolate, which wraps every x twice.
+///
+/// Sizes span 10^5 (cache-resident) to 10^8 points.
+
+#include <vps/grid/grid.h>
+#include <vps/kernels/push.h>
+#include <vps/particles/particles.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+constexpr double dt = 0.01;
+
+void point_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+}
+
+vps::particles::Particles make_particles(std::size_t n) {
+    vps::particles::Particles p;
+    p.fill_with(n, [n](std::size_t i) {
+        const double s = static_cast<double>(i) / static_cast<double>(n);
+        return std::array{s, 20.0 * (s - 0.5), 1.0};  // every point crosses an edge now and then
+    });
+    return p;
+}
+
+void report_bytes(benchmark::State& state, std::size_t n) {
+    // Minimum traffic: one load of x and v, one store of x per point
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(3 * n * sizeof(double)));
+}
+
+void BM_TwoPass(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const vps::grid::Grid grid(1024, 0.0, 1.0);
+    auto p = make_particles(n);
+
+    for (auto _ : state) {
+        vps::particles::advance_positions(p, dt);
+        auto x = p.x();
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = grid.wrap_position(x[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    report_bytes(state, n);
+}
+BENCHMARK(BM_TwoPass)->Apply(point_sizes);
+
+void BM_StreamAndWrap(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const vps::grid::Grid grid(1024, 0.0, 1.0);
+    auto p = make_particles(n);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vps::kernels::stream_and_wrap(p, grid, dt));
+        benchmark::ClobberMemory();
+    }
+    report_bytes(state, n);
+}
+BENCHMARK(BM_StreamAndWrap)->Apply(point_sizes);
+
+vps::grid::Field make_field(const vps::grid::Grid& grid) {
+    vps::grid::Field E(grid);
+    for (std::size_t c = 0; c < grid.n_cells(); ++c) {
+        E[c] = std::sin(6.283185307179586 * grid.cell_center(c));
+    }
+    return E;
+}
+
+void BM_InterpolateLoop(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const vps::grid::Grid grid(1024, 0.0, 1.0);
+    const auto E = make_field(grid);
+    auto p = make_particles(n);
+
+    for (auto _ : state) {
+        const auto x = p.x();
+        auto v = p.v();
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (std::size_t i = 0; i < n; ++i) {
+            v[i] += -1.0 * dt * E.interpolate(x[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    report_bytes(state, n);
+}
+BENCHMARK(BM_InterpolateLoop)->Apply(point_sizes);
+
+void BM_Kick(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const vps::grid::Grid grid(1024, 0.0, 1.0);
+    const auto E = make_field(grid);
+    auto p = make_particles(n);
+
+    for (auto _ : state) {
+        vps::kernels::kick(p, E, -1.0, dt);
+        benchmark::ClobberMemory();
+    }
+    report_bytes(state, n);  // one load of x and v, one store of v
+}
+BENCHMARK(BM_Kick)->Apply(point_sizes);
+
+} // namespace
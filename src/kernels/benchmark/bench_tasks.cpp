@@ -0,0 +1,133 @@
+/// @file bench_tasks.cpp
+/// @brief Work-stealing pool vs OpenMP on an imbalanced cell-sorted deposit
+///
+/// Points are sorted by CellIndex, and each cell's charge, momentum and
+/// energy are summed by whoever owns the cell, so the deposit needs no
+/// atomics and costs in proportion to the points in the cell. The plasma
+/// is a Gaussian bump over a uniform floor: the argument is the bump
+/// width in per mille of the domain, so small widths pile most points
+/// into a few cells and a static split of the cells leaves most threads
+/// idle. OpenMP static and dynamic schedules are compared with
+/// memory::TaskPool.
+
+#include <vps/grid/grid.h>
+#include <vps/kernels/cell_index.h>
+#include <vps/memory/task_pool.h>
+#include <vps/particles/particles.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t n_points = 4'000'000;
+constexpr std::size_t n_cells = 4096;
+
+void widths(benchmark::internal::Benchmark* b) {
+    b->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->UseRealTime();
+}
+
+/// @brief Moments of one cell
+struct CellMoments {
+    double n = 0.0;    ///< Sum of f
+    double nv = 0.0;   ///< Sum of f v
+    double nvv = 0.0;  ///< Sum of f v^2
+};
+
+/// @brief Cell-sorted points of a bump of the given width (per mille of L)
+struct Plasma {
+    vps::grid::Grid grid{n_cells, 0.0, 1.0};
+    vps::particles::Particles points;
+    vps::kernels::CellIndex index{grid};
+    std::vector<CellMoments> moments = std::vector<CellMoments>(n_cells);
+
+    explicit Plasma(std::int64_t width_permille) {
+        const double sigma = static_cast<double>(width_permille) / 1000.0;
+        points.fill_with(n_points, [sigma](std::size_t i) {
+            // 90% of the points in the bump (inverse-CDF of a logistic), 10% uniform
+            const double s = (static_cast<double>(i) + 0.5) / static_cast<double>(n_points);
+            double x = s / 0.1;
+            if (i % 10 != 0) {
+                x = 0.5 + sigma * std::log(s / (1.0 - s));
+            }
+            x -= std::floor(x);
+            return std::array{x, std::sin(1e3 * s), 1.0};
+        });
+        index.sort(points);
+    }
+
+    /// @brief Sums the points of cell c into moments[c]
+    void deposit_cell(std::size_t c) noexcept {
+        const auto offsets = index.offsets();
+        const auto v = points.v();
+        const auto f = points.f();
+        CellMoments m;
+        for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+            m.n += f[i];
+            m.nv += f[i] * v[i];
+            m.nvv += f[i] * v[i] * v[i];
+        }
+        moments[c] = m;
+    }
+};
+
+void report_points(benchmark::State& state) {
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(n_points));
+}
+
+// =============================================================================
+// OpenMP
+// =============================================================================
+
+void BM_CellDepositStatic(benchmark::State& state) {
+    Plasma plasma(state.range(0));
+    for (auto _ : state) {
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (std::size_t c = 0; c < n_cells; ++c) {
+            plasma.deposit_cell(c);
+        }
+        benchmark::ClobberMemory();
+    }
+    report_points(state);
+}
+BENCHMARK(BM_CellDepositStatic)->Apply(widths);
+
+void BM_CellDepositDynamic(benchmark::State& state) {
+    Plasma plasma(state.range(0));
+    for (auto _ : state) {
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp parallel for schedule(dynamic, 16)
+#endif
+        for (std::size_t c = 0; c < n_cells; ++c) {
+            plasma.deposit_cell(c);
+        }
+        benchmark::ClobberMemory();
+    }
+    report_points(state);
+}
+BENCHMARK(BM_CellDepositDynamic)->Apply(widths);
+
+// =============================================================================
+// Work-stealing pool
+// =============================================================================
+
+void BM_CellDepositTasks(benchmark::State& state) {
+    Plasma plasma(state.range(0));
+    auto& pool = vps::memory::task_pool();
+    for (auto _ : state) {
+        pool.parallel_for(n_cells, [&](std::size_t c) { plasma.deposit_cell(c); });
+        benchmark::ClobberMemory();
+    }
+    report_points(state);
+}
+BENCHMARK(BM_CellDepositTasks)->Apply(widths);
+
+} // namespace
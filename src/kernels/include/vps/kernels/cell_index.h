@@ -0,0 +1,131 @@
+#ifndef VPS_KERNELS_CELL_INDEX_H
+#define VPS_KERNELS_CELL_INDEX_H
+
+/// @file cell_index.h
+/// @brief Keeps particles ordered by grid cell
+///
+/// Points that drift apart turn deposits and gathers into random accesses
+/// on the field. CellIndex reorders a container so that all points of cell
+/// 0 come first, then those of cell 1, and so on, and records where each
+/// cell's run starts. Deposit and gather then walk both the particle
+/// arrays and the field sequentially.
+///
+/// Sorting is a parallel, stable counting sort on Grid::cell_index. Since
+/// points move only a few cells per step, re-sorting is incremental: points
+/// still in their cell stay in order, and only the movers are re-bucketed.
+
+#include <vps/grid/grid.h>
+#include <vps/particles/particles.h>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vps::kernels {
+
+/// @brief Cell ordering and per-cell offsets of a particle container
+/// @tparam T Precision of the particles and grid
+///
+/// @code
+/// CellIndex index(grid, 10);   // re-sort every 10th step
+/// index.sort(particles);
+/// for (int step = 0; step < n_steps; ++step) {
+///     advance_positions(particles, dt);
+///     index.step(particles);
+///     deposit_ngp(particles, rho);  // now walks rho in order
+/// }
+/// @endcode
+///
+/// offsets() describes the order established by the last sort: points in
+/// [offsets()[c], offsets()[c + 1]) were in cell c at that time. Between
+/// sorts the container is only approximately ordered; kernels stay correct
+/// because they still locate each point from its position.
+template <std::floating_point T>
+class BasicCellIndex {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using grid_type = grid::BasicGrid<T>;
+    using particles_type = particles::BasicParticles<T>;
+
+    /// @brief Fraction of movers above which an incremental re-sort falls back to a full one
+    static constexpr double max_mover_fraction = 0.25;
+
+    /// @brief Create an index for the cells of grid
+    /// @param grid Grid defining the cells (must outlive the index)
+    /// @param sort_interval Re-sort on every sort_interval-th call to step()
+    /// @throws std::invalid_argument if sort_interval is zero
+    explicit BasicCellIndex(const grid_type& grid, size_type sort_interval = 1);
+
+    // =========================================================================
+    // Sorting
+    // =========================================================================
+
+    /// @brief Fully sorts particles by cell (stable counting sort)
+    void sort(particles_type& particles);
+
+    /// @brief Incremental re-sort after the points have moved
+    /// @return true if any point changed cell (and the container was reordered)
+    ///
+    /// Requires a previous sort() of the same container. Falls back to
+    /// sort() when more than max_mover_fraction of the points moved.
+    bool resort(particles_type& particles);
+
+    /// @brief Call once per time step; re-sorts every sort_interval() calls
+    /// @return true if this call re-sorted
+    bool step(particles_type& particles);
+
+    /// @brief Returns how many step() calls there are between re-sorts
+    [[nodiscard]] size_type sort_interval() const noexcept;
+
+    /// @brief Changes the re-sort frequency (effective from the next step())
+    /// @throws std::invalid_argument if interval is zero
+    void set_sort_interval(size_type interval);
+
+    // =========================================================================
+    // Offsets
+    // =========================================================================
+
+    /// @brief Returns n_cells + 1 offsets; cell c owns [offsets[c], offsets[c + 1])
+    [[nodiscard]] std::span<const size_type> offsets() const noexcept;
+
+    /// @brief Returns the number of points in cell c at the last sort
+    [[nodiscard]] size_type count(size_type c) const noexcept;
+
+    /// @brief Returns the grid the index is defined on
+    [[nodiscard]] const grid_type& grid() const noexcept;
+
+private:
+    /// @brief Computes keys_[i] = cell of point i
+    void compute_keys(const particles_type& particles);
+
+    /// @brief Reorders every column of particles by order_ (new position -> old index)
+    ///
+    /// In place, one column at a time through a column-sized buffer from
+    /// memory::scratch(): the container keeps its storage and placement.
+    void apply_order(particles_type& particles);
+
+    const grid_type* grid_;                      ///< Grid (non-owning)
+    size_type sort_interval_;                    ///< Steps between re-sorts
+    size_type steps_ = 0;                        ///< step() calls since last re-sort
+    std::vector<size_type> offsets_;             ///< Cell start offsets (n_cells + 1)
+    std::vector<std::uint32_t> keys_;            ///< Cell of each point
+    std::vector<size_type> order_;               ///< New position -> old index
+    std::vector<size_type> counts_;              ///< Per-share or per-cell scratch counts
+    std::vector<size_type> movers_;              ///< Indices of points that changed cell
+};
+
+/// @brief Double-precision cell index (the default)
+using CellIndex = BasicCellIndex<double>;
+
+/// @brief Single-precision cell index
+using CellIndexF = BasicCellIndex<float>;
+
+extern template class BasicCellIndex<float>;
+extern template class BasicCellIndex<double>;
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_CELL_INDEX_H
@@ -0,0 +1,223 @@
+#ifndef VPS_KERNELS_DEPOSIT_H
+#define VPS_KERNELS_DEPOSIT_H
+
+/// @file deposit.h
+/// @brief Particle-to-grid deposition (charge/density scatter)
+///
+/// Deposition adds each point's weight f to the grid; it does not clear the
+/// target field first, so several populations can be accumulated into one
+/// field. The field's precision is the accumulation precision: depositing
+/// ParticlesF into a double Field accumulates in double.
+///
+/// The SoA and tiled deposits locate cells a block of memory::kernel_block
+/// points at a time with the grid's batch calls, then scatter the block in
+/// a loop compiled in deposit.cpp (cloned per ISA in VPS_PORTABLE builds).
+/// Blocks are cut into one contiguous share per thread of
+/// particles::team_size(); each share scatters into its own row of the
+/// field, in block order, and the rows are summed into rho at the end. So
+/// for a given team size the result does not depend on timing or backend.
+///
+/// The SoA deposits also take the grid as any grid::UniformGrid standing in
+/// for rho.grid(), such as the StaticGrid that grid::visit_grid made from
+/// it. The cell lookup is the grid's batch call either way.
+
+#include <vps/grid/grid.h>
+#include <vps/grid/static_grid.h>
+#include <vps/memory/arena.h>
+#include <vps/memory/isa.h>
+#include <vps/particles/dispatch.h>
+#include <vps/particles/aosoa.h>
+#include <vps/particles/mixed_particles.h>
+#include <vps/particles/particles.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace vps::kernels {
+
+/// @brief Nearest-grid-point deposit: rho[cell_index(x)] += f / dx
+/// @tparam T Particle precision
+/// @tparam A Accumulation (field) precision
+/// @param particles Points to deposit
+/// @param rho Target field; its grid defines the cells
+template <std::floating_point T, std::floating_point A>
+void deposit_ngp(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho);
+
+/// @brief Nearest-grid-point deposit with the cells located on grid
+///
+/// grid must describe the same cells as rho.grid(), e.g. the StaticGrid that
+/// grid::visit_grid made from it.
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void deposit_ngp(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho,
+                 const G& grid);
+
+/// @brief Nearest-grid-point deposit of tiled points
+/// @tparam W Tile width
+template <std::floating_point T, std::size_t W, std::floating_point A>
+void deposit_ngp(const particles::TiledParticles<T, W>& particles, grid::BasicField<A>& rho);
+
+/// @brief Cloud-in-cell (linear) deposit, the adjoint of Field::interpolate
+///
+/// Each point's weight f / dx is split between cell_index(x) and its right
+/// neighbour using Grid::interpolation_weights(x), so interpolating the
+/// deposited field back reproduces the usual linear-weighting pair.
+template <std::floating_point T, std::floating_point A>
+void deposit_cic(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho);
+
+/// @brief Cloud-in-cell deposit with the cells located on grid, a stand-in for rho.grid()
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void deposit_cic(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho,
+                 const G& grid);
+
+/// @brief Cloud-in-cell deposit of tiled points
+template <std::floating_point T, std::size_t W, std::floating_point A>
+void deposit_cic(const particles::TiledParticles<T, W>& particles, grid::BasicField<A>& rho);
+
+/// @brief Nearest-grid-point deposit of cell-relative points
+///
+/// Uses the stored cell index directly (no wrap or division per point) and
+/// accumulates in double.
+void deposit_ngp(const particles::MixedParticles& particles, grid::Field& rho);
+
+// =============================================================================
+// Block Loops
+// =============================================================================
+
+namespace detail {
+
+/// @brief row[cell[i]] += f[i] * inv_dx for one located block
+template <std::floating_point T, std::floating_point A>
+void scatter_ngp(A* row, const std::uint32_t* cell, const T* f, std::size_t n,
+                 A inv_dx) noexcept;
+
+/// @brief Splits f[i] * inv_dx between cell[i] and the next cell for one located block
+/// @param last Index of the last cell
+/// @param after_last Cell that follows the last one (0 if periodic, else last)
+template <std::floating_point T, std::floating_point A>
+void scatter_cic(A* row, const std::uint32_t* cell, const A* right, const T* f, std::size_t n,
+                 A inv_dx, std::uint32_t last, std::uint32_t after_last) noexcept;
+
+/// @brief Calls fn(share, first, count) for the blocks of [0, n), in n_shares shares
+///
+/// Share r is a contiguous run of blocks handled in order on one thread.
+template <typename Fn>
+void for_each_share(std::size_t n, std::size_t n_shares, Fn&& fn) {
+    constexpr std::size_t block = memory::kernel_block;
+    const std::size_t n_blocks = (n + block - 1) / block;
+    particles::parallel_for(n_shares, [&](std::size_t r) {
+        for (std::size_t b = n_blocks * r / n_shares; b < n_blocks * (r + 1) / n_shares; ++b) {
+            fn(r, b * block, std::min(block, n - b * block));
+        }
+    }, n / n_shares);
+}
+
+/// @brief Per-share rows of a field, summed into it by add_to()
+///
+/// With a single share the row is the field itself and nothing is allocated;
+/// otherwise the rows come from memory::scratch().
+template <std::floating_point A>
+class DepositRows {
+public:
+    DepositRows(grid::BasicField<A>& rho, std::size_t points)
+        : rho_(&rho)
+        , n_rows_(particles::team_size(points))
+        , rows_(n_rows_ > 1 ? n_rows_ * rho.size() : 0, A{0}, memory::scratch())
+    {}
+
+    /// @brief Returns the number of rows (the team size)
+    [[nodiscard]] std::size_t size() const noexcept { return n_rows_; }
+
+    /// @brief Returns row r
+    [[nodiscard]] A* operator[](std::size_t r) noexcept {
+        return n_rows_ > 1 ? rows_.data() + r * rho_->size() : rho_->data();
+    }
+
+    /// @brief Adds the rows to the field, in row order
+    void add_to() {
+        if (n_rows_ == 1) {
+            return;
+        }
+        const std::size_t n_cells = rho_->size();
+        particles::parallel_for(n_cells, [&](std::size_t c) {
+            A sum = A{0};
+            for (std::size_t r = 0; r < n_rows_; ++r) {
+                sum += rows_[r * n_cells + c];
+            }
+            (*rho_)[c] += sum;
+        }, n_rows_);
+    }
+
+private:
+    grid::BasicField<A>* rho_;
+    std::size_t n_rows_;
+    std::pmr::vector<A> rows_;
+};
+
+} // namespace detail
+
+// =============================================================================
+// Template Implementations
+// =============================================================================
+
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void deposit_ngp(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho,
+                 const G& grid) {
+    assert(grid.n_cells() == rho.size() && "Grid does not match the field");
+    const A inv_dx = A{1} / grid.dx();
+    const T* x = particles.x().data();
+    const T* f = particles.f().data();
+    detail::DepositRows<A> rows(rho, particles.size());
+
+    particles.stream([&](std::size_t first, std::size_t last) {
+        detail::for_each_share(last - first, rows.size(),
+                               [&](std::size_t r, std::size_t offset, std::size_t n) {
+            const std::size_t p = first + offset;
+            std::array<std::uint32_t, memory::kernel_block> cell;
+            grid.cell_indices(std::span(x + p, n), std::span(cell.data(), n));
+            detail::scatter_ngp(rows[r], cell.data(), f + p, n, inv_dx);
+        });
+    });
+    rows.add_to();
+}
+
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void deposit_cic(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho,
+                 const G& grid) {
+    assert(grid.n_cells() == rho.size() && "Grid does not match the field");
+    const A inv_dx = A{1} / grid.dx();
+    const auto last = static_cast<std::uint32_t>(grid.n_cells() - 1);
+    const auto after_last = static_cast<std::uint32_t>(
+        grid.wrap_index(static_cast<std::ptrdiff_t>(grid.n_cells())));
+    const T* x = particles.x().data();
+    const T* f = particles.f().data();
+    detail::DepositRows<A> rows(rho, particles.size());
+
+    particles.stream([&](std::size_t first, std::size_t last_point) {
+        detail::for_each_share(last_point - first, rows.size(),
+                               [&](std::size_t r, std::size_t offset, std::size_t n) {
+            const std::size_t p = first + offset;
+            std::array<std::uint32_t, memory::kernel_block> cell;
+            std::array<A, memory::kernel_block> right;
+            grid.interpolation_weights(std::span(x + p, n), std::span(cell.data(), n),
+                                       std::span(right.data(), n));
+            detail::scatter_cic(rows[r], cell.data(), right.data(), f + p, n, inv_dx, last,
+                                after_last);
+        });
+    });
+    rows.add_to();
+}
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_DEPOSIT_H
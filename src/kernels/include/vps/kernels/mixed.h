@@ -0,0 +1,40 @@
+#ifndef VPS_KERNELS_MIXED_H
+#define VPS_KERNELS_MIXED_H
+
+/// @file mixed.h
+/// @brief Kernels for mixed-precision (cell-relative float) particles
+///
+/// MixedParticles store positions as (cell, offset); these kernels convert
+/// to and from absolute positions and advance the relative form directly,
+/// so the hot loop never forms a float absolute coordinate.
+
+#include <vps/grid/grid.h>
+#include <vps/particles/mixed_particles.h>
+#include <vps/particles/particles.h>
+
+#include <cstddef>
+
+namespace vps::kernels {
+
+/// @brief Converts absolute double-precision points to cell-relative form
+/// @param particles Points with absolute positions
+/// @param grid Grid defining the cells (positions are wrapped into it)
+[[nodiscard]] particles::MixedParticles to_mixed(const particles::Particles& particles,
+                                                 const grid::Grid& grid);
+
+/// @brief Returns the absolute position of point i
+[[nodiscard]] double position(const particles::MixedParticles& particles, std::size_t i,
+                              const grid::Grid& grid) noexcept;
+
+/// @brief Free streaming in cell-relative form
+/// @param particles The particles to advance
+/// @param grid Grid the cell indices refer to
+/// @param dt Time step
+///
+/// Implements: offset += v * dt / dx, then moves whole cells out of the
+/// offset into the (wrapped) cell index.
+void advance_positions(particles::MixedParticles& particles, const grid::Grid& grid, double dt);
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_MIXED_H
@@ -0,0 +1,46 @@
+#ifndef VPS_KERNELS_MOMENTS_H
+#define VPS_KERNELS_MOMENTS_H
+
+/// @file moments.h
+/// @brief Conservation diagnostics: total mass, momentum and kinetic energy
+///
+/// An OpenMP reduction adds per-thread partial sums in an order that
+/// depends on the team size, so a conservation check can drift in the last
+/// bits between a 1-thread and a 64-thread run of the same state. moments()
+/// fixes the reduction tree instead: points are cut into blocks of
+/// memory::kernel_block, each block is summed into a fixed set of SIMD
+/// lanes that are then added pairwise, and the block sums are combined by
+/// recursive halving over the block index. Only the blocks are spread over
+/// threads, so the result is bitwise identical for any thread count, and
+/// the pairwise tree keeps the rounding error at O(log n) rather than O(n).
+/// Sums are accumulated in double for both precisions.
+
+#include <vps/particles/particles.h>
+
+#include <concepts>
+#include <span>
+#include <type_traits>
+
+namespace vps::kernels {
+
+/// @brief Velocity moments of the distribution, weighted by f
+struct Moments {
+    double mass = 0.0;      ///< Sum of f
+    double momentum = 0.0;  ///< Sum of f v
+    double energy = 0.0;    ///< Sum of f v^2 / 2
+};
+
+/// @brief Returns the mass, momentum and kinetic energy of every point
+///
+/// Deterministic: the same points give the same bits for any thread count
+/// and backend.
+template <std::floating_point T>
+[[nodiscard]] Moments moments(const particles::BasicParticles<T>& particles);
+
+/// @brief Moments over explicit column spans (v.size() == f.size())
+template <std::floating_point T>
+[[nodiscard]] Moments moments(std::span<const T> v, std::type_identity_t<std::span<const T>> f);
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_MOMENTS_H
@@ -0,0 +1,437 @@
+#ifndef VPS_KERNELS_PIPELINE_H
+#define VPS_KERNELS_PIPELINE_H
+
+/// @file pipeline.h
+/// @brief Fused, chunked execution of per-point stages
+///
+/// Running advance_positions, wrapping and deposit_ngp one after another
+/// streams every array through DRAM once per kernel. A Pipeline declares a
+/// time step as a list of stages instead and runs all of them on one
+/// cache-sized chunk of points before moving to the next, so each point is
+/// loaded from memory once per step:
+///
+/// @code
+/// using namespace vps::kernels;
+/// auto step = stage::push(dt) | stage::wrap(grid) | stage::index(grid)
+///            | stage::deposit_cic(rho);
+/// for (int n = 0; n < n_steps; ++n) {
+///     rho.zero();
+///     step.run(particles);
+/// }
+/// @endcode
+///
+/// Chunks are split into contiguous shares, one per thread of the team
+/// chosen by particles::team_size(), and the shares run through
+/// particles::parallel_for on the kernel backend; each share runs the whole
+/// stage list on its chunks in order. Deposit stages accumulate into
+/// per-share copies of the field that are summed into it in share order
+/// when the run finishes, so the result does not depend on timing. The SIMD loops of the push and wrap stages are
+/// dispatched per ISA in VPS_PORTABLE builds (see vps/memory/isa.h).
+
+#include <vps/grid/grid.h>
+#include <vps/memory/aligned_allocator.h>
+#include <vps/memory/isa.h>
+#include <vps/particles/dispatch.h>
+#include <vps/particles/particles.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vps::kernels {
+
+// =============================================================================
+// Chunk View
+// =============================================================================
+
+/// @brief Contiguous sub-range [first, first + size()) of a particle container
+/// @tparam T Floating-point type of x, v and f
+template <std::floating_point T>
+struct ParticleChunk {
+    using value_type = T;
+
+    std::size_t first = 0;          ///< Index of the chunk's first point in the container
+    std::span<T> x;                 ///< Positions of the chunk
+    std::span<T> v;                 ///< Velocities of the chunk
+    std::span<T> f;                 ///< Weights of the chunk
+    std::span<std::uint32_t> cells; ///< Per-point cell scratch, filled by stage::index
+    bool indexed = false;           ///< True once cells holds the current cells
+
+    /// @brief Returns the number of points in the chunk
+    [[nodiscard]] std::size_t size() const noexcept { return x.size(); }
+};
+
+/// @brief Returns a view of points [first, last) of particles
+template <std::floating_point T>
+[[nodiscard]] ParticleChunk<T> make_chunk(particles::BasicParticles<T>& particles,
+                                          std::size_t first, std::size_t last) noexcept {
+    const std::size_t n = last - first;
+    return {first, particles.x().subspan(first, n), particles.v().subspan(first, n),
+            particles.f().subspan(first, n), {}, false};
+}
+
+// =============================================================================
+// Stage Protocol
+// =============================================================================
+
+/// @brief A stage is invoked as stage(chunk, thread) for every chunk
+///
+/// thread is the index of the share running the chunk, in [0, n_threads);
+/// chunks of one share never run concurrently. Stages may also provide
+/// prepare(n_threads), called before the first chunk, and finish(), called
+/// after the last; deposit stages use them to set up and reduce per-thread
+/// accumulators. Stage types opt into
+/// composition with operator| by defining `using is_stage = void;`.
+template <typename S>
+concept Stage = requires { typename S::is_stage; };
+
+template <Stage... Stages>
+class Pipeline;
+
+namespace detail {
+
+template <typename S>
+void prepare(S& stage, std::size_t n_threads) {
+    if constexpr (requires { stage.prepare(n_threads); }) {
+        stage.prepare(n_threads);
+    }
+}
+
+template <typename S>
+void finish(S& stage) {
+    if constexpr (requires { stage.finish(); }) {
+        stage.finish();
+    }
+}
+
+} // namespace detail
+
+// =============================================================================
+// Pipeline
+// =============================================================================
+
+/// @brief An ordered list of stages run chunk by chunk
+template <Stage... Stages>
+class Pipeline {
+public:
+    using is_stage = void;
+
+    /// @brief Bytes of x, v, f and cell scratch per chunk; sized to fit L2
+    static constexpr std::size_t default_chunk_bytes = std::size_t{256} << 10;
+
+    explicit Pipeline(Stages... stages) : stages_(std::move(stages)...) {}
+
+    /// @brief Runs every stage over every point of particles
+    /// @param particles Points to process
+    /// @param chunk_points Points per chunk (rounded to SIMD lanes); 0 picks
+    ///        default_chunk_bytes worth of points
+    ///
+    /// Not const: stages keep per-thread accumulators between prepare() and finish().
+    template <std::floating_point T>
+    void run(particles::BasicParticles<T>& particles, std::size_t chunk_points = 0) {
+        const std::size_t n = particles.size();
+        const std::size_t lanes = particles::BasicParticles<T>::lanes;
+        if (chunk_points == 0) {
+            chunk_points = default_chunk_bytes / (3 * sizeof(T) + sizeof(std::uint32_t));
+        }
+        const std::size_t chunk = memory::round_up(std::max<std::size_t>(chunk_points, 1), lanes);
+        const std::size_t n_chunks = (n + chunk - 1) / chunk;
+        const std::size_t n_threads =
+            std::clamp<std::size_t>(particles::team_size(n), 1, std::max<std::size_t>(n_chunks, 1));
+
+        std::apply([&](auto&... stage) { (detail::prepare(stage, n_threads), ...); }, stages_);
+        cells_.resize(n_threads * chunk);
+
+        // Share t is a contiguous run of chunks, processed in order
+        particles::parallel_for(n_threads, [&](std::size_t thread) {
+            const auto cells = std::span(cells_).subspan(thread * chunk, chunk);
+            for (std::size_t c = n_chunks * thread / n_threads;
+                 c < n_chunks * (thread + 1) / n_threads; ++c) {
+                auto view = make_chunk(particles, c * chunk, std::min((c + 1) * chunk, n));
+                view.cells = cells.first(view.size());
+                std::apply([&](auto&... stage) { (stage(view, thread), ...); }, stages_);
+            }
+        }, n / n_threads);
+
+        std::apply([](auto&... stage) { (detail::finish(stage), ...); }, stages_);
+    }
+
+    /// @brief Returns the stages, in order
+    [[nodiscard]] const std::tuple<Stages...>& stages() const noexcept { return stages_; }
+    [[nodiscard]] std::tuple<Stages...>& stages() noexcept { return stages_; }
+
+private:
+    std::tuple<Stages...> stages_;
+    std::vector<std::uint32_t> cells_;  ///< Per-share cell scratch, one chunk each
+};
+
+/// @brief Appends a stage (or another pipeline's stages) to a pipeline
+template <Stage... Lhs, Stage S>
+[[nodiscard]] auto operator|(Pipeline<Lhs...> lhs, S rhs) {
+    return std::apply(
+        [&](auto&... l) {
+            if constexpr (requires { rhs.stages(); }) {
+                return std::apply(
+                    [&](auto&... r) {
+                        return Pipeline<Lhs..., std::remove_cvref_t<decltype(r)>...>(
+                            std::move(l)..., std::move(r)...);
+                    },
+                    rhs.stages());
+            } else {
+                return Pipeline<Lhs..., S>(std::move(l)..., std::move(rhs));
+            }
+        },
+        lhs.stages());
+}
+
+/// @brief Starts a pipeline from two stages
+template <Stage A, Stage B>
+    requires(!requires(A a) { a.stages(); })
+[[nodiscard]] auto operator|(A lhs, B rhs) {
+    return Pipeline<A>(std::move(lhs)) | std::move(rhs);
+}
+
+// =============================================================================
+// Stages
+// =============================================================================
+
+namespace stage {
+
+// Found by argument-dependent lookup when composing two stages
+using kernels::operator|;
+
+/// @brief Free streaming: x += v * dt
+struct Push {
+    using is_stage = void;
+    double dt;
+
+    template <std::floating_point T>
+    VPS_TARGET_CLONES void operator()(ParticleChunk<T>& chunk, std::size_t) const noexcept {
+        const T step = static_cast<T>(dt);
+        T* x = chunk.x.data();
+        const T* v = chunk.v.data();
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp simd
+#endif
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            x[i] += v[i] * step;
+        }
+    }
+};
+
+/// @brief Uniform acceleration: v += a * dt
+struct Accelerate {
+    using is_stage = void;
+    double acceleration;
+    double dt;
+
+    template <std::floating_point T>
+    VPS_TARGET_CLONES void operator()(ParticleChunk<T>& chunk, std::size_t) const noexcept {
+        const T dv = static_cast<T>(acceleration * dt);
+        T* v = chunk.v.data();
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp simd
+#endif
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            v[i] += dv;
+        }
+    }
+};
+
+/// @brief Wraps positions into the grid's domain (periodic boundaries)
+template <std::floating_point G>
+struct Wrap {
+    using is_stage = void;
+    const grid::BasicGrid<G>* grid;
+
+    void operator()(ParticleChunk<G>& chunk, std::size_t) const noexcept {
+        grid->wrap_positions(chunk.x);
+        chunk.indexed = false;
+    }
+};
+
+/// @brief Push and periodic wrap in one loop (see kernels::stream_and_wrap)
+template <std::floating_point G>
+struct StreamAndWrap {
+    using is_stage = void;
+    double dt;
+    const grid::BasicGrid<G>* grid;
+
+    VPS_TARGET_CLONES void operator()(ParticleChunk<G>& chunk, std::size_t) const noexcept {
+        if (grid->boundary_condition() != grid::BoundaryCondition::Periodic) {
+            Push{dt}(chunk, 0);
+            return;
+        }
+        const G step = static_cast<G>(dt);
+        const G lo = grid->x_min();
+        const G hi = grid->x_max();
+        const G length = grid->length();
+        G* x = chunk.x.data();
+        const G* v = chunk.v.data();
+
+        std::size_t outside = 0;
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp simd reduction(+ : outside)
+#endif
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            G xn = x[i] + v[i] * step;
+            xn -= xn >= hi ? length : G{0};
+            xn += xn < lo ? length : G{0};
+            outside += static_cast<std::size_t>((xn < lo) | (xn >= hi));
+            x[i] = xn;
+        }
+        if (outside > 0) {
+            for (auto& xi : chunk.x) {
+                xi = grid->wrap_position(xi);
+            }
+        }
+        chunk.indexed = false;
+    }
+};
+
+/// @brief Computes each point's cell once for the stages that follow
+template <std::floating_point G>
+struct Index {
+    using is_stage = void;
+    const grid::BasicGrid<G>* grid;
+
+    void operator()(ParticleChunk<G>& chunk, std::size_t) const noexcept {
+        grid->cell_indices(std::span<const G>(chunk.x), chunk.cells);
+        chunk.indexed = true;
+    }
+};
+
+/// @brief Deposit into a field through per-thread accumulators
+/// @tparam A Precision of the field
+/// @tparam Cic true for cloud-in-cell, false for nearest grid point
+///
+/// Adds to the field like kernels::deposit_ngp/deposit_cic; zero it first
+/// for a fresh density. Cells and CIC weights come from the grid's batch
+/// calls, one per kernel block of the chunk; NGP reads the cells of a
+/// preceding stage::index instead when the chunk is indexed.
+template <std::floating_point A, bool Cic>
+class Deposit {
+public:
+    using is_stage = void;
+
+    explicit Deposit(grid::BasicField<A>& rho) : rho_(&rho) {}
+
+    void prepare(std::size_t n_threads) {
+        partial_.assign(n_threads * rho_->size(), A{0});
+    }
+
+    template <std::floating_point T>
+    void operator()(ParticleChunk<T>& chunk, std::size_t thread) noexcept {
+        const auto& grid = rho_->grid();
+        const std::size_t n_cells = rho_->size();
+        A* acc = partial_.data() + thread * n_cells;
+        const A inv_dx = A{1} / grid.dx();
+        constexpr std::size_t block = memory::kernel_block;
+        std::array<std::uint32_t, block> located;
+        [[maybe_unused]] std::array<A, block> right;
+
+        for (std::size_t first = 0; first < chunk.size(); first += block) {
+            const std::size_t n = std::min(block, chunk.size() - first);
+            const std::span<const T> x(chunk.x.data() + first, n);
+            const T* f = chunk.f.data() + first;
+            std::span<const std::uint32_t> cell(located.data(), n);
+            if constexpr (Cic) {
+                grid.interpolation_weights(x, std::span(located.data(), n),
+                                           std::span(right.data(), n));
+            } else if (chunk.indexed) {
+                cell = chunk.cells.subspan(first, n);
+            } else {
+                grid.cell_indices(x, std::span(located.data(), n));
+            }
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const A w = static_cast<A>(f[i]) * inv_dx;
+                if constexpr (Cic) {
+                    const auto idx_next = grid.wrap_index(static_cast<std::ptrdiff_t>(cell[i]) + 1);
+                    acc[cell[i]] += (A{1} - right[i]) * w;
+                    acc[idx_next] += right[i] * w;
+                } else {
+                    acc[cell[i]] += w;
+                }
+            }
+        }
+    }
+
+    void finish() {
+        const std::size_t n_cells = rho_->size();
+        const std::size_t n_threads = partial_.size() / std::max<std::size_t>(n_cells, 1);
+        for (std::size_t c = 0; c < n_cells; ++c) {
+            A sum = A{0};
+            for (std::size_t t = 0; t < n_threads; ++t) {
+                sum += partial_[t * n_cells + c];
+            }
+            (*rho_)[c] += sum;
+        }
+    }
+
+private:
+    grid::BasicField<A>* rho_;
+    std::vector<A> partial_;  ///< n_threads rows of n_cells
+};
+
+/// @brief Adapts any callable fn(chunk, thread) into a stage
+///
+/// fn is called concurrently for different chunks; per-thread state can be
+/// indexed by the thread argument.
+template <typename Fn>
+struct Custom {
+    using is_stage = void;
+    Fn fn;
+
+    template <std::floating_point T>
+    void operator()(ParticleChunk<T>& chunk, std::size_t thread) {
+        fn(chunk, thread);
+    }
+};
+
+/// @brief x += v * dt
+[[nodiscard]] inline Push push(double dt) noexcept { return {dt}; }
+
+/// @brief v += a * dt
+[[nodiscard]] inline Accelerate accelerate(double acceleration, double dt) noexcept {
+    return {acceleration, dt};
+}
+
+/// @brief Wrap positions into the domain of grid (must outlive the stage)
+template <std::floating_point G>
+[[nodiscard]] Wrap<G> wrap(const grid::BasicGrid<G>& grid) noexcept { return {&grid}; }
+
+/// @brief x += v * dt wrapped into the periodic domain of grid, branchless
+template <std::floating_point G>
+[[nodiscard]] StreamAndWrap<G> stream_and_wrap(double dt, const grid::BasicGrid<G>& grid) noexcept {
+    return {dt, &grid};
+}
+
+/// @brief Cache each point's cell of grid for later stages
+template <std::floating_point G>
+[[nodiscard]] Index<G> index(const grid::BasicGrid<G>& grid) noexcept { return {&grid}; }
+
+/// @brief Nearest-grid-point deposit of f into rho
+template <std::floating_point A>
+[[nodiscard]] Deposit<A, false> deposit_ngp(grid::BasicField<A>& rho) { return Deposit<A, false>(rho); }
+
+/// @brief Cloud-in-cell deposit of f into rho
+template <std::floating_point A>
+[[nodiscard]] Deposit<A, true> deposit_cic(grid::BasicField<A>& rho) { return Deposit<A, true>(rho); }
+
+/// @brief User stage: fn(ParticleChunk<T>&, thread) is called per chunk
+template <typename Fn>
+[[nodiscard]] Custom<Fn> custom(Fn fn) { return {std::move(fn)}; }
+
+} // namespace stage
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_PIPELINE_H
@@ -0,0 +1,287 @@
+#ifndef VPS_KERNELS_PUSH_H
+#define VPS_KERNELS_PUSH_H
+
+/// @file push.h
+/// @brief Fused particle pushes: streaming with wrap, and field kicks
+///
+/// advance_positions followed by a Grid::wrap_position loop writes every x
+/// and immediately reads it back for an fmod. stream_and_wrap does both in
+/// one vectorized pass: as long as a point moves less than one domain
+/// length per step, wrapping is a conditional add or subtract of L, which
+/// compiles to blends instead of a division and a branch.
+///
+/// fast_forward covers many field-free steps in one such pass, and kick
+/// is the velocity half of the step: it interpolates E at each point
+/// and updates v in the same sweep, with the same branchless wrap in place
+/// of the two fmods per point of Field::interpolate.
+///
+/// The grid is any grid::UniformGrid, a runtime Grid or a StaticGrid. The
+/// sweeps are the block loops compiled once per precision in push.cpp
+/// (cloned per ISA in VPS_PORTABLE builds) and kick's cell lookup is the
+/// grid's batch call, so both types run the same SIMD code for the bulk of
+/// the points. A StaticGrid only makes the boundary test a constant and
+/// inlines the rarely taken fallback wrap.
+
+#include <vps/grid/grid.h>
+#include <vps/grid/static_grid.h>
+#include <vps/particles/dispatch.h>
+#include <vps/particles/particles.h>
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace vps::kernels {
+
+/// @brief x += v * dt, then wraps x into the grid's periodic domain
+/// @param particles Points to advance
+/// @param grid Grid defining [x_min, x_max); non-periodic grids only push
+/// @param dt Time step
+/// @return Number of points that needed the fmod fallback (see below)
+///
+/// The hot loop assumes x starts inside the domain and |v * dt| < L, and
+/// wraps with one branchless conditional subtraction and addition of L.
+/// Points still outside afterwards (faster points, or x outside the domain
+/// on entry) are counted and fixed with grid.wrap_position in a second,
+/// rarely taken pass, so the result is always wrapped.
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t stream_and_wrap(particles::BasicParticles<T>& particles, const G& grid,
+                            std::type_identity_t<T> dt);
+
+/// @brief Fused stream and wrap over explicit column spans
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t stream_and_wrap(std::span<T> x, std::type_identity_t<std::span<const T>> v,
+                            const G& grid, std::type_identity_t<T> dt);
+
+/// @brief Field-free jump over n_steps steps: x += v * (n_steps * dt), wrapped
+/// @param particles Points to advance
+/// @param grid Grid defining [x_min, x_max); non-periodic grids only push
+/// @param dt Time step
+/// @param n_steps Number of steps to cover in this one pass
+/// @return Number of points that needed the fmod fallback
+///
+/// Without a field x(t) = x0 + v t is exact, so a stretch of pure streaming
+/// costs one pass instead of n_steps. Points may cross the domain any
+/// number of times: the wrap removes floor((x - x_min) / L) periods at once.
+/// The result differs from n_steps stream_and_wrap calls by rounding only.
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t fast_forward(particles::BasicParticles<T>& particles, const G& grid,
+                         std::type_identity_t<T> dt, std::size_t n_steps);
+
+/// @brief Field-free jump over explicit column spans
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t fast_forward(std::span<T> x, std::type_identity_t<std::span<const T>> v,
+                         const G& grid, std::type_identity_t<T> dt, std::size_t n_steps);
+
+/// @brief v += q/m * E(x) * dt with E interpolated linearly at each point
+/// @tparam T Particle precision
+/// @tparam A Field precision; interpolation runs in A
+/// @param particles Points to accelerate (x is read, v updated)
+/// @param E Electric field on its grid nodes
+/// @param q_over_m Charge-to-mass ratio of the species
+/// @param dt Time step
+///
+/// Interpolation is the one of Field::interpolate (and the adjoint of
+/// deposit_cic), so E(x) matches it up to rounding. Cells and weights are
+/// located a block at a time in a SIMD loop, then E is gathered and v
+/// updated in a second one; blocks run in parallel.
+template <std::floating_point T, std::floating_point A>
+void kick(particles::BasicParticles<T>& particles, const grid::BasicField<A>& E,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt);
+
+/// @brief Field kick over explicit column spans
+template <std::floating_point T, std::floating_point A>
+void kick(std::span<const T> x, std::span<T> v, const grid::BasicField<A>& E,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt);
+
+/// @brief Field kick with the cells located on grid, a stand-in for E's own grid
+///
+/// grid must describe the same cells as E.grid(), e.g. the StaticGrid that
+/// grid::visit_grid made from it.
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void kick(particles::BasicParticles<T>& particles, const grid::BasicField<A>& E, const G& grid,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt);
+
+/// @brief Field kick over explicit column spans, cells located on grid
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void kick(std::span<const T> x, std::span<T> v, const grid::BasicField<A>& E, const G& grid,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt);
+
+// =============================================================================
+// Block Loops
+// =============================================================================
+
+namespace detail {
+
+/// @brief x += v * dt and a one-period wrap into [lo, hi), in parallel blocks
+/// @return Number of points still outside [lo, hi)
+template <std::floating_point T>
+std::size_t stream_wrap(std::span<T> x, std::span<const T> v, T dt, T lo, T hi, T length);
+
+/// @brief x += v * t and a wrap by any number of periods, in parallel blocks
+/// @return Number of points still outside [lo, hi) after rounding
+template <std::floating_point T>
+std::size_t drift_wrap(std::span<T> x, std::span<const T> v, T t, T lo, T hi, T length);
+
+/// @brief Gathers E at n located points and kicks their velocities (one block)
+template <std::floating_point T, std::floating_point A>
+void kick_located(const A* e, std::uint32_t last, const std::uint32_t* cell, const A* right,
+                  T* v, std::size_t n, A qm_dt) noexcept;
+
+/// @brief Wraps, through the grid, the points the branchless loops left outside
+template <std::floating_point T, grid::UniformGrid G>
+void wrap_outside(std::span<T> x, const G& grid) {
+    const T lo = grid.x_min();
+    const T hi = grid.x_max();
+    particles::for_each_block(x.size(), [&](std::size_t first, std::size_t count) {
+        for (std::size_t i = first; i < first + count; ++i) {
+            if (x[i] < lo || x[i] >= hi) {
+                x[i] = grid.wrap_position(x[i]);
+            }
+        }
+    });
+}
+
+} // namespace detail
+
+// =============================================================================
+// Template Implementations
+// =============================================================================
+
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t stream_and_wrap(std::span<T> x, std::type_identity_t<std::span<const T>> v,
+                            const G& grid, std::type_identity_t<T> dt) {
+    assert(x.size() == v.size() && "Column spans differ in length");
+    if (grid.boundary_condition() != grid::BoundaryCondition::Periodic) {
+        particles::advance_positions(x, v, dt);
+        return 0;
+    }
+    const std::size_t outside =
+        detail::stream_wrap(x, v, dt, grid.x_min(), grid.x_max(), grid.length());
+    if (outside > 0) {
+        detail::wrap_outside(x, grid);
+    }
+    return outside;
+}
+
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t stream_and_wrap(particles::BasicParticles<T>& particles, const G& grid,
+                            std::type_identity_t<T> dt) {
+    const auto x = particles.x();
+    const auto v = particles.v();
+    std::size_t outside = 0;
+
+    // Live range only: padding lanes may sit outside the domain
+    particles.stream([&](std::size_t first, std::size_t last) {
+        outside += stream_and_wrap(x.subspan(first, last - first),
+                                   std::span<const T>(v.subspan(first, last - first)), grid, dt);
+    });
+    return outside;
+}
+
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t fast_forward(std::span<T> x, std::type_identity_t<std::span<const T>> v,
+                         const G& grid, std::type_identity_t<T> dt, std::size_t n_steps) {
+    assert(x.size() == v.size() && "Column spans differ in length");
+    const T t = static_cast<T>(n_steps) * dt;
+    if (grid.boundary_condition() != grid::BoundaryCondition::Periodic) {
+        particles::advance_positions(x, v, t);
+        return 0;
+    }
+    const std::size_t outside =
+        detail::drift_wrap(x, v, t, grid.x_min(), grid.x_max(), grid.length());
+    if (outside > 0) {
+        detail::wrap_outside(x, grid);
+    }
+    return outside;
+}
+
+template <std::floating_point T, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, T>
+std::size_t fast_forward(particles::BasicParticles<T>& particles, const G& grid,
+                         std::type_identity_t<T> dt, std::size_t n_steps) {
+    const auto x = particles.x();
+    const auto v = particles.v();
+    std::size_t outside = 0;
+    particles.stream([&](std::size_t first, std::size_t last) {
+        outside += fast_forward(x.subspan(first, last - first),
+                                std::span<const T>(v.subspan(first, last - first)), grid, dt,
+                                n_steps);
+    });
+    return outside;
+}
+
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void kick(std::span<const T> x, std::span<T> v, const grid::BasicField<A>& E, const G& grid,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt) {
+    assert(x.size() == v.size() && "Column spans differ in length");
+    assert(grid.n_cells() == E.size() && "Grid does not match the field");
+    const A qm_dt = static_cast<A>(q_over_m) * static_cast<A>(dt);
+
+    if (grid.boundary_condition() != grid::BoundaryCondition::Periodic) {
+        particles::for_each_block(x.size(), [&](std::size_t first, std::size_t count) {
+            for (std::size_t i = first; i < first + count; ++i) {
+                v[i] += static_cast<T>(qm_dt * E.interpolate(static_cast<A>(x[i])));
+            }
+        });
+        return;
+    }
+
+    const auto last = static_cast<std::uint32_t>(grid.n_cells() - 1);
+    particles::for_each_block(x.size(), [&](std::size_t first, std::size_t count) {
+        std::array<std::uint32_t, memory::kernel_block> cell;
+        std::array<A, memory::kernel_block> right;
+        grid.interpolation_weights(x.subspan(first, count), std::span(cell.data(), count),
+                                   std::span(right.data(), count));
+        detail::kick_located(E.data(), last, cell.data(), right.data(), v.data() + first, count,
+                             qm_dt);
+    });
+}
+
+template <std::floating_point T, std::floating_point A, grid::UniformGrid G>
+    requires std::same_as<typename G::value_type, A>
+void kick(particles::BasicParticles<T>& particles, const grid::BasicField<A>& E, const G& grid,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt) {
+    const auto x = particles.x();
+    const auto v = particles.v();
+    particles.stream([&](std::size_t first, std::size_t last) {
+        kick(std::span<const T>(x.subspan(first, last - first)), v.subspan(first, last - first),
+             E, grid, q_over_m, dt);
+    });
+}
+
+extern template std::size_t stream_and_wrap(particles::BasicParticles<float>&,
+                                            const grid::BasicGrid<float>&, float);
+extern template std::size_t stream_and_wrap(particles::BasicParticles<double>&,
+                                            const grid::BasicGrid<double>&, double);
+extern template std::size_t stream_and_wrap(std::span<float>, std::span<const float>,
+                                            const grid::BasicGrid<float>&, float);
+extern template std::size_t stream_and_wrap(std::span<double>, std::span<const double>,
+                                            const grid::BasicGrid<double>&, double);
+
+extern template std::size_t fast_forward(particles::BasicParticles<float>&,
+                                         const grid::BasicGrid<float>&, float, std::size_t);
+extern template std::size_t fast_forward(particles::BasicParticles<double>&,
+                                         const grid::BasicGrid<double>&, double, std::size_t);
+extern template std::size_t fast_forward(std::span<float>, std::span<const float>,
+                                         const grid::BasicGrid<float>&, float, std::size_t);
+extern template std::size_t fast_forward(std::span<double>, std::span<const double>,
+                                         const grid::BasicGrid<double>&, double, std::size_t);
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_PUSH_H
@@ -0,0 +1,83 @@
+#ifndef VPS_KERNELS_RESAMPLE_H
+#define VPS_KERNELS_RESAMPLE_H
+
+/// @file resample.h
+/// @brief Adaptive merging and splitting of phase-space points
+///
+/// Under filamentation a fixed set of points either stops resolving f or
+/// has to grow without bound. resample() bins the points by (cell,
+/// velocity) and
+/// - merges groups of light points in a bin into two points, and
+/// - splits heavy points in cells where the density is steep,
+///
+/// keeping the point count within a budget. Every operation stays inside
+/// one grid cell and conserves, per cell, the weight sum w, the first
+/// position moment w x and the velocity moments w v and w v^2. NGP and CIC
+/// deposits therefore give the same density afterwards, and momentum and
+/// kinetic energy on the grid are unchanged.
+
+#include <vps/grid/grid.h>
+#include <vps/particles/particles.h>
+
+#include <concepts>
+#include <cstddef>
+
+namespace vps::kernels {
+
+/// @brief Tuning knobs of resample()
+///
+/// Weights are compared against the mean weight of all points, so the
+/// defaults do not depend on the normalization of f.
+struct ResampleConfig {
+    /// @brief Point budget after resampling; 0 keeps the current count as budget
+    std::size_t max_points = 0;
+
+    /// @brief Velocity bins per cell; merging only combines points of one bin
+    std::size_t velocity_bins = 32;
+
+    /// @brief Bins whose mean weight is below this fraction of the global
+    /// mean are always merged
+    double merge_weight = 0.25;
+
+    /// @brief Points heavier than this multiple of the global mean may be split
+    double split_weight = 4.0;
+
+    /// @brief Relative density gradient |rho[c+1] - rho[c-1]| / (rho[c+1] + rho[c-1])
+    /// above which a cell counts as steep and its heavy points are split
+    double steep_gradient = 0.05;
+};
+
+/// @brief What a resample() call changed
+struct ResampleStats {
+    std::size_t merged_bins = 0;   ///< Bins collapsed to two points
+    std::size_t removed = 0;       ///< Points removed by merging
+    std::size_t split = 0;         ///< Points split in two (== points added)
+};
+
+/// @brief Merges and splits points to keep the count within config.max_points
+/// @param particles Points to resample; replaced by the resampled set
+/// @param grid Grid whose cells bound every merge and split
+/// @param config Budget and thresholds
+/// @return Counts of merged bins, removed and split points
+/// @throws std::invalid_argument if config.velocity_bins is zero or a
+///         threshold is negative
+///
+/// Merging: a bin with k >= 3 points of total weight W, mean position X,
+/// mean velocity V and velocity spread s becomes two points of weight W/2
+/// at (X, V - s) and (X, V + s). Light bins (see merge_weight) are always
+/// merged; while the count still exceeds the budget, further bins are
+/// merged in order of increasing mean weight.
+///
+/// Splitting: with room left in the budget, the heaviest eligible points
+/// become two points of half weight at x -/+ d, d being half the distance
+/// to the nearer cell edge, with unchanged velocity.
+///
+/// The result is ordered by (cell, velocity bin). Cell offsets held by a
+/// CellIndex are invalidated; call CellIndex::sort() afterwards.
+template <std::floating_point T>
+ResampleStats resample(particles::BasicParticles<T>& particles, const grid::BasicGrid<T>& grid,
+                       const ResampleConfig& config = {});
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_RESAMPLE_H
@@ -0,0 +1,244 @@
+#ifndef VPS_KERNELS_SPECIES_H
+#define VPS_KERNELS_SPECIES_H
+
+/// @file species.h
+/// @brief Several particle species on one shared grid
+///
+/// Electrons, ions and dust differ in charge, mass and numbers of points,
+/// but move on the same grid and source the same charge density. A
+/// SpeciesSet keeps one Particles block per species together with its
+/// charge and mass, and its kernels sweep every species in a single
+/// parallel region: work is cut into blocks of memory::kernel_block points
+/// across all species, so a small species does not leave threads idle
+/// and the team is started once per sweep rather than once per species.
+///
+/// @code
+/// SpeciesSet plasma(grid);
+/// plasma.add("electrons", -1.0, 1.0, std::move(electrons));
+/// plasma.add("ions", 1.0, 1836.0, std::move(ions));
+///
+/// rho.zero();
+/// deposit_charge_cic(plasma, rho);   // one sweep, every species
+/// kick(plasma, E, dt);               // q/m of each species
+/// stream_and_wrap(plasma, dt);
+/// @endcode
+
+#include <vps/grid/grid.h>
+#include <vps/memory/arena.h>
+#include <vps/memory/isa.h>
+#include <vps/particles/dispatch.h>
+#include <vps/particles/particles.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace vps::kernels {
+
+/// @brief One species: its points and their charge and mass per unit weight
+template <std::floating_point T>
+struct BasicSpecies {
+    std::string name;                         ///< Label, unique within a set
+    T charge;                                 ///< Charge q carried per unit of f
+    T mass;                                   ///< Mass m per unit of f (positive)
+    particles::BasicParticles<T> particles;   ///< Phase-space points
+
+    /// @brief Returns the charge-to-mass ratio q/m
+    [[nodiscard]] T q_over_m() const noexcept { return charge / mass; }
+};
+
+/// @brief Double-precision species
+using Species = BasicSpecies<double>;
+
+/// @brief Single-precision species
+using SpeciesF = BasicSpecies<float>;
+
+/// @brief Species sharing one grid, swept together by the species kernels
+/// @tparam T Precision of the points and grid
+template <std::floating_point T>
+class BasicSpeciesSet {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using grid_type = grid::BasicGrid<T>;
+    using species_type = BasicSpecies<T>;
+    using particles_type = particles::BasicParticles<T>;
+
+    /// @brief Create an empty set on grid
+    /// @param grid Grid shared by every species (must outlive the set)
+    explicit BasicSpeciesSet(const grid_type& grid);
+
+    // =========================================================================
+    // Species
+    // =========================================================================
+
+    /// @brief Adds a species and returns it
+    /// @throws std::invalid_argument if mass is not positive or name is taken
+    ///
+    /// References to species obtained earlier may be invalidated.
+    species_type& add(std::string name, value_type charge, value_type mass,
+                      particles_type particles = particles_type{});
+
+    /// @brief Returns the number of species
+    [[nodiscard]] size_type size() const noexcept;
+
+    /// @brief Returns true if the set has no species
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// @brief Returns species i
+    [[nodiscard]] species_type& operator[](size_type i) noexcept;
+    [[nodiscard]] const species_type& operator[](size_type i) const noexcept;
+
+    /// @brief Returns the species called name, or nullptr
+    [[nodiscard]] species_type* find(std::string_view name) noexcept;
+    [[nodiscard]] const species_type* find(std::string_view name) const noexcept;
+
+    /// @brief Returns the number of points over all species
+    [[nodiscard]] size_type total_points() const noexcept;
+
+    /// @brief Returns the shared grid
+    [[nodiscard]] const grid_type& grid() const noexcept;
+
+    [[nodiscard]] auto begin() noexcept { return species_.begin(); }
+    [[nodiscard]] auto end() noexcept { return species_.end(); }
+    [[nodiscard]] auto begin() const noexcept { return species_.begin(); }
+    [[nodiscard]] auto end() const noexcept { return species_.end(); }
+
+    // =========================================================================
+    // Sweeps
+    // =========================================================================
+
+    /// @brief Calls fn(species, first, count) for every block of every species
+    ///
+    /// Blocks have memory::kernel_block points (the last of a species may
+    /// be shorter) and are distributed in one particles::parallel_for;
+    /// species are visited in order. fn runs
+    /// concurrently for different blocks. Kernels called from fn on their
+    /// block (see particles::for_each_block) run serially on that thread.
+    template <typename Fn>
+    void for_each_block(Fn&& fn);
+
+    /// @brief Read-only sweep, as above
+    template <typename Fn>
+    void for_each_block(Fn&& fn) const;
+
+    /// @brief Calls fn(share, species, first, count) for every block, in shares
+    ///
+    /// The flat block list is cut into n_shares contiguous shares, and each
+    /// share runs its blocks in order on one thread. Which blocks feed a
+    /// per-share accumulator is fixed by n_shares alone, whatever the
+    /// backend or the timing of a work-stealing sweep.
+    template <typename Fn>
+    void for_each_share(size_type n_shares, Fn&& fn) const;
+
+private:
+    /// @brief Starts of each species' blocks in the flat block numbering
+    [[nodiscard]] std::pmr::vector<size_type> block_offsets() const;
+
+    template <typename Set, typename Fn>
+    static void sweep(Set& set, Fn&& fn);
+
+    const grid_type* grid_;               ///< Shared grid (non-owning)
+    std::vector<species_type> species_;   ///< Species in insertion order
+};
+
+/// @brief Double-precision species set (the default)
+using SpeciesSet = BasicSpeciesSet<double>;
+
+/// @brief Single-precision species set
+using SpeciesSetF = BasicSpeciesSet<float>;
+
+extern template class BasicSpeciesSet<float>;
+extern template class BasicSpeciesSet<double>;
+
+// =============================================================================
+// Species Kernels
+// =============================================================================
+
+/// @brief stream_and_wrap of every species on the set's grid, one sweep
+/// @return Number of points that needed the fmod fallback
+template <std::floating_point T>
+std::size_t stream_and_wrap(BasicSpeciesSet<T>& set, std::type_identity_t<T> dt);
+
+/// @brief kick of every species with its own q/m, one sweep
+/// @tparam A Field precision
+template <std::floating_point T, std::floating_point A>
+void kick(BasicSpeciesSet<T>& set, const grid::BasicField<A>& E, std::type_identity_t<T> dt);
+
+/// @brief Charge density rho += sum over species of q * f / dx, nearest grid point
+///
+/// All species are deposited in one sweep into per-thread rows of the
+/// field, which are summed into rho at the end. Each row covers a fixed
+/// share of the blocks (see for_each_share), so for a given team size the
+/// result does not depend on timing. Zero rho first for a fresh density.
+template <std::floating_point T, std::floating_point A>
+void deposit_charge_ngp(const BasicSpeciesSet<T>& set, grid::BasicField<A>& rho);
+
+/// @brief Charge density as above, cloud in cell
+template <std::floating_point T, std::floating_point A>
+void deposit_charge_cic(const BasicSpeciesSet<T>& set, grid::BasicField<A>& rho);
+
+// =============================================================================
+// Template Implementations
+// =============================================================================
+
+template <std::floating_point T>
+template <typename Fn>
+void BasicSpeciesSet<T>::for_each_block(Fn&& fn) {
+    sweep(*this, fn);
+}
+
+template <std::floating_point T>
+template <typename Fn>
+void BasicSpeciesSet<T>::for_each_block(Fn&& fn) const {
+    sweep(*this, fn);
+}
+
+template <std::floating_point T>
+template <typename Fn>
+void BasicSpeciesSet<T>::for_each_share(size_type n_shares, Fn&& fn) const {
+    constexpr size_type block = memory::kernel_block;
+    const std::pmr::vector<size_type> offsets = block_offsets();
+    const size_type n_blocks = offsets.back();
+    const size_type share_points = n_shares > 0 ? total_points() / n_shares : 0;
+
+    particles::parallel_for(n_shares, [&](size_type r) {
+        auto s = static_cast<size_type>(
+            std::upper_bound(offsets.begin(), offsets.end(), n_blocks * r / n_shares) -
+            offsets.begin() - 1);
+        for (size_type b = n_blocks * r / n_shares; b < n_blocks * (r + 1) / n_shares; ++b) {
+            while (b >= offsets[s + 1]) {
+                ++s;  // skips species without points too
+            }
+            const auto& species = species_[s];
+            const size_type first = (b - offsets[s]) * block;
+            fn(r, species, first, std::min(block, species.particles.size() - first));
+        }
+    }, share_points);
+}
+
+template <std::floating_point T>
+template <typename Set, typename Fn>
+void BasicSpeciesSet<T>::sweep(Set& set, Fn&& fn) {
+    constexpr size_type block = memory::kernel_block;
+    const std::pmr::vector<size_type> offsets = set.block_offsets();
+    const size_type n_blocks = offsets.back();
+
+    particles::parallel_for(n_blocks, [&](size_type b) {
+        // Species s owns flat blocks [offsets[s], offsets[s + 1])
+        const auto s = static_cast<size_type>(
+            std::upper_bound(offsets.begin(), offsets.end(), b) - offsets.begin() - 1);
+        auto& species = set.species_[s];
+        const size_type first = (b - offsets[s]) * block;
+        fn(species, first, std::min(block, species.particles.size() - first));
+    }, block);
+}
+
+} // namespace vps::kernels
+
+#endif // VPS_KERNELS_SPECIES_H
@@ -0,0 +1,277 @@
+#include "vps/kernels/cell_index.h"
+
+#include <vps/memory/arena.h>
+#include <vps/particles/dispatch.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+namespace vps::kernels {
+
+namespace {
+
+/// @brief out[k] = in[order[k]] for one block, cloned per ISA
+template <typename U>
+VPS_TARGET_CLONES void gather_block(const U* in, U* out, const std::size_t* order,
+                                    std::size_t n) noexcept {
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd
+#endif
+    for (std::size_t k = 0; k < n; ++k) {
+        out[k] = in[order[k]];
+    }
+}
+
+/// @brief Permutes every column in place: column[k] = old column[order[k]]
+///
+/// One column at a time is gathered into a scratch buffer sized for the
+/// widest column, then copied back, so the sort never holds a second copy
+/// of the whole container.
+template <particles::Column... Cols>
+void permute(particles::SoA<Cols...>& soa, std::span<const std::size_t> order) {
+    const std::size_t n = order.size();
+    constexpr std::size_t widest = std::max({sizeof(typename Cols::value_type)...});
+    constexpr std::size_t alignment = particles::SoA<Cols...>::alignment;
+    std::pmr::polymorphic_allocator<> alloc(memory::scratch());
+    void* buffer = alloc.allocate_bytes(n * widest, alignment);
+    (
+        [&] {
+            using U = typename Cols::value_type;
+            auto* column = soa.template data<Cols>();
+            auto* gathered = static_cast<U*>(buffer);
+            particles::for_each_block(n, [&](std::size_t first, std::size_t count) {
+                gather_block(column, gathered + first, order.data() + first, count);
+            });
+            particles::for_each_block(n, [&](std::size_t first, std::size_t count) {
+                std::copy_n(gathered + first, count, column + first);
+            });
+        }(),
+        ...);
+    alloc.deallocate_bytes(buffer, n * widest, alignment);
+}
+
+} // namespace
+
+// =============================================================================
+// Construction
+// =============================================================================
+
+template <std::floating_point T>
+BasicCellIndex<T>::BasicCellIndex(const grid_type& grid, size_type sort_interval)
+    : grid_(&grid)
+    , sort_interval_(sort_interval)
+    , offsets_(grid.n_cells() + 1, 0)
+{
+    if (sort_interval == 0) {
+        throw std::invalid_argument("CellIndex sort interval must be positive");
+    }
+}
+
+// =============================================================================
+// Sorting
+// =============================================================================
+
+template <std::floating_point T>
+void BasicCellIndex<T>::sort(particles_type& particles) {
+    const size_type n = particles.size();
+    const size_type n_cells = grid_->n_cells();
+    compute_keys(particles);
+
+    // Per-share histograms over the same contiguous shares used for the scatter
+    const size_type n_shares = std::max<size_type>(particles::team_size(n), 1);
+    counts_.assign(n_shares * n_cells, 0);
+    particles::parallel_for(n_shares, [&](size_type t) {
+        size_type* local = counts_.data() + t * n_cells;
+        for (size_type i = n * t / n_shares; i < n * (t + 1) / n_shares; ++i) {
+            ++local[keys_[i]];
+        }
+    }, n / n_shares);
+
+    // Exclusive prefix in (cell, share) order keeps the sort stable
+    size_type running = 0;
+    for (size_type c = 0; c < n_cells; ++c) {
+        offsets_[c] = running;
+        for (size_type t = 0; t < n_shares; ++t) {
+            const size_type cnt = counts_[t * n_cells + c];
+            counts_[t * n_cells + c] = running;
+            running += cnt;
+        }
+    }
+    offsets_[n_cells] = running;
+    order_.resize(n);
+
+    particles::parallel_for(n_shares, [&](size_type t) {
+        size_type* local = counts_.data() + t * n_cells;
+        for (size_type i = n * t / n_shares; i < n * (t + 1) / n_shares; ++i) {
+            order_[local[keys_[i]]++] = i;
+        }
+    }, n / n_shares);
+
+    apply_order(particles);
+    steps_ = 0;
+}
+
+template <std::floating_point T>
+bool BasicCellIndex<T>::resort(particles_type& particles) {
+    const size_type n = particles.size();
+    const size_type n_cells = grid_->n_cells();
+    if (offsets_[n_cells] != n) {
+        // Size changed since the last sort: offsets no longer describe the container
+        sort(particles);
+        return true;
+    }
+    compute_keys(particles);
+
+    // Per cell: how many of its points stayed and how many moved out
+    counts_.assign(3 * n_cells, 0);
+    size_type* stayed = counts_.data();
+    size_type* moved = counts_.data() + n_cells;
+    size_type* incoming = counts_.data() + 2 * n_cells;
+    const size_type cell_points = n / n_cells;  // per-index work for the cell sweeps
+
+    particles::parallel_for(n_cells, [&](size_type c) {
+        size_type s = 0;
+        for (size_type i = offsets_[c]; i < offsets_[c + 1]; ++i) {
+            s += keys_[i] == c ? size_type{1} : size_type{0};
+        }
+        stayed[c] = s;
+        moved[c] = offsets_[c + 1] - offsets_[c] - s;
+    }, cell_points);
+
+    size_type total_moved = 0;
+    for (size_type c = 0; c < n_cells; ++c) {
+        const size_type m = moved[c];
+        moved[c] = total_moved;  // becomes the cell's start in movers_
+        total_moved += m;
+    }
+    if (total_moved == 0) {
+        steps_ = 0;
+        return false;
+    }
+    if (static_cast<double>(total_moved) > max_mover_fraction * static_cast<double>(n)) {
+        sort(particles);
+        return true;
+    }
+
+    // Collect movers in index order, then bucket them by destination (few, serial)
+    movers_.resize(total_moved);
+    particles::parallel_for(n_cells, [&](size_type c) {
+        size_type out = moved[c];
+        for (size_type i = offsets_[c]; i < offsets_[c + 1]; ++i) {
+            if (keys_[i] != c) {
+                movers_[out++] = i;
+            }
+        }
+    }, cell_points);
+
+    for (const size_type i : movers_) {
+        ++incoming[keys_[i]];
+    }
+    std::pmr::vector<size_type> old_offsets(offsets_.begin(), offsets_.end(), memory::scratch());
+    size_type running = 0;
+    for (size_type c = 0; c < n_cells; ++c) {
+        offsets_[c] = running;
+        running += stayed[c] + incoming[c];
+    }
+    offsets_[n_cells] = running;
+
+    // incoming[c] becomes the write cursor for movers into cell c, after its stayers
+    for (size_type c = 0; c < n_cells; ++c) {
+        incoming[c] = offsets_[c] + stayed[c];
+    }
+    order_.resize(n);
+    for (const size_type i : movers_) {
+        order_[incoming[keys_[i]]++] = i;
+    }
+
+    // Stayers keep their relative order at the front of each cell
+    particles::parallel_for(n_cells, [&](size_type c) {
+        size_type out = offsets_[c];
+        for (size_type i = old_offsets[c]; i < old_offsets[c + 1]; ++i) {
+            if (keys_[i] == c) {
+                order_[out++] = i;
+            }
+        }
+    }, cell_points);
+
+    apply_order(particles);
+    steps_ = 0;
+    return true;
+}
+
+template <std::floating_point T>
+bool BasicCellIndex<T>::step(particles_type& particles) {
+    if (++steps_ < sort_interval_) {
+        return false;
+    }
+    resort(particles);
+    steps_ = 0;
+    return true;
+}
+
+template <std::floating_point T>
+typename BasicCellIndex<T>::size_type BasicCellIndex<T>::sort_interval() const noexcept {
+    return sort_interval_;
+}
+
+template <std::floating_point T>
+void BasicCellIndex<T>::set_sort_interval(size_type interval) {
+    if (interval == 0) {
+        throw std::invalid_argument("CellIndex sort interval must be positive");
+    }
+    sort_interval_ = interval;
+}
+
+// =============================================================================
+// Offsets
+// =============================================================================
+
+template <std::floating_point T>
+std::span<const typename BasicCellIndex<T>::size_type>
+BasicCellIndex<T>::offsets() const noexcept {
+    return offsets_;
+}
+
+template <std::floating_point T>
+typename BasicCellIndex<T>::size_type BasicCellIndex<T>::count(size_type c) const noexcept {
+    assert(c < grid_->n_cells() && "Cell index out of bounds");
+    return offsets_[c + 1] - offsets_[c];
+}
+
+template <std::floating_point T>
+const typename BasicCellIndex<T>::grid_type& BasicCellIndex<T>::grid() const noexcept {
+    return *grid_;
+}
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+template <std::floating_point T>
+void BasicCellIndex<T>::compute_keys(const particles_type& particles) {
+    const size_type n = particles.size();
+    const auto x = particles.x();
+    const grid_type& grid = *grid_;
+    keys_.resize(n);
+
+    particles::for_each_block(n, [&](size_type first, size_type count) {
+        grid.cell_indices(x.subspan(first, count), std::span(keys_).subspan(first, count));
+    });
+}
+
+template <std::floating_point T>
+void BasicCellIndex<T>::apply_order(particles_type& particles) {
+    permute(particles.soa(), order_);
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template class BasicCellIndex<float>;
+template class BasicCellIndex<double>;
+
+} // namespace vps::kernels
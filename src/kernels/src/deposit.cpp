@@ -0,0 +1,173 @@
+#include "vps/kernels/deposit.h"
+
+#include <vps/memory/isa.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace vps::kernels {
+
+namespace {
+
+/// @brief NGP scatter of one located block, cloned per ISA
+template <std::floating_point T, std::floating_point A>
+VPS_TARGET_CLONES void scatter_ngp_block(A* row, const std::uint32_t* cell, const T* f,
+                                         std::size_t n, A inv_dx) noexcept {
+    // Cells may repeat within a block, so the stores stay in order
+    for (std::size_t i = 0; i < n; ++i) {
+        row[cell[i]] += static_cast<A>(f[i]) * inv_dx;
+    }
+}
+
+/// @brief CIC scatter of one located block, cloned per ISA
+template <std::floating_point T, std::floating_point A>
+VPS_TARGET_CLONES void scatter_cic_block(A* row, const std::uint32_t* cell, const A* right,
+                                         const T* f, std::size_t n, A inv_dx, std::uint32_t last,
+                                         std::uint32_t after_last) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t c = cell[i];
+        const std::uint32_t next = c == last ? after_last : c + 1;
+        const A w = static_cast<A>(f[i]) * inv_dx;
+        row[c] += (A{1} - right[i]) * w;
+        row[next] += right[i] * w;
+    }
+}
+
+/// @brief Tiled deposit: blocks of tiles are copied to x and f columns, then
+/// located and scattered like the SoA deposit, skipping the padding lanes
+template <bool Cic, std::floating_point T, std::size_t W, std::floating_point A>
+void deposit_tiled(const particles::TiledParticles<T, W>& particles, grid::BasicField<A>& rho) {
+    static_assert(memory::kernel_block % W == 0, "Blocks must hold whole tiles");
+    const auto& grid = rho.grid();
+    const A inv_dx = A{1} / grid.dx();
+    const auto last = static_cast<std::uint32_t>(grid.n_cells() - 1);
+    const auto after_last = static_cast<std::uint32_t>(
+        grid.wrap_index(static_cast<std::ptrdiff_t>(grid.n_cells())));
+    const auto tiles = particles.tiles();
+    detail::DepositRows<A> rows(rho, particles.size());
+
+    detail::for_each_share(particles.size(), rows.size(),
+                           [&](std::size_t r, std::size_t first, std::size_t n) {
+        std::array<T, memory::kernel_block> x;
+        std::array<T, memory::kernel_block> f;
+        for (std::size_t i = 0; i < n; i += W) {
+            const auto& tile = tiles[(first + i) / W];
+            const std::size_t lanes = std::min(W, n - i);
+            std::copy_n(tile.x.data(), lanes, x.data() + i);
+            std::copy_n(tile.f.data(), lanes, f.data() + i);
+        }
+        std::array<std::uint32_t, memory::kernel_block> cell;
+        if constexpr (Cic) {
+            std::array<A, memory::kernel_block> right;
+            grid.interpolation_weights(std::span<const T>(x.data(), n),
+                                       std::span(cell.data(), n), std::span(right.data(), n));
+            scatter_cic_block(rows[r], cell.data(), right.data(), f.data(), n, inv_dx, last,
+                              after_last);
+        } else {
+            grid.cell_indices(std::span<const T>(x.data(), n), std::span(cell.data(), n));
+            scatter_ngp_block(rows[r], cell.data(), f.data(), n, inv_dx);
+        }
+    });
+    rows.add_to();
+}
+
+} // namespace
+
+namespace detail {
+
+template <std::floating_point T, std::floating_point A>
+void scatter_ngp(A* row, const std::uint32_t* cell, const T* f, std::size_t n,
+                 A inv_dx) noexcept {
+    scatter_ngp_block(row, cell, f, n, inv_dx);
+}
+
+template <std::floating_point T, std::floating_point A>
+void scatter_cic(A* row, const std::uint32_t* cell, const A* right, const T* f, std::size_t n,
+                 A inv_dx, std::uint32_t last, std::uint32_t after_last) noexcept {
+    scatter_cic_block(row, cell, right, f, n, inv_dx, last, after_last);
+}
+
+template void scatter_ngp(float*, const std::uint32_t*, const float*, std::size_t,
+                          float) noexcept;
+template void scatter_ngp(double*, const std::uint32_t*, const float*, std::size_t,
+                          double) noexcept;
+template void scatter_ngp(double*, const std::uint32_t*, const double*, std::size_t,
+                          double) noexcept;
+
+template void scatter_cic(float*, const std::uint32_t*, const float*, const float*, std::size_t,
+                          float, std::uint32_t, std::uint32_t) noexcept;
+template void scatter_cic(double*, const std::uint32_t*, const double*, const float*,
+                          std::size_t, double, std::uint32_t, std::uint32_t) noexcept;
+template void scatter_cic(double*, const std::uint32_t*, const double*, const double*,
+                          std::size_t, double, std::uint32_t, std::uint32_t) noexcept;
+
+} // namespace detail
+
+// =============================================================================
+// Nearest Grid Point
+// =============================================================================
+
+template <std::floating_point T, std::floating_point A>
+void deposit_ngp(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho) {
+    deposit_ngp(particles, rho, rho.grid());
+}
+
+template <std::floating_point T, std::size_t W, std::floating_point A>
+void deposit_ngp(const particles::TiledParticles<T, W>& particles, grid::BasicField<A>& rho) {
+    deposit_tiled<false>(particles, rho);
+}
+
+void deposit_ngp(const particles::MixedParticles& particles, grid::Field& rho) {
+    const double inv_dx = 1.0 / rho.grid().dx();
+    const auto cell = particles.cell();
+    const auto f = particles.f();
+
+    for (std::size_t p = 0; p < particles.size(); ++p) {
+        rho[cell[p]] += static_cast<double>(f[p]) * inv_dx;
+    }
+}
+
+// =============================================================================
+// Cloud in Cell
+// =============================================================================
+
+template <std::floating_point T, std::floating_point A>
+void deposit_cic(const particles::BasicParticles<T>& particles, grid::BasicField<A>& rho) {
+    deposit_cic(particles, rho, rho.grid());
+}
+
+template <std::floating_point T, std::size_t W, std::floating_point A>
+void deposit_cic(const particles::TiledParticles<T, W>& particles, grid::BasicField<A>& rho) {
+    deposit_tiled<true>(particles, rho);
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template void deposit_ngp(const particles::ParticlesF&, grid::FieldF&);
+template void deposit_ngp(const particles::ParticlesF&, grid::Field&);
+template void deposit_ngp(const particles::Particles&, grid::Field&);
+
+template void deposit_cic(const particles::ParticlesF&, grid::FieldF&);
+template void deposit_cic(const particles::ParticlesF&, grid::Field&);
+template void deposit_cic(const particles::Particles&, grid::Field&);
+
+template void deposit_ngp(const particles::TiledParticles<float, 8>&, grid::FieldF&);
+template void deposit_ngp(const particles::TiledParticles<float, 16>&, grid::FieldF&);
+template void deposit_ngp(const particles::TiledParticles<float, 8>&, grid::Field&);
+template void deposit_ngp(const particles::TiledParticles<float, 16>&, grid::Field&);
+template void deposit_ngp(const particles::TiledParticles<double, 8>&, grid::Field&);
+template void deposit_ngp(const particles::TiledParticles<double, 16>&, grid::Field&);
+
+template void deposit_cic(const particles::TiledParticles<float, 8>&, grid::FieldF&);
+template void deposit_cic(const particles::TiledParticles<float, 16>&, grid::FieldF&);
+template void deposit_cic(const particles::TiledParticles<float, 8>&, grid::Field&);
+template void deposit_cic(const particles::TiledParticles<float, 16>&, grid::Field&);
+template void deposit_cic(const particles::TiledParticles<double, 8>&, grid::Field&);
+template void deposit_cic(const particles::TiledParticles<double, 16>&, grid::Field&);
+
+} // namespace vps::kernels
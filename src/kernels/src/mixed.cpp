@@ -0,0 +1,77 @@
+#include "vps/kernels/mixed.h"
+
+#include <vps/particles/dispatch.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace vps::kernels {
+
+using particles::MixedParticles;
+
+// =============================================================================
+// Conversion
+// =============================================================================
+
+MixedParticles to_mixed(const particles::Particles& particles, const grid::Grid& grid) {
+    // Largest offset strictly below one cell
+    const float max_offset = std::nextafter(1.0f, 0.0f);
+    const double inv_dx = 1.0 / grid.dx();
+
+    MixedParticles mixed;
+    mixed.resize(particles.size());
+    auto cell = mixed.cell();
+    auto offset = mixed.offset();
+    auto v = mixed.v();
+    auto f = mixed.f();
+
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        const double x = grid.wrap_position(particles.x(i));
+        const auto idx = grid.cell_index(x);
+        const double rel = (x - grid.cell_left(idx)) * inv_dx;
+
+        cell[i] = static_cast<MixedParticles::cell_type>(idx);
+        offset[i] = std::clamp(static_cast<float>(rel), 0.0f, max_offset);
+        v[i] = static_cast<float>(particles.v(i));
+        f[i] = static_cast<float>(particles.f(i));
+    }
+    return mixed;
+}
+
+double position(const MixedParticles& particles, std::size_t i, const grid::Grid& grid) noexcept {
+    const double cell = static_cast<double>(particles.cell()[i]);
+    const double offset = static_cast<double>(particles.offset()[i]);
+    return grid.x_min() + (cell + offset) * grid.dx();
+}
+
+// =============================================================================
+// Free Streaming
+// =============================================================================
+
+void advance_positions(MixedParticles& particles, const grid::Grid& grid, double dt) {
+    auto cell = particles.cell();
+    auto offset = particles.offset();
+    const auto v = particles.v();
+    const auto n = particles.size();
+    const float scale = static_cast<float>(dt / grid.dx());
+
+    particles::for_each_block(n, [&](std::size_t first, std::size_t count) {
+        for (std::size_t i = first; i < first + count; ++i) {
+            const float s = offset[i] + v[i] * scale;
+            float shift = std::floor(s);
+            float o = s - shift;
+            if (o >= 1.0f) {  // s - floor(s) rounds up to 1 for tiny negative s
+                o = 0.0f;
+                shift += 1.0f;
+            }
+            offset[i] = o;
+            if (shift != 0.0f) {
+                const auto moved = static_cast<std::ptrdiff_t>(cell[i]) +
+                                   static_cast<std::ptrdiff_t>(shift);
+                cell[i] = static_cast<MixedParticles::cell_type>(grid.wrap_index(moved));
+            }
+        }
+    });
+}
+
+} // namespace vps::kernels
@@ -0,0 +1,128 @@
+#include "vps/kernels/moments.h"
+
+#include <vps/memory/arena.h>
+#include <vps/memory/isa.h>
+#include <vps/particles/dispatch.h>
+
+#include <cassert>
+#include <memory_resource>
+#include <vector>
+
+namespace vps::kernels {
+
+namespace {
+
+constexpr std::size_t block = memory::kernel_block;
+
+/// @brief Independent partial sums per block; point i of a block feeds lane i % lanes
+constexpr std::size_t lanes = 8;
+
+/// @brief Streamed chunk for file-backed containers, whole blocks only
+constexpr std::size_t stream_chunk = 64 * block;
+
+/// @brief Sums f, f v and f v^2 of one block, cloned per ISA
+///
+/// Lanes are added pairwise at the end, so the order of additions depends
+/// only on n, never on the thread that runs the block.
+template <std::floating_point T>
+VPS_TARGET_CLONES Moments moments_block(const T* v, const T* f, std::size_t n) noexcept {
+    double m[lanes] = {};
+    double p[lanes] = {};
+    double e[lanes] = {};
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp simd
+#endif
+        for (std::size_t l = 0; l < lanes; ++l) {
+            const double w = static_cast<double>(f[i + l]);
+            const double wu = w * static_cast<double>(v[i + l]);
+            m[l] += w;
+            p[l] += wu;
+            e[l] += wu * static_cast<double>(v[i + l]);
+        }
+    }
+    for (std::size_t l = 0; i + l < n; ++l) {
+        const double w = static_cast<double>(f[i + l]);
+        const double wu = w * static_cast<double>(v[i + l]);
+        m[l] += w;
+        p[l] += wu;
+        e[l] += wu * static_cast<double>(v[i + l]);
+    }
+    for (std::size_t width = lanes / 2; width > 0; width /= 2) {
+        for (std::size_t l = 0; l < width; ++l) {
+            m[l] += m[l + width];
+            p[l] += p[l + width];
+            e[l] += e[l + width];
+        }
+    }
+    return {m[0], p[0], e[0]};
+}
+
+/// @brief Writes the sums of every block of [v, v + n) to out, in parallel
+template <std::floating_point T>
+void block_sums(const T* v, const T* f, std::size_t n, Moments* out) {
+    particles::for_each_block(n, [&](std::size_t first, std::size_t count) {
+        out[first / block] = moments_block(v + first, f + first, count);
+    });
+}
+
+/// @brief Adds sums[0, n) by recursive halving, a tree fixed by n alone
+Moments pairwise(const Moments* sums, std::size_t n) noexcept {
+    if (n == 0) {
+        return {};
+    }
+    if (n == 1) {
+        return sums[0];
+    }
+    const std::size_t half = n / 2;
+    const Moments a = pairwise(sums, half);
+    const Moments b = pairwise(sums + half, n - half);
+    return {a.mass + b.mass, a.momentum + b.momentum, a.energy + b.energy};
+}
+
+/// @brief Final tree over the block sums, with the 1/2 of the kinetic energy
+Moments total(const std::pmr::vector<Moments>& sums) noexcept {
+    Moments result = pairwise(sums.data(), sums.size());
+    result.energy *= 0.5;
+    return result;
+}
+
+} // namespace
+
+// =============================================================================
+// Moments
+// =============================================================================
+
+template <std::floating_point T>
+Moments moments(std::span<const T> v, std::type_identity_t<std::span<const T>> f) {
+    assert(v.size() == f.size() && "Column spans differ in length");
+    std::pmr::vector<Moments> sums((v.size() + block - 1) / block, memory::scratch());
+    block_sums(v.data(), f.data(), v.size(), sums.data());
+    return total(sums);
+}
+
+template <std::floating_point T>
+Moments moments(const particles::BasicParticles<T>& particles) {
+    const auto v = particles.v();
+    const auto f = particles.f();
+    std::pmr::vector<Moments> sums((particles.size() + block - 1) / block, memory::scratch());
+    // Chunks start on block boundaries, so the blocks match the span overload
+    particles.stream([&](std::size_t first, std::size_t last) {
+        assert(first % block == 0);
+        block_sums(v.data() + first, f.data() + first, last - first, sums.data() + first / block);
+    }, stream_chunk);
+    return total(sums);
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template Moments moments(const particles::ParticlesF&);
+template Moments moments(const particles::Particles&);
+
+template Moments moments(std::span<const float>, std::span<const float>);
+template Moments moments(std::span<const double>, std::span<const double>);
+
+} // namespace vps::kernels
@@ -0,0 +1,173 @@
+#include "vps/kernels/push.h"
+
+#include <vps/particles/dispatch.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <span>
+
+namespace vps::kernels {
+
+namespace {
+
+/// @brief Push and single-period wrap of one block, cloned per ISA
+/// @return Number of points still outside [lo, hi)
+template <std::floating_point T>
+VPS_TARGET_CLONES std::size_t stream_wrap_block(T* x, const T* v, std::size_t n, T dt, T lo,
+                                                T hi, T length) noexcept {
+    std::size_t outside = 0;
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd reduction(+ : outside)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        T xn = x[i] + v[i] * dt;
+        xn -= xn >= hi ? length : T{0};
+        xn += xn < lo ? length : T{0};
+        outside += static_cast<std::size_t>((xn < lo) | (xn >= hi));
+        x[i] = xn;
+    }
+    return outside;
+}
+
+/// @brief Push by time t and wrap any number of periods, cloned per ISA
+/// @return Number of points still outside [lo, hi) after rounding
+template <std::floating_point T>
+VPS_TARGET_CLONES std::size_t drift_wrap_block(T* x, const T* v, std::size_t n, T t, T lo, T hi,
+                                               T length) noexcept {
+    const T inv_length = T{1} / length;
+    std::size_t outside = 0;
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd reduction(+ : outside)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        T xn = x[i] + v[i] * t;
+        xn -= length * std::floor((xn - lo) * inv_length);
+        // The product above may round onto an edge; settle it without a branch
+        xn -= xn >= hi ? length : T{0};
+        xn += xn < lo ? length : T{0};
+        outside += static_cast<std::size_t>((xn < lo) | (xn >= hi));
+        x[i] = xn;
+    }
+    return outside;
+}
+
+/// @brief Gathers E at n located points and kicks their velocities, cloned per ISA
+template <std::floating_point T, std::floating_point A>
+VPS_TARGET_CLONES void kick_block(const A* e, std::uint32_t last, const std::uint32_t* cell,
+                                  const A* right, T* v, std::size_t n, A qm_dt) noexcept {
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t c = cell[i];
+        const std::uint32_t next = c == last ? 0 : c + 1;
+        const A field = (A{1} - right[i]) * e[c] + right[i] * e[next];
+        v[i] += static_cast<T>(qm_dt * field);
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+template <std::floating_point T>
+std::size_t stream_wrap(std::span<T> x, std::span<const T> v, T dt, T lo, T hi, T length) {
+    T* xs = x.data();
+    const T* vs = v.data();
+    std::atomic<std::size_t> outside{0};
+    particles::for_each_block(x.size(), [&](std::size_t first, std::size_t count) {
+        outside.fetch_add(stream_wrap_block(xs + first, vs + first, count, dt, lo, hi, length),
+                          std::memory_order_relaxed);
+    });
+    return outside.load(std::memory_order_relaxed);
+}
+
+template <std::floating_point T>
+std::size_t drift_wrap(std::span<T> x, std::span<const T> v, T t, T lo, T hi, T length) {
+    T* xs = x.data();
+    const T* vs = v.data();
+    std::atomic<std::size_t> outside{0};
+    particles::for_each_block(x.size(), [&](std::size_t first, std::size_t count) {
+        outside.fetch_add(drift_wrap_block(xs + first, vs + first, count, t, lo, hi, length),
+                          std::memory_order_relaxed);
+    });
+    return outside.load(std::memory_order_relaxed);
+}
+
+template <std::floating_point T, std::floating_point A>
+void kick_located(const A* e, std::uint32_t last, const std::uint32_t* cell, const A* right,
+                  T* v, std::size_t n, A qm_dt) noexcept {
+    kick_block(e, last, cell, right, v, n, qm_dt);
+}
+
+template std::size_t stream_wrap(std::span<float>, std::span<const float>, float, float, float,
+                                 float);
+template std::size_t stream_wrap(std::span<double>, std::span<const double>, double, double,
+                                 double, double);
+
+template std::size_t drift_wrap(std::span<float>, std::span<const float>, float, float, float,
+                                float);
+template std::size_t drift_wrap(std::span<double>, std::span<const double>, double, double,
+                                double, double);
+
+template void kick_located(const float*, std::uint32_t, const std::uint32_t*, const float*,
+                           float*, std::size_t, float) noexcept;
+template void kick_located(const double*, std::uint32_t, const std::uint32_t*, const double*,
+                           float*, std::size_t, double) noexcept;
+template void kick_located(const float*, std::uint32_t, const std::uint32_t*, const float*,
+                           double*, std::size_t, float) noexcept;
+template void kick_located(const double*, std::uint32_t, const std::uint32_t*, const double*,
+                           double*, std::size_t, double) noexcept;
+
+} // namespace detail
+
+template <std::floating_point T, std::floating_point A>
+void kick(std::span<const T> x, std::span<T> v, const grid::BasicField<A>& E,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt) {
+    kick(x, v, E, E.grid(), q_over_m, dt);
+}
+
+template <std::floating_point T, std::floating_point A>
+void kick(particles::BasicParticles<T>& particles, const grid::BasicField<A>& E,
+          std::type_identity_t<T> q_over_m, std::type_identity_t<T> dt) {
+    kick(particles, E, E.grid(), q_over_m, dt);
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template std::size_t stream_and_wrap(particles::BasicParticles<float>&,
+                                     const grid::BasicGrid<float>&, float);
+template std::size_t stream_and_wrap(particles::BasicParticles<double>&,
+                                     const grid::BasicGrid<double>&, double);
+
+template std::size_t stream_and_wrap(std::span<float>, std::span<const float>,
+                                     const grid::BasicGrid<float>&, float);
+template std::size_t stream_and_wrap(std::span<double>, std::span<const double>,
+                                     const grid::BasicGrid<double>&, double);
+
+template std::size_t fast_forward(particles::BasicParticles<float>&,
+                                  const grid::BasicGrid<float>&, float, std::size_t);
+template std::size_t fast_forward(particles::BasicParticles<double>&,
+                                  const grid::BasicGrid<double>&, double, std::size_t);
+
+template std::size_t fast_forward(std::span<float>, std::span<const float>,
+                                  const grid::BasicGrid<float>&, float, std::size_t);
+template std::size_t fast_forward(std::span<double>, std::span<const double>,
+                                  const grid::BasicGrid<double>&, double, std::size_t);
+
+template void kick(particles::ParticlesF&, const grid::FieldF&, float, float);
+template void kick(particles::ParticlesF&, const grid::Field&, float, float);
+template void kick(particles::Particles&, const grid::FieldF&, double, double);
+template void kick(particles::Particles&, const grid::Field&, double, double);
+
+template void kick(std::span<const float>, std::span<float>, const grid::FieldF&, float, float);
+template void kick(std::span<const float>, std::span<float>, const grid::Field&, float, float);
+template void kick(std::span<const double>, std::span<double>, const grid::FieldF&, double,
+                   double);
+template void kick(std::span<const double>, std::span<double>, const grid::Field&, double,
+                   double);
+
+} // namespace vps::kernels
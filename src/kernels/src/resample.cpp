@@ -0,0 +1,284 @@
+#include "vps/kernels/resample.h"
+
+#include <vps/memory/arena.h>
+#include <vps/particles/dispatch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vps::kernels {
+
+namespace {
+
+/// @brief Weight and moments of one bin, accumulated in double
+struct BinMoments {
+    double w = 0.0;    ///< Sum of weights
+    double wx = 0.0;   ///< Sum of w * x (wrapped positions)
+    double wv = 0.0;   ///< Sum of w * v
+    double wvv = 0.0;  ///< Sum of w * v^2
+};
+
+/// @brief Half the distance from x to the nearer edge of its cell
+template <std::floating_point T>
+T half_gap(const grid::BasicGrid<T>& grid, T x) noexcept {
+    const auto c = grid.cell_index(x);
+    return std::min(x - grid.cell_left(c), grid.cell_right(c) - x) / T{2};
+}
+
+} // namespace
+
+template <std::floating_point T>
+ResampleStats resample(particles::BasicParticles<T>& particles, const grid::BasicGrid<T>& grid,
+                       const ResampleConfig& config) {
+    if (config.velocity_bins == 0) {
+        throw std::invalid_argument("Resampling needs at least one velocity bin");
+    }
+    if (config.merge_weight < 0.0 || config.split_weight < 0.0 || config.steep_gradient < 0.0) {
+        throw std::invalid_argument("Resampling thresholds must be non-negative");
+    }
+
+    const std::size_t n = particles.size();
+    if (n == 0) {
+        return {};
+    }
+    const std::size_t budget = config.max_points > 0 ? config.max_points : n;
+    const std::size_t n_vbins = config.velocity_bins;
+    const std::size_t n_bins = grid.n_cells() * n_vbins;
+    const auto x = particles.x();
+    const auto v = particles.v();
+    const auto f = particles.f();
+
+    // =========================================================================
+    // Bin points by (cell, velocity bin)
+    // =========================================================================
+
+    double v_min = std::numeric_limits<double>::max();
+    double v_max = std::numeric_limits<double>::lowest();
+    double total_weight = 0.0;
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp parallel for schedule(static) reduction(min : v_min) reduction(max : v_max) \
+        reduction(+ : total_weight) if (particles::run_parallel(n)) \
+        num_threads(static_cast<int>(particles::team_size(n)))
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        v_min = std::min(v_min, static_cast<double>(v[i]));
+        v_max = std::max(v_max, static_cast<double>(v[i]));
+        total_weight += static_cast<double>(f[i]);
+    }
+    const double inv_bin_width =
+        v_max > v_min ? static_cast<double>(n_vbins) / (v_max - v_min) : 0.0;
+
+    std::pmr::vector<std::size_t> keys(n, memory::scratch());
+    particles::for_each_block(n, [&](std::size_t first, std::size_t count) {
+        for (std::size_t i = first; i < first + count; ++i) {
+            const auto vbin = std::min(
+                n_vbins - 1,
+                static_cast<std::size_t>((static_cast<double>(v[i]) - v_min) * inv_bin_width));
+            keys[i] = grid.cell_index(x[i]) * n_vbins + vbin;
+        }
+    });
+
+    // Counting sort: bin b owns order[start[b] .. start[b + 1])
+    std::pmr::vector<std::size_t> start(n_bins + 1, 0, memory::scratch());
+    for (std::size_t i = 0; i < n; ++i) {
+        ++start[keys[i] + 1];
+    }
+    for (std::size_t b = 0; b < n_bins; ++b) {
+        start[b + 1] += start[b];
+    }
+    std::pmr::vector<std::size_t> order(n, memory::scratch());
+    {
+        std::pmr::vector<std::size_t> cursor(start.begin(), start.end() - 1, memory::scratch());
+        for (std::size_t i = 0; i < n; ++i) {
+            order[cursor[keys[i]]++] = i;
+        }
+    }
+
+    const std::size_t bin_points = n / n_bins;  // per-index work for the bin sweeps
+    std::pmr::vector<BinMoments> moments(n_bins, memory::scratch());
+    particles::parallel_for(n_bins, [&](std::size_t b) {
+        BinMoments m;
+        for (std::size_t k = start[b]; k < start[b + 1]; ++k) {
+            const std::size_t i = order[k];
+            const double w = static_cast<double>(f[i]);
+            const double vi = static_cast<double>(v[i]);
+            m.w += w;
+            m.wx += w * static_cast<double>(grid.wrap_position(x[i]));
+            m.wv += w * vi;
+            m.wvv += w * vi * vi;
+        }
+        moments[b] = m;
+    }, bin_points);
+
+    // =========================================================================
+    // Choose bins to merge
+    // =========================================================================
+
+    const double mean_weight = total_weight / static_cast<double>(n);
+    const auto bin_size = [&](std::size_t b) { return start[b + 1] - start[b]; };
+    const auto bin_mean = [&](std::size_t b) {
+        return moments[b].w / static_cast<double>(bin_size(b));
+    };
+
+    ResampleStats stats;
+    std::pmr::vector<std::uint8_t> merge(n_bins, 0, memory::scratch());
+    std::pmr::vector<std::size_t> optional(memory::scratch());
+    std::size_t count = n;
+    const auto merge_bin = [&](std::size_t b) {
+        merge[b] = 1;
+        ++stats.merged_bins;
+        stats.removed += bin_size(b) - 2;
+        count -= bin_size(b) - 2;
+    };
+
+    for (std::size_t b = 0; b < n_bins; ++b) {
+        // Merging needs something to gain (k >= 3) and a positive weight to place
+        if (bin_size(b) < 3 || moments[b].w <= 0.0) {
+            continue;
+        }
+        if (bin_mean(b) < config.merge_weight * mean_weight) {
+            merge_bin(b);
+        } else {
+            optional.push_back(b);
+        }
+    }
+    if (count > budget) {
+        std::sort(optional.begin(), optional.end(),
+                  [&](std::size_t a, std::size_t b) { return bin_mean(a) < bin_mean(b); });
+        for (const std::size_t b : optional) {
+            if (count <= budget) {
+                break;
+            }
+            merge_bin(b);
+        }
+    }
+
+    // =========================================================================
+    // Choose points to split
+    // =========================================================================
+
+    std::pmr::vector<std::uint8_t> split(n, 0, memory::scratch());
+    if (count < budget) {
+        std::pmr::vector<double> rho(grid.n_cells(), 0.0, memory::scratch());
+        for (std::size_t b = 0; b < n_bins; ++b) {
+            rho[b / n_vbins] += moments[b].w;
+        }
+
+        std::pmr::vector<std::size_t> candidates(memory::scratch());
+        for (std::size_t c = 0; c < grid.n_cells(); ++c) {
+            const double left = rho[grid.wrap_index(static_cast<std::ptrdiff_t>(c) - 1)];
+            const double right = rho[grid.wrap_index(static_cast<std::ptrdiff_t>(c) + 1)];
+            const double sum = left + right;
+            if (sum <= 0.0 || std::abs(right - left) < config.steep_gradient * sum) {
+                continue;
+            }
+            for (std::size_t b = c * n_vbins; b < (c + 1) * n_vbins; ++b) {
+                if (merge[b] != 0) {
+                    continue;
+                }
+                for (std::size_t k = start[b]; k < start[b + 1]; ++k) {
+                    const std::size_t i = order[k];
+                    if (static_cast<double>(f[i]) > config.split_weight * mean_weight &&
+                        half_gap(grid, grid.wrap_position(x[i])) > T{0}) {
+                        candidates.push_back(i);
+                    }
+                }
+            }
+        }
+
+        // Within the budget, split the heaviest candidates
+        const std::size_t room = budget - count;
+        if (candidates.size() > room) {
+            std::nth_element(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(room),
+                             candidates.end(),
+                             [&](std::size_t a, std::size_t b) { return f[a] > f[b]; });
+            candidates.resize(room);
+        }
+        for (const std::size_t i : candidates) {
+            split[i] = 1;
+        }
+        stats.split = candidates.size();
+        count += candidates.size();
+    }
+
+    // =========================================================================
+    // Write the resampled set bin by bin
+    // =========================================================================
+
+    std::pmr::vector<std::size_t> out_start(n_bins + 1, 0, memory::scratch());
+    particles::parallel_for(n_bins, [&](std::size_t b) {
+        std::size_t produced = 2;
+        if (merge[b] == 0) {
+            produced = 0;
+            for (std::size_t k = start[b]; k < start[b + 1]; ++k) {
+                produced += std::size_t{1} + split[order[k]];
+            }
+        }
+        out_start[b + 1] = produced;
+    }, bin_points);
+    for (std::size_t b = 0; b < n_bins; ++b) {
+        out_start[b + 1] += out_start[b];
+    }
+
+    particles::BasicParticles<T> out(count, particles.allocation_policy());
+    out.resize_uninitialized(count);
+    T* xs = out.x_data();
+    T* vs = out.v_data();
+    T* fs = out.f_data();
+
+    particles::parallel_for(n_bins, [&](std::size_t b) {
+        std::size_t o = out_start[b];
+        if (merge[b] != 0) {
+            // Two half-weight points at the mean position, V -/+ spread
+            const BinMoments& m = moments[b];
+            const double mean_x = m.wx / m.w;
+            const double mean_v = m.wv / m.w;
+            const double spread = std::sqrt(std::max(0.0, m.wvv / m.w - mean_v * mean_v));
+            for (const double sign : {-1.0, 1.0}) {
+                xs[o] = static_cast<T>(mean_x);
+                vs[o] = static_cast<T>(mean_v + sign * spread);
+                fs[o] = static_cast<T>(m.w / 2.0);
+                ++o;
+            }
+            return;
+        }
+        for (std::size_t k = start[b]; k < start[b + 1]; ++k) {
+            const std::size_t i = order[k];
+            if (split[i] != 0) {
+                // Two half-weight copies, symmetric in x inside the cell
+                const T xi = grid.wrap_position(x[i]);
+                const T d = half_gap(grid, xi);
+                for (const T shift : {-d, d}) {
+                    xs[o] = xi + shift;
+                    vs[o] = v[i];
+                    fs[o] = f[i] / T{2};
+                    ++o;
+                }
+            } else {
+                xs[o] = x[i];
+                vs[o] = v[i];
+                fs[o] = f[i];
+                ++o;
+            }
+        }
+    }, bin_points);
+
+    particles = std::move(out);
+    return stats;
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template ResampleStats resample(particles::BasicParticles<float>&, const grid::BasicGrid<float>&,
+                                const ResampleConfig&);
+template ResampleStats resample(particles::BasicParticles<double>&,
+                                const grid::BasicGrid<double>&, const ResampleConfig&);
+
+} // namespace vps::kernels
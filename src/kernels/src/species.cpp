@@ -0,0 +1,220 @@
+#include "vps/kernels/species.h"
+
+#include <vps/kernels/push.h>
+#include <vps/memory/arena.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace vps::kernels {
+
+namespace {
+
+/// @brief Adds charge q f / dx of n points to their nearest cells in row
+template <std::floating_point T, std::floating_point A>
+void scatter_ngp(const grid::BasicGrid<A>& grid, A* row, const T* x, const T* f, std::size_t n,
+                 A q_inv_dx) {
+    std::array<std::uint32_t, memory::kernel_block> cell;
+    grid.cell_indices(std::span(x, n), std::span(cell.data(), n));
+    for (std::size_t p = 0; p < n; ++p) {
+        row[cell[p]] += static_cast<A>(f[p]) * q_inv_dx;
+    }
+}
+
+/// @brief Splits charge q f / dx of n points between their two cells in row
+template <std::floating_point T, std::floating_point A>
+void scatter_cic(const grid::BasicGrid<A>& grid, A* row, const T* x, const T* f, std::size_t n,
+                 A q_inv_dx) {
+    std::array<std::uint32_t, memory::kernel_block> cell;
+    std::array<A, memory::kernel_block> right;
+    grid.interpolation_weights(std::span(x, n), std::span(cell.data(), n),
+                               std::span(right.data(), n));
+    for (std::size_t p = 0; p < n; ++p) {
+        const A w = static_cast<A>(f[p]) * q_inv_dx;
+        const auto idx_next = grid.wrap_index(static_cast<std::ptrdiff_t>(cell[p]) + 1);
+        row[cell[p]] += (A{1} - right[p]) * w;
+        row[idx_next] += right[p] * w;
+    }
+}
+
+/// @brief Deposits every species into per-thread rows in one sweep, then sums them into rho
+template <std::floating_point T, std::floating_point A, typename Scatter>
+void deposit_species(const BasicSpeciesSet<T>& set, grid::BasicField<A>& rho, Scatter scatter) {
+    const auto& grid = rho.grid();
+    const std::size_t n_cells = grid.n_cells();
+    const std::size_t n_rows = particles::team_size(set.total_points());
+    const A inv_dx = A{1} / grid.dx();
+
+    // Row r holds share r of the blocks, filled in block order by one thread,
+    // so the scatter needs no atomics and the sums do not depend on timing
+    std::pmr::vector<A> rows(n_rows * n_cells, A{0}, memory::scratch());
+    set.for_each_share(n_rows, [&](std::size_t r, const BasicSpecies<T>& species,
+                                   std::size_t first, std::size_t count) {
+        const A q_inv_dx = static_cast<A>(species.charge) * inv_dx;
+        scatter(grid, rows.data() + r * n_cells, species.particles.x().data() + first,
+                species.particles.f().data() + first, count, q_inv_dx);
+    });
+
+    // Rows are summed in share order
+    particles::parallel_for(n_cells, [&](std::size_t c) {
+        A sum = A{0};
+        for (std::size_t t = 0; t < n_rows; ++t) {
+            sum += rows[t * n_cells + c];
+        }
+        rho[c] += sum;
+    }, n_rows);
+}
+
+} // namespace
+
+// =============================================================================
+// BasicSpeciesSet
+// =============================================================================
+
+template <std::floating_point T>
+BasicSpeciesSet<T>::BasicSpeciesSet(const grid_type& grid)
+    : grid_(&grid)
+{}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::add(std::string name, value_type charge, value_type mass,
+                             particles_type particles) -> species_type& {
+    if (!(mass > value_type{0})) {
+        throw std::invalid_argument("Species mass must be positive");
+    }
+    if (find(name) != nullptr) {
+        throw std::invalid_argument("Species name already in use: " + name);
+    }
+    species_.push_back(species_type{std::move(name), charge, mass, std::move(particles)});
+    return species_.back();
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::size() const noexcept -> size_type {
+    return species_.size();
+}
+
+template <std::floating_point T>
+bool BasicSpeciesSet<T>::empty() const noexcept {
+    return species_.empty();
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::operator[](size_type i) noexcept -> species_type& {
+    return species_[i];
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::operator[](size_type i) const noexcept -> const species_type& {
+    return species_[i];
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::find(std::string_view name) noexcept -> species_type* {
+    for (auto& species : species_) {
+        if (species.name == name) {
+            return &species;
+        }
+    }
+    return nullptr;
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::find(std::string_view name) const noexcept -> const species_type* {
+    for (const auto& species : species_) {
+        if (species.name == name) {
+            return &species;
+        }
+    }
+    return nullptr;
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::total_points() const noexcept -> size_type {
+    size_type total = 0;
+    for (const auto& species : species_) {
+        total += species.particles.size();
+    }
+    return total;
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::grid() const noexcept -> const grid_type& {
+    return *grid_;
+}
+
+template <std::floating_point T>
+auto BasicSpeciesSet<T>::block_offsets() const -> std::pmr::vector<size_type> {
+    constexpr size_type block = memory::kernel_block;
+    std::pmr::vector<size_type> offsets(species_.size() + 1, 0, memory::scratch());
+    for (size_type s = 0; s < species_.size(); ++s) {
+        const size_type n = species_[s].particles.size();
+        offsets[s + 1] = offsets[s] + (n + block - 1) / block;
+    }
+    return offsets;
+}
+
+// =============================================================================
+// Species Kernels
+// =============================================================================
+
+template <std::floating_point T>
+std::size_t stream_and_wrap(BasicSpeciesSet<T>& set, std::type_identity_t<T> dt) {
+    const auto& grid = set.grid();
+    std::atomic<std::size_t> outside{0};
+    set.for_each_block([&](BasicSpecies<T>& species, std::size_t first, std::size_t count) {
+        auto& p = species.particles;
+        outside.fetch_add(stream_and_wrap(p.x().subspan(first, count),
+                                          std::span<const T>(p.v().subspan(first, count)),
+                                          grid, dt),
+                          std::memory_order_relaxed);
+    });
+    return outside.load(std::memory_order_relaxed);
+}
+
+template <std::floating_point T, std::floating_point A>
+void kick(BasicSpeciesSet<T>& set, const grid::BasicField<A>& E, std::type_identity_t<T> dt) {
+    set.for_each_block([&](BasicSpecies<T>& species, std::size_t first, std::size_t count) {
+        auto& p = species.particles;
+        kick(std::span<const T>(p.x().subspan(first, count)), p.v().subspan(first, count), E,
+             species.q_over_m(), dt);
+    });
+}
+
+template <std::floating_point T, std::floating_point A>
+void deposit_charge_ngp(const BasicSpeciesSet<T>& set, grid::BasicField<A>& rho) {
+    deposit_species(set, rho, scatter_ngp<T, A>);
+}
+
+template <std::floating_point T, std::floating_point A>
+void deposit_charge_cic(const BasicSpeciesSet<T>& set, grid::BasicField<A>& rho) {
+    deposit_species(set, rho, scatter_cic<T, A>);
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template class BasicSpeciesSet<float>;
+template class BasicSpeciesSet<double>;
+
+template std::size_t stream_and_wrap(SpeciesSetF&, float);
+template std::size_t stream_and_wrap(SpeciesSet&, double);
+
+template void kick(SpeciesSetF&, const grid::FieldF&, float);
+template void kick(SpeciesSetF&, const grid::Field&, float);
+template void kick(SpeciesSet&, const grid::Field&, double);
+
+template void deposit_charge_ngp(const SpeciesSetF&, grid::FieldF&);
+template void deposit_charge_ngp(const SpeciesSetF&, grid::Field&);
+template void deposit_charge_ngp(const SpeciesSet&, grid::Field&);
+
+template void deposit_charge_cic(const SpeciesSetF&, grid::FieldF&);
+template void deposit_charge_cic(const SpeciesSetF&, grid::Field&);
+template void deposit_charge_cic(const SpeciesSet&, grid::Field&);
+
+} // namespace vps::kernels
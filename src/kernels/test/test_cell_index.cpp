@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <vps/kernels/cell_index.h>
+#include <vps/kernels/deposit.h>
+#include <vps/memory/arena.h>
+#include <vps/memory/isa.h>
+#include <vps/particles/dispatch.h>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace vps::kernels::test {
+
+namespace {
+
+/// Checks that every point lies in the cell its offsets range claims
+template <typename Index, typename P>
+void expect_sorted(const Index& index, const P& p) {
+    const auto offsets = index.offsets();
+    const auto& g = index.grid();
+    ASSERT_EQ(offsets.size(), g.n_cells() + 1);
+    ASSERT_EQ(offsets.back(), p.size());
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i) {
+            EXPECT_EQ(g.cell_index(p.x(i)), c) << "point " << i;
+        }
+    }
+}
+
+/// Velocity-major order: consecutive points sit in different cells
+particles::Particles make_scattered(const grid::Grid& g, std::size_t per_cell) {
+    particles::Particles p;
+    for (std::size_t j = 0; j < per_cell; ++j) {
+        for (std::size_t c = g.n_cells(); c-- > 0;) {
+            const double x = g.cell_left(c) + (0.1 + 0.8 * static_cast<double>(j) /
+                                                          static_cast<double>(per_cell)) * g.dx();
+            p.push_back(x, 0.1 * static_cast<double>(j) - 0.3, static_cast<double>(c * 100 + j));
+        }
+    }
+    return p;
+}
+
+} // namespace
+
+// =============================================================================
+// Full Sort Tests
+// =============================================================================
+
+TEST(CellIndexTest, SortGroupsByCell) {
+    grid::Grid g(16, 0.0, 1.0);
+    auto p = make_scattered(g, 5);
+    CellIndex index(g);
+
+    index.sort(p);
+
+    expect_sorted(index, p);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        EXPECT_EQ(index.count(c), 5);
+    }
+}
+
+TEST(CellIndexTest, SortIsStableAndKeepsColumnsTogether) {
+    grid::Grid g(4, 0.0, 4.0);
+    particles::Particles p;
+    p.push_back(3.5, 1.0, 30.0);
+    p.push_back(0.5, 2.0, 0.0);
+    p.push_back(3.2, 3.0, 31.0);
+    p.push_back(0.7, 4.0, 1.0);
+    CellIndex index(g);
+
+    index.sort(p);
+
+    EXPECT_DOUBLE_EQ(p.x(0), 0.5);
+    EXPECT_DOUBLE_EQ(p.v(0), 2.0);
+    EXPECT_DOUBLE_EQ(p.x(1), 0.7);  // stable: original order within cell 0
+    EXPECT_DOUBLE_EQ(p.f(2), 30.0);
+    EXPECT_DOUBLE_EQ(p.v(3), 3.0);
+    EXPECT_EQ(index.count(1), 0);
+    EXPECT_EQ(index.count(3), 2);
+}
+
+TEST(CellIndexTest, SortPlacesPointsOutsideDomain) {
+    // Spans several dispatch blocks; some points lie periods away from the domain
+    grid::Grid g(24, -1.0, 2.0);
+    particles::Particles p;
+    for (std::size_t i = 0; i < 3 * memory::kernel_block; ++i) {
+        const double x = -7.0 + 0.0013 * static_cast<double>(i);
+        p.push_back(x, 0.0, static_cast<double>(i));
+    }
+
+    CellIndex index(g);
+    index.sort(p);
+
+    expect_sorted(index, p);
+}
+
+TEST(CellIndexTest, SortPermutesInPlaceAcrossShares) {
+    // Small grain: with several threads the histogram and scatter split into shares
+    const std::size_t grain = particles::parallel_grain();
+    particles::set_parallel_grain(memory::kernel_block);
+    grid::Grid g(16, 0.0, 1.0);
+    auto p = make_scattered(g, 2 * memory::kernel_block / 16 + 3);
+    const double* x = p.x().data();
+    CellIndex index(g);
+
+    index.sort(p);
+
+    particles::set_parallel_grain(grain);
+    EXPECT_EQ(p.x().data(), x);  // no second container swapped in
+    expect_sorted(index, p);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        for (std::size_t i = index.offsets()[c] + 1; i < index.offsets()[c + 1]; ++i) {
+            ASSERT_LT(p.f(i - 1), p.f(i));  // stable: weights rise within a cell
+        }
+    }
+}
+
+TEST(CellIndexTest, SortEmpty) {
+    grid::Grid g(4, 0.0, 1.0);
+    particles::Particles p;
+    CellIndex index(g);
+    index.sort(p);
+    EXPECT_EQ(index.offsets().back(), 0);
+}
+
+// =============================================================================
+// Incremental Re-sort Tests
+// =============================================================================
+
+TEST(CellIndexTest, ResortWithoutMotionIsNoOp) {
+    grid::Grid g(8, 0.0, 1.0);
+    auto p = make_scattered(g, 4);
+    CellIndex index(g);
+    index.sort(p);
+    const double* before = p.x_data();
+
+    EXPECT_FALSE(index.resort(p));
+    EXPECT_EQ(p.x_data(), before);
+}
+
+TEST(CellIndexTest, ResortTracksStreaming) {
+    grid::Grid g(32, 0.0, 1.0);
+    auto p = make_scattered(g, 8);
+    CellIndex index(g);
+    index.sort(p);
+
+    for (int step = 0; step < 20; ++step) {
+        particles::advance_positions(p, 0.01);
+        for (auto& x : p.x()) {
+            x = g.wrap_position(x);
+        }
+        index.resort(p);
+        expect_sorted(index, p);
+    }
+}
+
+TEST(CellIndexTest, ResortDrawsScratchFromStepArena) {
+    grid::Grid g(32, 0.0, 1.0);
+    auto p = make_scattered(g, 8);
+    CellIndex index(g);
+    index.sort(p);
+
+    memory::StepArena arena;
+    memory::ScratchScope scope(arena);
+    std::size_t warm = 0;
+    for (int step = 0; step < 20; ++step) {
+        arena.reset();
+        if (step == 2) {
+            warm = arena.upstream_allocations();
+        }
+        particles::advance_positions(p, 0.01);
+        for (auto& x : p.x()) {
+            x = g.wrap_position(x);
+        }
+        index.resort(p);
+    }
+
+    EXPECT_GT(warm, 0u);
+    EXPECT_EQ(arena.upstream_allocations(), warm);
+    expect_sorted(index, p);
+}
+
+TEST(CellIndexTest, ResortMatchesFullSortDeposit) {
+    grid::Grid g(16, 0.0, 1.0);
+    auto p = make_scattered(g, 6);
+    CellIndex index(g);
+    index.sort(p);
+
+    particles::advance_positions(p, 0.02);
+    for (auto& x : p.x()) {
+        x = g.wrap_position(x);
+    }
+    grid::Field before(g);
+    deposit_ngp(p, before);
+
+    index.resort(p);
+    grid::Field after(g);
+    deposit_ngp(p, after);
+
+    // Reordering never changes which cell a point deposits into
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        EXPECT_NEAR(after[c], before[c], 1e-9);
+    }
+}
+
+TEST(CellIndexTest, ResortAfterResizeFallsBackToSort) {
+    grid::Grid g(8, 0.0, 1.0);
+    auto p = make_scattered(g, 2);
+    CellIndex index(g);
+    index.sort(p);
+
+    p.push_back(0.95, 0.0, 1.0);
+    EXPECT_TRUE(index.resort(p));
+    expect_sorted(index, p);
+}
+
+// =============================================================================
+// Frequency Tests
+// =============================================================================
+
+TEST(CellIndexTest, StepHonoursInterval) {
+    grid::Grid g(8, 0.0, 1.0);
+    auto p = make_scattered(g, 2);
+    CellIndex index(g, 3);
+    index.sort(p);
+
+    EXPECT_FALSE(index.step(p));
+    EXPECT_FALSE(index.step(p));
+    EXPECT_TRUE(index.step(p));
+    EXPECT_FALSE(index.step(p));
+
+    index.set_sort_interval(1);
+    EXPECT_EQ(index.sort_interval(), 1);
+    EXPECT_TRUE(index.step(p));
+}
+
+TEST(CellIndexTest, ZeroIntervalThrows) {
+    grid::Grid g(8, 0.0, 1.0);
+    EXPECT_THROW(CellIndex(g, 0), std::invalid_argument);
+    CellIndex index(g);
+    EXPECT_THROW(index.set_sort_interval(0), std::invalid_argument);
+}
+
+TEST(CellIndexFTest, SortFloat) {
+    grid::GridF g(8, 0.0f, 1.0f);
+    particles::ParticlesF p;
+    for (int i = 0; i < 64; ++i) {
+        p.push_back(static_cast<float>((i * 37) % 64) / 64.0f, 0.0f, 1.0f);
+    }
+    CellIndexF index(g);
+
+    index.sort(p);
+
+    expect_sorted(index, p);
+}
+
+} // namespace vps::kernels::test
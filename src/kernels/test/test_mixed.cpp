@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <vps/kernels/mixed.h>
+
+namespace vps::kernels::test {
+
+// =============================================================================
+// Conversion Tests
+// =============================================================================
+
+TEST(MixedTest, RoundTripPosition) {
+    grid::Grid g(10, -1.0, 1.0);  // dx = 0.2
+    particles::Particles p;
+    p.push_back(0.33, 1.5, 0.25);
+    p.push_back(-0.95, -2.0, 0.5);
+
+    const auto m = to_mixed(p, g);
+
+    ASSERT_EQ(m.size(), 2);
+    EXPECT_EQ(m.cell()[0], 6);
+    EXPECT_NEAR(position(m, 0, g), 0.33, 1e-7);
+    EXPECT_NEAR(position(m, 1, g), -0.95, 1e-7);
+    EXPECT_FLOAT_EQ(m.v()[1], -2.0f);
+    EXPECT_FLOAT_EQ(m.f()[0], 0.25f);
+}
+
+TEST(MixedTest, ToMixedWrapsPositions) {
+    grid::Grid g(4, 0.0, 4.0);
+    particles::Particles p;
+    p.push_back(5.25, 0.0, 1.0);
+
+    const auto m = to_mixed(p, g);
+
+    EXPECT_EQ(m.cell()[0], 1);
+    EXPECT_FLOAT_EQ(m.offset()[0], 0.25f);
+}
+
+// =============================================================================
+// Free Streaming Tests
+// =============================================================================
+
+TEST(MixedTest, AdvanceWithinCell) {
+    grid::Grid g(4, 0.0, 4.0);
+    particles::MixedParticles m;
+    m.push_back(1, 0.25f, 1.0f, 1.0f);
+
+    advance_positions(m, g, 0.5);
+
+    EXPECT_EQ(m.cell()[0], 1);
+    EXPECT_FLOAT_EQ(m.offset()[0], 0.75f);
+}
+
+TEST(MixedTest, AdvanceAcrossCellsAndWrap) {
+    grid::Grid g(4, 0.0, 4.0);
+    particles::MixedParticles m;
+    m.push_back(3, 0.5f, 1.0f, 1.0f);   // 3.5 -> 5.0 -> wraps to 1.0
+    m.push_back(0, 0.25f, -1.0f, 1.0f); // 0.25 -> -0.25 -> wraps to 3.75
+
+    advance_positions(m, g, 1.5);
+    advance_positions(m, g, 0.0);
+
+    EXPECT_EQ(m.cell()[0], 1);
+    EXPECT_FLOAT_EQ(m.offset()[0], 0.0f);
+    EXPECT_EQ(m.cell()[1], 2);
+    EXPECT_FLOAT_EQ(m.offset()[1], 0.75f);
+}
+
+TEST(MixedTest, MatchesDoubleStreaming) {
+    grid::Grid g(32, 0.0, 6.0);
+    particles::Particles p;
+    for (int i = 0; i < 64; ++i) {
+        p.push_back(0.09 * i, 0.37 * (i % 7) - 1.0, 1.0);
+    }
+    auto m = to_mixed(p, g);
+
+    for (int step = 0; step < 100; ++step) {
+        particles::advance_positions(p, 0.05);
+        advance_positions(m, g, 0.05);
+    }
+
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        EXPECT_NEAR(position(m, i, g), g.wrap_position(p.x(i)), 1e-4);
+    }
+}
+
+} // namespace vps::kernels::test
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <vps/kernels/moments.h>
+#include <vps/particles/dispatch.h>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef VPS_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace vps::kernels::test {
+
+namespace {
+
+/// @brief Points with weights and velocities spread over many magnitudes
+particles::Particles scattered(std::size_t n) {
+    particles::Particles p;
+    p.fill_with(n, [](std::size_t i) {
+        const double s = std::sin(static_cast<double>(i) * 0.7071);
+        const double w = std::exp(8.0 * std::cos(static_cast<double>(i) * 1.3));
+        return std::array{0.0, 3.0 * s, w};
+    });
+    return p;
+}
+
+bool same_bits(const Moments& a, const Moments& b) {
+    return std::bit_cast<std::uint64_t>(a.mass) == std::bit_cast<std::uint64_t>(b.mass) &&
+           std::bit_cast<std::uint64_t>(a.momentum) == std::bit_cast<std::uint64_t>(b.momentum) &&
+           std::bit_cast<std::uint64_t>(a.energy) == std::bit_cast<std::uint64_t>(b.energy);
+}
+
+} // namespace
+
+// =============================================================================
+// Moment Reduction Tests
+// =============================================================================
+
+TEST(MomentsTest, EmptyIsZero) {
+    const particles::Particles p;
+    const Moments m = moments(p);
+    EXPECT_EQ(m.mass, 0.0);
+    EXPECT_EQ(m.momentum, 0.0);
+    EXPECT_EQ(m.energy, 0.0);
+}
+
+TEST(MomentsTest, MatchesExactSums) {
+    // Small integers: every partial sum is exact, so any tree gives the same value
+    const std::size_t n = 3 * memory::kernel_block + 5;
+    particles::Particles p;
+    p.fill_with(n, [](std::size_t i) {
+        return std::array{0.0, static_cast<double>(i % 5) - 2.0, static_cast<double>(1 + i % 3)};
+    });
+    double mass = 0.0;
+    double momentum = 0.0;
+    double energy = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        mass += p.f(i);
+        momentum += p.f(i) * p.v(i);
+        energy += 0.5 * p.f(i) * p.v(i) * p.v(i);
+    }
+    const Moments m = moments(p);
+    EXPECT_EQ(m.mass, mass);
+    EXPECT_EQ(m.momentum, momentum);
+    EXPECT_EQ(m.energy, energy);
+}
+
+TEST(MomentsTest, BitwiseIdenticalForAnyTeam) {
+    const auto p = scattered(7 * memory::kernel_block + 321);
+    const std::size_t saved = particles::parallel_grain();
+
+    particles::set_parallel_grain(std::size_t{1} << 40);  // serial
+    const Moments serial = moments(p);
+
+    particles::set_parallel_grain(1);
+#ifdef VPS_ENABLE_OPENMP
+    const int saved_threads = omp_get_max_threads();
+    for (const int threads : {1, 2, 3, 5}) {
+        omp_set_num_threads(threads);
+        EXPECT_TRUE(same_bits(moments(p), serial)) << threads << " threads";
+    }
+    omp_set_num_threads(saved_threads);
+#else
+    EXPECT_TRUE(same_bits(moments(p), serial));
+#endif
+    particles::set_parallel_grain(saved);
+}
+
+TEST(MomentsTest, SpanOverloadMatchesContainer) {
+    const auto p = scattered(2 * memory::kernel_block + 17);
+    EXPECT_TRUE(same_bits(moments(std::span<const double>(p.v()), std::span<const double>(p.f())),
+                          moments(p)));
+}
+
+TEST(MomentsTest, PairwiseStaysAccurate) {
+    // A million equal terms: a running float-sized sum would lose digits,
+    // the pairwise tree keeps the result to a few ulps
+    const std::size_t n = 1u << 20;
+    particles::ParticlesF p;
+    p.fill_with(n, [](std::size_t) { return std::array{0.0f, 0.1f, 0.1f}; });
+    const Moments m = moments(p);
+    const double w = static_cast<double>(0.1f);
+    EXPECT_NEAR(m.mass, static_cast<double>(n) * w, 1e-12 * static_cast<double>(n) * w);
+    EXPECT_NEAR(m.momentum, static_cast<double>(n) * w * w, 1e-12 * static_cast<double>(n) * w * w);
+    EXPECT_NEAR(m.energy, 0.5 * static_cast<double>(n) * w * w * w,
+                1e-12 * static_cast<double>(n) * w * w * w);
+}
+
+} // namespace vps::kernels::test
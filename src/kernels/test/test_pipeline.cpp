@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <vps/kernels/deposit.h>
+#include <vps/kernels/pipeline.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace vps::kernels::test {
+
+namespace {
+
+particles::Particles make_particles(std::size_t n) {
+    particles::Particles p;
+    p.fill_with(n, [n](std::size_t i) {
+        const double s = static_cast<double>((i * 2654435761u) % n) / static_cast<double>(n);
+        return std::array{s, 0.3 - 0.6 * s, 1.0 + s};
+    });
+    return p;
+}
+
+} // namespace
+
+// =============================================================================
+// Composition Tests
+// =============================================================================
+
+TEST(PipelineTest, ComposesStagesInOrder) {
+    grid::Grid g(8, 0.0, 1.0);
+    grid::Field rho(g);
+    auto step = stage::push(0.1) | stage::wrap(g) | stage::index(g) | stage::deposit_ngp(rho);
+
+    EXPECT_EQ(std::tuple_size_v<std::remove_cvref_t<decltype(step.stages())>>, 4u);
+}
+
+TEST(PipelineTest, PipelinesConcatenate) {
+    grid::Grid g(8, 0.0, 1.0);
+    auto move = stage::push(0.1) | stage::wrap(g);
+    auto kick = stage::accelerate(1.0, 0.1) | stage::push(0.0);
+    auto both = std::move(move) | std::move(kick);
+
+    EXPECT_EQ(std::tuple_size_v<std::remove_cvref_t<decltype(both.stages())>>, 4u);
+}
+
+// =============================================================================
+// Equivalence Tests
+// =============================================================================
+
+TEST(PipelineTest, MatchesSeparatePasses) {
+    grid::Grid g(32, 0.0, 1.0);
+    auto fused = make_particles(10'001);
+    auto separate = fused;
+
+    grid::Field rho_fused(g), rho_separate(g);
+    auto step = stage::push(0.05) | stage::wrap(g) | stage::index(g) | stage::deposit_cic(rho_fused);
+    step.run(fused, 1000);  // many chunks, last one partial
+
+    particles::advance_positions(separate, 0.05);
+    for (auto& x : separate.x()) {
+        x = g.wrap_position(x);
+    }
+    deposit_cic(separate, rho_separate);
+
+    for (std::size_t i = 0; i < fused.size(); ++i) {
+        ASSERT_DOUBLE_EQ(fused.x(i), separate.x(i));
+    }
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        EXPECT_NEAR(rho_fused[c], rho_separate[c], 1e-9 * rho_separate[c]);
+    }
+}
+
+TEST(PipelineTest, BatchWrapAndDepositSpanBlocks) {
+    grid::Grid g(32, 0.0, 1.0);
+    auto fused = make_particles(3 * memory::kernel_block + 5);
+    // Up to three periods out, so the wrap needs its fallback too
+    particles::advance_positions(fused, 10.0);
+    auto separate = fused;
+
+    grid::Field cic_fused(g), ngp_fused(g), cic_separate(g), ngp_separate(g);
+    auto step = stage::wrap(g) | stage::deposit_cic(cic_fused) | stage::deposit_ngp(ngp_fused);
+    step.run(fused, 2 * memory::kernel_block + 24);  // chunks span several blocks
+
+    for (auto& x : separate.x()) {
+        x = g.wrap_position(x);
+    }
+    deposit_cic(separate, cic_separate);
+    deposit_ngp(separate, ngp_separate);
+
+    for (std::size_t i = 0; i < fused.size(); ++i) {
+        ASSERT_EQ(fused.x(i), separate.x(i));
+    }
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        EXPECT_NEAR(cic_fused[c], cic_separate[c], 1e-9 * cic_separate[c]);
+        EXPECT_NEAR(ngp_fused[c], ngp_separate[c], 1e-9 * ngp_separate[c]);
+    }
+}
+
+TEST(PipelineTest, NgpWithoutIndexStage) {
+    grid::Grid g(16, 0.0, 1.0);
+    auto p = make_particles(5000);
+    grid::Field fused(g), reference(g);
+
+    auto step = stage::deposit_ngp(fused) | stage::accelerate(2.0, 0.5);
+    step.run(p);
+    deposit_ngp(p, reference);
+
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        EXPECT_NEAR(fused[c], reference[c], 1e-9 * reference[c]);
+    }
+    EXPECT_DOUBLE_EQ(p.v(0), 0.3 - 0.6 * p.x(0) + 1.0);
+}
+
+TEST(PipelineTest, RunsAccumulateLikeDeposit) {
+    grid::Grid g(4, 0.0, 1.0);
+    particles::Particles p(10, 0.5, 0.0, 1.0);
+    grid::Field rho(g);
+    auto step = stage::push(0.0) | stage::deposit_ngp(rho);
+
+    step.run(p);
+    step.run(p);
+
+    EXPECT_DOUBLE_EQ(rho[2], 2.0 * 10.0 / g.dx());
+}
+
+// =============================================================================
+// Chunking Tests
+// =============================================================================
+
+TEST(PipelineTest, CustomStageSeesAlignedChunks) {
+    particles::Particles p(1000, 0.0, 0.0, 1.0);
+    std::atomic<std::size_t> seen{0};
+    std::atomic<bool> aligned{true};
+
+    auto step = stage::push(0.0) | stage::custom([&](ParticleChunk<double>& chunk, std::size_t) {
+        seen += chunk.size();
+        if (chunk.first % particles::Particles::lanes != 0 || chunk.size() > 128) {
+            aligned = false;
+        }
+    });
+    step.run(p, 100);
+
+    EXPECT_EQ(seen.load(), p.size());
+    EXPECT_TRUE(aligned.load());
+}
+
+TEST(PipelineTest, EmptyContainer) {
+    grid::Grid g(4, 0.0, 1.0);
+    grid::Field rho(g);
+    particles::Particles p;
+    auto step = stage::push(1.0) | stage::deposit_ngp(rho);
+
+    step.run(p);
+
+    EXPECT_DOUBLE_EQ(rho[0], 0.0);
+}
+
+TEST(PipelineFTest, FloatParticlesDoubleField) {
+    grid::GridF gf(8, 0.0f, 1.0f);
+    grid::Grid g(8, 0.0, 1.0);  // the field keeps a reference: must outlive it
+    grid::Field rho(g);
+    particles::ParticlesF p(64, 0.25f, 0.5f, 1.0f);
+
+    auto step = stage::push(0.5) | stage::wrap(gf) | stage::deposit_ngp(rho);
+    step.run(p);
+
+    EXPECT_FLOAT_EQ(p.x(0), 0.5f);
+    EXPECT_NEAR(rho[4], 64.0 * 8.0, 1e-9);
+}
+
+} // namespace vps::kernels::test
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <vps/grid/static_grid.h>
+#include <vps/kernels/pipeline.h>
+#include <vps/kernels/push.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+namespace vps::kernels::test {
+
+// =============================================================================
+// Fused Stream and Wrap Tests
+// =============================================================================
+
+TEST(StreamAndWrapTest, MatchesTwoPassPath) {
+    grid::Grid g(16, -1.0, 3.0);
+    particles::Particles fused;
+    fused.fill_with(1000, [](std::size_t i) {
+        const double s = static_cast<double>(i) / 1000.0;
+        return std::array{-1.0 + 4.0 * s, 30.0 * (s - 0.5), 1.0};
+    });
+    auto reference = fused;
+
+    const auto slow = stream_and_wrap(fused, g, 0.1);
+
+    particles::advance_positions(reference, 0.1);
+    for (auto& x : reference.x()) {
+        x = g.wrap_position(x);
+    }
+    EXPECT_EQ(slow, 0u);  // |v dt| <= 1.5 < L = 4
+    for (std::size_t i = 0; i < fused.size(); ++i) {
+        ASSERT_NEAR(fused.x(i), reference.x(i), 1e-12) << i;
+        ASSERT_GE(fused.x(i), g.x_min());
+        ASSERT_LT(fused.x(i), g.x_max());
+    }
+}
+
+TEST(StreamAndWrapTest, FastPointsFallBack) {
+    grid::Grid g(4, 0.0, 1.0);
+    particles::Particles p;
+    p.push_back(0.5, 12.25, 1.0);   // 12 domain lengths per step
+    p.push_back(0.5, -3.5, 1.0);
+    p.push_back(0.25, 0.5, 1.0);
+
+    const auto slow = stream_and_wrap(p, g, 1.0);
+
+    EXPECT_EQ(slow, 2u);
+    EXPECT_NEAR(p.x(0), 0.75, 1e-12);
+    EXPECT_NEAR(p.x(1), 0.0, 1e-12);
+    EXPECT_NEAR(p.x(2), 0.75, 1e-12);
+}
+
+TEST(StreamAndWrapTest, PipelineStageMatchesKernel) {
+    grid::GridF g(8, 0.0f, 2.0f);
+    particles::ParticlesF staged(300, 1.9f, 0.7f, 1.0f);
+    auto direct = staged;
+
+    auto step = stage::stream_and_wrap(0.5, g) | stage::index(g);
+    step.run(staged, 64);
+    stream_and_wrap(direct, g, 0.5f);
+
+    for (std::size_t i = 0; i < staged.size(); ++i) {
+        ASSERT_FLOAT_EQ(staged.x(i), direct.x(i));
+    }
+    EXPECT_NEAR(staged.x(0), 0.25f, 1e-6f);
+}
+
+// =============================================================================
+// Fast-Forward Tests
+// =============================================================================
+
+TEST(FastForwardTest, MatchesRepeatedSteps) {
+    grid::Grid g(16, -1.0, 3.0);
+    particles::Particles jumped;
+    jumped.fill_with(5000, [](std::size_t i) {
+        const double s = static_cast<double>(i) / 5000.0;
+        return std::array{-1.0 + 4.0 * s, 30.0 * (s - 0.5), 1.0};
+    });
+    auto stepped = jumped;
+
+    fast_forward(jumped, g, 0.1, 25);
+    for (int n = 0; n < 25; ++n) {
+        stream_and_wrap(stepped, g, 0.1);
+    }
+
+    for (std::size_t i = 0; i < jumped.size(); ++i) {
+        ASSERT_GE(jumped.x(i), g.x_min());
+        ASSERT_LT(jumped.x(i), g.x_max());
+        // Same point on the circle, up to rounding accumulated over 25 steps
+        const double d = std::remainder(jumped.x(i) - stepped.x(i), g.length());
+        ASSERT_NEAR(d, 0.0, 1e-11) << i;
+    }
+}
+
+TEST(FastForwardTest, CrossesManyPeriods) {
+    grid::Grid g(4, 0.0, 1.0);
+    particles::Particles p;
+    p.push_back(0.25, 1000.5, 1.0);
+    p.push_back(0.5, -77.125, 1.0);
+
+    const auto slow = fast_forward(p, g, 0.5, 4);  // t = 2
+
+    EXPECT_EQ(slow, 0u);
+    EXPECT_NEAR(p.x(0), 0.25, 1e-9);
+    EXPECT_NEAR(p.x(1), 0.25, 1e-9);
+}
+
+TEST(FastForwardTest, ZeroStepsWrapsOnly) {
+    grid::GridF g(8, 0.0f, 2.0f);
+    particles::ParticlesF p(10, 1.5f, 3.0f, 1.0f);
+
+    fast_forward(p, g, 0.1f, 0);
+
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        EXPECT_FLOAT_EQ(p.x(i), 1.5f);
+    }
+}
+
+// =============================================================================
+// Field Kick Tests
+// =============================================================================
+
+TEST(KickTest, MatchesFieldInterpolate) {
+    grid::Grid g(32, -1.0, 3.0);
+    grid::Field E(g);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        E[c] = std::sin(2.0 * std::numbers::pi * g.cell_left(c) / g.length());
+    }
+    // Several blocks; points inside, one period out and many periods out
+    particles::Particles p;
+    p.fill_with(9000, [](std::size_t i) {
+        return std::array{-13.0 + 0.003 * static_cast<double>(i), 0.5, 1.0};
+    });
+
+    kick(p, E, -2.0, 0.1);
+
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        const double expected = 0.5 - 2.0 * 0.1 * E.interpolate(p.x(i));
+        ASSERT_NEAR(p.v(i), expected, 1e-12) << "x = " << p.x(i);
+    }
+}
+
+TEST(KickTest, UniformFieldMatchesAdvanceVelocities) {
+    grid::Grid g(8, 0.0, 1.0);
+    grid::Field E(g);
+    for (auto& e : E.values()) {
+        e = 0.75;
+    }
+    particles::Particles kicked(257, 0.3, -1.0, 1.0);
+    auto reference = kicked;
+
+    kick(kicked, E, 2.0, 0.5);
+    particles::advance_velocities(reference, 0.75 * 2.0, 0.5);
+
+    for (std::size_t i = 0; i < kicked.size(); ++i) {
+        ASSERT_DOUBLE_EQ(kicked.v(i), reference.v(i));
+    }
+}
+
+TEST(KickTest, LastCellInterpolatesTowardFirstNode) {
+    grid::Grid g(4, 0.0, 1.0);
+    grid::Field E(g);
+    E[0] = 1.0;
+    E[3] = 3.0;
+    particles::Particles p;
+    p.push_back(0.875, 0.0, 1.0);   // halfway between node 3 and node 0 (periodic)
+
+    kick(p, E, 1.0, 1.0);
+
+    EXPECT_NEAR(p.v(0), 2.0, 1e-12);
+}
+
+TEST(KickFTest, FloatParticlesDoubleField) {
+    grid::Grid g(16, 0.0, 1.0);
+    grid::Field E(g);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        E[c] = static_cast<double>(c);
+    }
+    particles::ParticlesF p;
+    p.fill_with(100, [](std::size_t i) {
+        return std::array{0.01f * static_cast<float>(i), 0.0f, 1.0f};
+    });
+
+    kick(p, E, 1.0f, 1.0f);
+
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        const double expected = E.interpolate(static_cast<double>(p.x(i)));
+        ASSERT_NEAR(p.v(i), expected, 1e-5);
+    }
+}
+
+TEST(KickFTest, DoubleParticlesFloatField) {
+    grid::GridF g(16, 0.0f, 1.0f);
+    grid::FieldF E(g);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        E[c] = static_cast<float>(c);
+    }
+    particles::Particles p;
+    p.fill_with(100, [](std::size_t i) {
+        return std::array{0.01 * static_cast<double>(i), 0.0, 1.0};
+    });
+
+    kick(p, E, 1.0, 1.0);
+
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        const float expected = E.interpolate(static_cast<float>(p.x(i)));
+        ASSERT_NEAR(p.v(i), expected, 1e-5);
+    }
+}
+
+// =============================================================================
+// Static Grid Tests
+// =============================================================================
+
+TEST(StaticGridPushTest, MatchesRuntimeGridExactly) {
+    const grid::StaticGrid<32> sg(-1.0, 3.0);
+    const grid::Grid g = sg.to_grid();
+    grid::Field E(g);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        E[c] = std::cos(2.0 * std::numbers::pi * g.cell_left(c) / g.length());
+    }
+    // Several blocks, with points outside on entry and points faster than L per step
+    particles::Particles on_static;
+    on_static.fill_with(9000, [](std::size_t i) {
+        const double s = static_cast<double>(i) / 9000.0;
+        return std::array{-9.0 + 20.0 * s, 60.0 * (s - 0.5), 1.0};
+    });
+    auto on_runtime = on_static;
+
+    EXPECT_EQ(stream_and_wrap(on_static, sg, 0.1), stream_and_wrap(on_runtime, g, 0.1));
+    kick(on_static, E, sg, -2.0, 0.1);
+    kick(on_runtime, E, -2.0, 0.1);
+    EXPECT_EQ(fast_forward(on_static, sg, 0.1, 7), fast_forward(on_runtime, g, 0.1, 7));
+
+    for (std::size_t i = 0; i < on_static.size(); ++i) {
+        ASSERT_EQ(on_static.x(i), on_runtime.x(i)) << i;
+        ASSERT_EQ(on_static.v(i), on_runtime.v(i)) << i;
+    }
+}
+
+} // namespace vps::kernels::test
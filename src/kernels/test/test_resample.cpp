@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <vps/kernels/deposit.h>
+#include <vps/kernels/resample.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace vps::kernels::test {
+
+namespace {
+
+/// Per-cell sums of w, w x, w v and w v^2
+std::vector<std::array<double, 4>> cell_moments(const particles::Particles& p,
+                                                const grid::Grid& g) {
+    std::vector<std::array<double, 4>> m(g.n_cells(), {0.0, 0.0, 0.0, 0.0});
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        auto& c = m[g.cell_index(p.x(i))];
+        const double w = p.f(i);
+        c[0] += w;
+        c[1] += w * g.wrap_position(p.x(i));
+        c[2] += w * p.v(i);
+        c[3] += w * p.v(i) * p.v(i);
+    }
+    return m;
+}
+
+void expect_conserved(const particles::Particles& before, const particles::Particles& after,
+                      const grid::Grid& g) {
+    const auto a = cell_moments(before, g);
+    const auto b = cell_moments(after, g);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            EXPECT_NEAR(b[c][k], a[c][k], 1e-9 * (1.0 + std::abs(a[c][k])))
+                << "cell " << c << " moment " << k;
+        }
+    }
+
+    grid::Field rho_before(g), rho_after(g);
+    deposit_cic(before, rho_before);
+    deposit_cic(after, rho_after);
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        EXPECT_NEAR(rho_after[c], rho_before[c], 1e-9 * (1.0 + std::abs(rho_before[c])));
+    }
+}
+
+/// Maxwellian-weighted points on a regular (x, v) lattice, density 1 + a cos(x)
+particles::Particles make_lattice(const grid::Grid& g, std::size_t per_cell, std::size_t n_v,
+                                  double amplitude) {
+    particles::Particles p;
+    for (std::size_t c = 0; c < g.n_cells(); ++c) {
+        for (std::size_t j = 0; j < per_cell; ++j) {
+            const double x = g.cell_left(c) +
+                             (static_cast<double>(j) + 0.5) / static_cast<double>(per_cell) * g.dx();
+            for (std::size_t k = 0; k < n_v; ++k) {
+                const double v = -4.0 + 8.0 * (static_cast<double>(k) + 0.5) / static_cast<double>(n_v);
+                p.push_back(x, v, std::exp(-0.5 * v * v) * (1.0 + amplitude * std::cos(x)));
+            }
+        }
+    }
+    return p;
+}
+
+} // namespace
+
+// =============================================================================
+// Merging Tests
+// =============================================================================
+
+TEST(ResampleTest, MergeMeetsBudgetAndConserves) {
+    grid::Grid g(16, 0.0, 2.0 * 3.141592653589793);
+    const auto original = make_lattice(g, 4, 64, 0.2);
+    auto p = original;
+
+    ResampleConfig config;
+    config.max_points = original.size() / 2;
+    const auto stats = resample(p, g, config);
+
+    EXPECT_LE(p.size(), config.max_points);
+    EXPECT_GT(stats.merged_bins, 0u);
+    EXPECT_EQ(p.size(), original.size() - stats.removed + stats.split);
+    expect_conserved(original, p, g);
+}
+
+TEST(ResampleTest, LightBinsAlwaysMerge) {
+    grid::Grid g(4, 0.0, 4.0);
+    particles::Particles p;
+    for (int i = 0; i < 10; ++i) {
+        p.push_back(1.1 + 0.05 * i, 0.5 + 0.01 * i, 0.001);  // light group in cell 1
+        p.push_back(2.5, -3.0 + 0.6 * i, 1.0);                 // heavy, spread in v
+    }
+    const auto original = p;
+
+    ResampleConfig config;
+    config.velocity_bins = 4;
+    config.max_points = 100;  // budget is not the reason to merge
+    config.split_weight = 1e9;
+    const auto stats = resample(p, g, config);
+
+    EXPECT_EQ(stats.merged_bins, 1u);
+    EXPECT_EQ(stats.removed, 8u);
+    EXPECT_EQ(p.size(), 12u);
+    expect_conserved(original, p, g);
+}
+
+// =============================================================================
+// Splitting Tests
+// =============================================================================
+
+TEST(ResampleTest, SplitsHeavyPointsInSteepCells) {
+    grid::Grid g(8, 0.0, 8.0);
+    particles::Particles p;
+    for (std::size_t c = 0; c < 8; ++c) {
+        // Weight steps up at cell 4: cells 3 and 4 see a steep neighbourhood
+        const double w = c < 4 ? 1.0 : 10.0;
+        p.push_back(static_cast<double>(c) + 0.3, 0.0, w);
+        p.push_back(static_cast<double>(c) + 0.6, 1.0, w);
+    }
+    const auto original = p;
+
+    ResampleConfig config;
+    config.max_points = 100;
+    config.split_weight = 1.5;
+    const auto stats = resample(p, g, config);
+
+    EXPECT_GT(stats.split, 0u);
+    EXPECT_EQ(stats.removed, 0u);
+    EXPECT_EQ(p.size(), original.size() + stats.split);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        EXPECT_LE(p.f(i), 10.0);
+    }
+    expect_conserved(original, p, g);
+}
+
+TEST(ResampleTest, SplittingRespectsBudget) {
+    grid::Grid g(16, 0.0, 2.0 * 3.141592653589793);
+    const auto original = make_lattice(g, 2, 16, 0.9);
+    auto p = original;
+
+    ResampleConfig config;
+    config.max_points = original.size() + 5;
+    config.split_weight = 0.5;
+    config.merge_weight = 0.0;
+    const auto stats = resample(p, g, config);
+
+    EXPECT_EQ(stats.split, 5u);
+    EXPECT_EQ(p.size(), config.max_points);
+    expect_conserved(original, p, g);
+}
+
+// =============================================================================
+// Edge Cases
+// =============================================================================
+
+TEST(ResampleTest, EmptyAndInvalidConfig) {
+    grid::Grid g(4, 0.0, 1.0);
+    particles::Particles p;
+    EXPECT_EQ(resample(p, g).removed, 0u);
+
+    ResampleConfig config;
+    config.velocity_bins = 0;
+    EXPECT_THROW(resample(p, g, config), std::invalid_argument);
+    config.velocity_bins = 4;
+    config.merge_weight = -1.0;
+    EXPECT_THROW(resample(p, g, config), std::invalid_argument);
+}
+
+TEST(ResampleFTest, FloatMergeConservesWeight) {
+    grid::GridF g(8, 0.0f, 1.0f);
+    particles::ParticlesF p;
+    for (int i = 0; i < 800; ++i) {
+        p.push_back(static_cast<float>(i) / 800.0f, static_cast<float>(i % 7) - 3.0f, 1.0f);
+    }
+
+    ResampleConfig config;
+    config.max_points = 200;
+    resample(p, g, config);
+
+    double total = 0.0;
+    for (const float w : p.f()) {
+        total += w;
+    }
+    EXPECT_LE(p.size(), 200u);
+    EXPECT_NEAR(total, 800.0, 1e-3);
+}
+
+} // namespace vps::kernels::test
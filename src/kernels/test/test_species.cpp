@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <vps/kernels/deposit.h>
+#include <vps/kernels/push.h>
+#include <vps/kernels/species.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace vps::kernels::test {
+
+namespace {
+
+/// @brief Points spread over [x_min, x_max) with velocities in (-1, 1)
+particles::Particles make_points(const grid::Grid& g, std::size_t n, double weight) {
+    particles::Particles p;
+    p.fill_with(n, [&](std::size_t i) {
+        const double s = (static_cast<double>(i) + 0.5) / static_cast<double>(n);
+        return std::array{g.x_min() + s * g.length(), 2.0 * s - 1.0, weight};
+    });
+    return p;
+}
+
+} // namespace
+
+// =============================================================================
+// SpeciesSet Tests
+// =============================================================================
+
+TEST(SpeciesSetTest, AddAndFind) {
+    grid::Grid g(8, 0.0, 1.0);
+    SpeciesSet set(g);
+    EXPECT_TRUE(set.empty());
+
+    set.add("electrons", -1.0, 1.0, particles::Particles(10, 0.5, 0.0, 1.0));
+    set.add("ions", 1.0, 1836.0, particles::Particles(3, 0.5, 0.0, 1.0));
+
+    EXPECT_EQ(set.size(), 2u);
+    EXPECT_EQ(set.total_points(), 13u);
+    ASSERT_NE(set.find("ions"), nullptr);
+    EXPECT_DOUBLE_EQ(set.find("ions")->q_over_m(), 1.0 / 1836.0);
+    EXPECT_EQ(set.find("dust"), nullptr);
+    EXPECT_EQ(&set.grid(), &g);
+}
+
+TEST(SpeciesSetTest, RejectsBadSpecies) {
+    grid::Grid g(8, 0.0, 1.0);
+    SpeciesSet set(g);
+    set.add("electrons", -1.0, 1.0);
+
+    EXPECT_THROW(set.add("electrons", -1.0, 1.0), std::invalid_argument);
+    EXPECT_THROW(set.add("dust", 1.0, 0.0), std::invalid_argument);
+    EXPECT_EQ(set.size(), 1u);
+}
+
+TEST(SpeciesSetTest, BlocksCoverEverySpeciesOnce) {
+    grid::Grid g(8, 0.0, 1.0);
+    SpeciesSet set(g);
+    const std::array<std::size_t, 3> sizes{2 * memory::kernel_block + 7, 0, 5};
+    set.add("a", 1.0, 1.0, particles::Particles(sizes[0], 0.5, 0.0, 1.0));
+    set.add("b", 1.0, 1.0);
+    set.add("c", 1.0, 1.0, particles::Particles(sizes[2], 0.5, 0.0, 1.0));
+
+    set.for_each_block([](Species& species, std::size_t first, std::size_t count) {
+        for (std::size_t i = first; i < first + count; ++i) {
+            species.particles.f(i) += 1.0;
+        }
+    });
+
+    for (std::size_t s = 0; s < set.size(); ++s) {
+        ASSERT_EQ(set[s].particles.size(), sizes[s]);
+        for (std::size_t i = 0; i < sizes[s]; ++i) {
+            ASSERT_DOUBLE_EQ(set[s].particles.f(i), 2.0) << s << ":" << i;
+        }
+    }
+}
+
+TEST(SpeciesSetTest, SharesSplitBlocksInOrder) {
+    grid::Grid g(8, 0.0, 1.0);
+    SpeciesSet set(g);
+    set.add("a", 1.0, 1.0, particles::Particles(2 * memory::kernel_block + 7, 0.5, 0.0, 1.0));
+    set.add("b", 1.0, 1.0);
+    set.add("c", 1.0, 1.0, particles::Particles(memory::kernel_block, 0.5, 0.0, 1.0));
+
+    // Every block, flattened in species order, as (species, first)
+    const std::vector<std::pair<const Species*, std::size_t>> blocks{
+        {&set[0], 0}, {&set[0], memory::kernel_block}, {&set[0], 2 * memory::kernel_block},
+        {&set[2], 0}};
+
+    for (const std::size_t n_shares : {std::size_t{1}, std::size_t{2}, std::size_t{3},
+                                       std::size_t{7}}) {
+        std::vector<std::vector<std::pair<const Species*, std::size_t>>> seen(n_shares);
+        set.for_each_share(n_shares, [&](std::size_t r, const Species& species, std::size_t first,
+                                         std::size_t count) {
+            EXPECT_EQ(count, std::min(memory::kernel_block, species.particles.size() - first));
+            seen[r].emplace_back(&species, first);
+        });
+
+        std::vector<std::pair<const Species*, std::size_t>> all;
+        for (const auto& share : seen) {
+            all.insert(all.end(), share.begin(), share.end());
+        }
+        EXPECT_EQ(all, blocks) << n_shares << " shares";
+    }
+}
+
+// =============================================================================
+// Species Kernel Tests
+// =============================================================================
+
+TEST(SpeciesKernelTest, DepositMatchesPerSpeciesSweeps) {
+    grid::Grid g(32, -1.0, 3.0);
+    SpeciesSet set(g);
+    set.add("electrons", -1.0, 1.0, make_points(g, 3 * memory::kernel_block + 11, 0.5));
+    set.add("ions", 2.0, 100.0, make_points(g, 777, 0.25));
+
+    for (const bool cic : {false, true}) {
+        grid::Field rho(g, 1.0);
+        grid::Field reference(g, 1.0);
+        cic ? deposit_charge_cic(set, rho) : deposit_charge_ngp(set, rho);
+
+        for (const auto& species : set) {
+            grid::Field single(g);
+            cic ? deposit_cic(species.particles, single) : deposit_ngp(species.particles, single);
+            for (std::size_t c = 0; c < g.n_cells(); ++c) {
+                reference[c] += species.charge * single[c];
+            }
+        }
+        for (std::size_t c = 0; c < g.n_cells(); ++c) {
+            ASSERT_NEAR(rho[c], reference[c], 1e-9) << (cic ? "cic " : "ngp ") << c;
+        }
+    }
+}
+
+TEST(SpeciesKernelTest, FloatPointsDoubleField) {
+    grid::GridF gf(16, 0.0f, 1.0f);
+    grid::Grid g(16, 0.0, 1.0);
+    SpeciesSetF set(gf);
+    set.add("ions", 1.0f, 1.0f, particles::ParticlesF(1000, 0.3f, 0.0f, 0.1f));
+
+    grid::Field rho(g);
+    deposit_charge_ngp(set, rho);
+
+    EXPECT_NEAR(rho[4] * g.dx(), 1000.0 * static_cast<double>(0.1f), 1e-9);
+}
+
+TEST(SpeciesKernelTest, KickUsesEachChargeToMass) {
+    grid::Grid g(8, 0.0, 1.0);
+    grid::Field E(g, 2.0);  // uniform field
+    SpeciesSet set(g);
+    set.add("electrons", -1.0, 1.0, make_points(g, 100, 1.0));
+    set.add("ions", 1.0, 4.0, make_points(g, 5000, 1.0));
+    const auto electrons = set[0].particles;
+    const auto ions = set[1].particles;
+
+    kick(set, E, 0.5);
+
+    for (std::size_t i = 0; i < electrons.size(); ++i) {
+        ASSERT_NEAR(set[0].particles.v(i), electrons.v(i) - 1.0, 1e-12) << i;
+    }
+    for (std::size_t i = 0; i < ions.size(); ++i) {
+        ASSERT_NEAR(set[1].particles.v(i), ions.v(i) + 0.25, 1e-12) << i;
+    }
+}
+
+TEST(SpeciesKernelTest, StreamAndWrapMatchesPerSpecies) {
+    grid::Grid g(16, -1.0, 3.0);
+    SpeciesSet set(g);
+    set.add("electrons", -1.0, 1.0, make_points(g, memory::kernel_block + 3, 1.0));
+    set.add("ions", 1.0, 1836.0, make_points(g, 50, 1.0));
+    auto electrons = set[0].particles;
+    auto ions = set[1].particles;
+
+    EXPECT_EQ(stream_and_wrap(set, 0.1), 0u);
+    stream_and_wrap(electrons, g, 0.1);
+    stream_and_wrap(ions, g, 0.1);
+
+    for (std::size_t i = 0; i < electrons.size(); ++i) {
+        ASSERT_DOUBLE_EQ(set[0].particles.x(i), electrons.x(i)) << i;
+    }
+    for (std::size_t i = 0; i < ions.size(); ++i) {
+        ASSERT_DOUBLE_EQ(set[1].particles.x(i), ions.x(i)) << i;
+    }
+}
+
+} // namespace vps::kernels::test
@@ -0,0 +1,126 @@
+#ifndef VPS_MEMORY_ARENA_H
+#define VPS_MEMORY_ARENA_H
+
+/// @file arena.h
+/// @brief Step-scoped scratch memory for transient kernel buffers
+///
+/// Sort offsets, compaction prefix sums and per-thread deposit rows live
+/// for one call and are thrown away. Drawn from the heap they cost an
+/// allocation and a free per call, every step. A StepArena hands them out
+/// by bumping a pointer through one block and takes everything back at
+/// once in reset(). The block is resized at reset() to the most any step
+/// has needed so far, so after the first step the time loop makes no heap
+/// allocations at all.
+///
+/// Kernels do not take the arena as an argument: they allocate their
+/// temporaries from scratch(), which is the arena of the innermost live
+/// ScratchScope on the calling thread, or the default pmr resource
+/// without one.
+///
+/// @code
+/// StepArena arena;
+/// ScratchScope scope(arena);
+/// for (int step = 0; step < n_steps; ++step) {
+///     arena.reset();
+///     index.step(particles);   // temporaries come from arena
+/// }
+/// @endcode
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace vps::memory {
+
+/// @brief Monotonic pmr resource that is rewound once per step
+///
+/// Not thread-safe: allocate from the thread that owns the scope, outside
+/// of parallel regions, and share the buffers with the team.
+class StepArena final : public std::pmr::memory_resource {
+public:
+    /// @brief Create an arena
+    /// @param initial_bytes Size of the block to reserve up front (may be 0)
+    /// @param upstream Resource the block and any overflow come from
+    explicit StepArena(std::size_t initial_bytes = 0,
+                       std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    ~StepArena() override;
+
+    StepArena(const StepArena&) = delete;
+    StepArena& operator=(const StepArena&) = delete;
+
+    /// @brief Releases everything handed out since the last reset
+    ///
+    /// Overflow chunks go back upstream, and if this step needed more than
+    /// the block holds, the block is replaced by one that fits the high
+    /// water mark. Buffers drawn from the arena must be gone by now.
+    void reset();
+
+    /// @brief Returns the number of allocations made from upstream so far
+    ///
+    /// Counts the block itself, every overflow chunk and every regrowth.
+    /// Constant across steps once the arena has warmed up.
+    [[nodiscard]] std::size_t upstream_allocations() const noexcept;
+
+    /// @brief Returns the size of the block in bytes
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /// @brief Returns the bytes handed out since the last reset, alignment included
+    [[nodiscard]] std::size_t used() const noexcept;
+
+    /// @brief Returns the largest used() seen at any reset, or now
+    [[nodiscard]] std::size_t high_water() const noexcept;
+
+private:
+    /// @brief Header of a chunk obtained from upstream when the block is full
+    struct Overflow {
+        Overflow* next;          ///< Previously obtained chunk
+        std::size_t bytes;       ///< Total chunk size, header included
+        std::size_t alignment;   ///< Alignment the chunk was obtained with
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    /// @brief Replaces the block by one of at least bytes
+    void grow(std::size_t bytes);
+
+    /// @brief Returns every overflow chunk to upstream
+    void release_overflow() noexcept;
+
+    std::pmr::memory_resource* upstream_;  ///< Source of the block and overflow
+    std::byte* block_ = nullptr;           ///< Bump-allocated block
+    std::size_t capacity_ = 0;             ///< Bytes in block_
+    std::size_t offset_ = 0;               ///< Next free byte in block_
+    Overflow* overflow_ = nullptr;         ///< Chunks obtained this step
+    std::size_t overflow_used_ = 0;        ///< Bytes handed out from overflow this step
+    std::size_t high_water_ = 0;           ///< Largest used() at a reset
+    std::size_t upstream_allocations_ = 0; ///< Calls to upstream allocate
+};
+
+/// @brief Returns the scratch resource of the calling thread
+///
+/// The arena of the innermost live ScratchScope on this thread, or
+/// std::pmr::get_default_resource() if there is none. Threads never share
+/// a scope, so OpenMP workers see the default resource.
+[[nodiscard]] std::pmr::memory_resource* scratch() noexcept;
+
+/// @brief Makes a resource the calling thread's scratch() while alive
+///
+/// Scopes nest; destroying one restores the resource that was active when
+/// it was created.
+class ScratchScope {
+public:
+    explicit ScratchScope(std::pmr::memory_resource& resource) noexcept;
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+private:
+    std::pmr::memory_resource* previous_;  ///< Resource restored on destruction
+};
+
+} // namespace vps::memory
+
+#endif // VPS_MEMORY_ARENA_H
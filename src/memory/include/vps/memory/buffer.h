@@ -0,0 +1,205 @@
+#ifndef VPS_MEMORY_BUFFER_H
+#define VPS_MEMORY_BUFFER_H
+
+/// @file buffer.h
+/// @brief Owning, over-aligned raw memory block
+///
+/// A Buffer is the single slab behind a multi-column container: the owner
+/// carves fixed-offset sub-arrays out of it, and growth is one allocation
+/// plus one copy regardless of how many columns live inside.
+///
+/// Large blocks can ask for huge-page backing and mlock through the
+/// AllocationPolicy; the Buffer falls back tier by tier and records what it
+/// actually got in an AllocationReport. Blocks larger than RAM can live in
+/// a memory-mapped spill file instead and be streamed chunk by chunk with
+/// Buffer::advise.
+
+#include <vps/memory/aligned_allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vps::memory {
+
+/// @brief Returns the virtual-memory page size of the host
+[[nodiscard]] std::size_t page_size() noexcept;
+
+/// @brief Largest page size a policy asks the kernel for
+enum class HugePages : std::uint8_t {
+    None,         ///< Ordinary heap allocation
+    Transparent,  ///< Anonymous mapping with madvise(MADV_HUGEPAGE)
+    Huge2M,       ///< MAP_HUGETLB with 2 MB pages, falling back to Transparent
+    Huge1G        ///< MAP_HUGETLB with 1 GB pages, falling back to Huge2M
+};
+
+/// @brief How a Buffer's memory was actually obtained
+enum class Backing : std::uint8_t {
+    None,         ///< Empty buffer
+    Heap,         ///< Aligned operator new
+    Mapped,       ///< 2 MB-aligned anonymous mapping (see AllocationReport::thp_advised)
+    Huge2M,       ///< Reserved 2 MB huge pages
+    Huge1G,       ///< Reserved 1 GB huge pages
+    File          ///< Shared mapping of an unlinked spill file (out-of-core)
+};
+
+/// @brief Returns a short human-readable name, e.g. "2 MB huge pages"
+[[nodiscard]] std::string_view to_string(Backing backing) noexcept;
+
+/// @brief What a Buffer obtained, for logging and run reports
+struct AllocationReport {
+    Backing backing = Backing::None;  ///< Kind of memory obtained
+    std::size_t page_bytes = 0;       ///< Page size backing the block
+    bool locked = false;              ///< True if mlock succeeded
+
+    /// @brief True if a Mapped block was advised for transparent huge pages
+    ///
+    /// Advice is a request: the kernel backs the block with huge pages on
+    /// first touch only if it can find free 2 MB frames.
+    /// Buffer::transparent_huge_bytes() tells how much it actually got.
+    bool thp_advised = false;
+};
+
+/// @brief How a Buffer obtains its memory
+struct AllocationPolicy {
+    /// @brief Byte alignment of the block (power of two, >= default_alignment)
+    std::size_t alignment = default_alignment;
+
+    /// @brief Place pages by parallel first touch instead of on the allocating thread
+    ///
+    /// The Buffer itself never writes its memory; containers honouring this
+    /// flag zero each array with the block partition their kernels use,
+    /// so every page lands on the NUMA node of the thread that will stream
+    /// it.
+    bool first_touch = false;
+
+    /// @brief Huge-page backing to request; each tier falls back to the next
+    ///
+    /// Huge-page blocks are sized and aligned to the page they obtained.
+    /// What was granted is reported by Buffer::report().
+    HugePages huge_pages = HugePages::None;
+
+    /// @brief mlock the block so it is resident before the run starts
+    ///
+    /// Locking faults every page in up front (no page-fault latency spikes
+    /// mid-run). If RLIMIT_MEMLOCK forbids it the block is still returned,
+    /// unlocked; check AllocationReport::locked.
+    bool lock = false;
+
+    /// @brief Directory for a file-backed block; empty keeps the block in memory
+    ///
+    /// The block is a shared mapping of an unnamed file created in this
+    /// directory (removed when the Buffer is released), so the page cache
+    /// writes it back to disk under memory pressure instead of the process
+    /// running out of memory. Takes precedence over huge_pages.
+    std::string spill_directory;
+
+    /// @brief Policy aligning the block, and its size, to whole pages
+    ///
+    /// Page alignment is what huge-page advice and mmap-backed storage need
+    /// to operate on the block without touching its neighbours.
+    [[nodiscard]] static AllocationPolicy page_aligned() noexcept;
+
+    /// @brief Page-aligned policy with parallel first touch (see first_touch)
+    [[nodiscard]] static AllocationPolicy numa_first_touch() noexcept;
+
+    /// @brief Policy requesting huge pages, optionally locked
+    /// @param pages Largest page size to try
+    /// @param lock_pages Whether to mlock the block
+    [[nodiscard]] static AllocationPolicy huge(HugePages pages = HugePages::Huge2M,
+                                               bool lock_pages = false) noexcept;
+
+    /// @brief Page-aligned policy backing blocks with a spill file in directory
+    /// @param directory Existing writable directory, ideally on local NVMe
+    [[nodiscard]] static AllocationPolicy out_of_core(std::string directory);
+
+    /// @brief Returns true if blocks are aligned to at least one page
+    [[nodiscard]] bool is_page_aligned() const noexcept;
+};
+
+/// @brief Expected access pattern for a byte range of a Buffer
+enum class Advice : std::uint8_t {
+    Normal,      ///< No particular pattern (undo Sequential)
+    Sequential,  ///< Read ahead aggressively
+    WillNeed,    ///< Start reading the range in now
+    DontNeed     ///< Range not needed soon; drop its pages (file-backed only)
+};
+
+/// @brief Move-only owner of an aligned, uninitialized block of bytes
+///
+/// @code
+/// Buffer b(1024 * sizeof(double));
+/// auto* x = static_cast<double*>(b.data());
+/// @endcode
+class Buffer {
+public:
+    /// @brief Default constructor - owns nothing
+    Buffer() = default;
+
+    /// @brief Allocate at least `bytes` bytes
+    /// @param bytes Requested size; rounded up to a page when page-aligned
+    /// @param policy Alignment, placement and page-size policy
+    /// @throws std::invalid_argument if policy.alignment is not a power of two
+    /// @throws std::system_error if the spill file cannot be created or mapped
+    /// @throws std::bad_alloc on allocation failure
+    explicit Buffer(std::size_t bytes, AllocationPolicy policy = {});
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    Buffer(Buffer&& other) noexcept;
+    Buffer& operator=(Buffer&& other) noexcept;
+    ~Buffer();
+
+    /// @brief Returns pointer to the start of the block (nullptr if empty)
+    [[nodiscard]] void* data() noexcept { return data_; }
+    [[nodiscard]] const void* data() const noexcept { return data_; }
+
+    /// @brief Returns the usable size in bytes
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /// @brief Returns the policy the block was allocated with
+    [[nodiscard]] const AllocationPolicy& policy() const noexcept { return policy_; }
+
+    /// @brief Returns how the block was actually obtained
+    [[nodiscard]] const AllocationReport& report() const noexcept { return report_; }
+
+    /// @brief Returns true if the block lives in a spill file
+    [[nodiscard]] bool file_backed() const noexcept { return report_.backing == Backing::File; }
+
+    /// @brief Returns how many bytes of the block are backed by transparent huge pages
+    ///
+    /// Read from AnonHugePages in /proc/self/smaps, so it is only meaningful
+    /// after first touch; 0 for other backings and off Linux.
+    [[nodiscard]] std::size_t transparent_huge_bytes() const;
+
+    /// @brief Passes an access hint for [offset, offset + bytes) to the kernel
+    ///
+    /// The range is widened to whole pages. DontNeed is only applied to
+    /// file-backed blocks, where dropped pages are written back and re-read
+    /// on the next access; for memory blocks it would discard the contents
+    /// and is ignored. Heap blocks ignore all advice.
+    void advise(std::size_t offset, std::size_t bytes, Advice advice) const noexcept;
+
+    /// @brief Exchanges contents with another buffer
+    void swap(Buffer& other) noexcept;
+
+private:
+    /// @brief Obtains the block by anonymous mapping per policy_.huge_pages
+    /// @return false if no mapping could be made (caller falls back to the heap)
+    bool map(std::size_t bytes);
+
+    /// @brief Obtains the block as a shared mapping of a spill file
+    void map_file(std::size_t bytes);
+
+    void release() noexcept;
+
+    void* data_ = nullptr;        ///< Start of the block
+    std::size_t size_ = 0;        ///< Usable bytes
+    AllocationPolicy policy_{};   ///< How the block was requested
+    AllocationReport report_{};   ///< How the block was obtained
+};
+
+} // namespace vps::memory
+
+#endif // VPS_MEMORY_BUFFER_H
@@ -0,0 +1,64 @@
+#ifndef VPS_MEMORY_ISA_H
+#define VPS_MEMORY_ISA_H
+
+/// @file isa.h
+/// @brief Runtime instruction-set dispatch for the hot particle loops
+///
+/// A -march=native build only runs on CPUs at least as new as the build
+/// host. With VPS_PORTABLE the libraries are compiled for the x86-64
+/// baseline instead, and every function marked VPS_TARGET_CLONES is
+/// compiled three times:
+/// - x86-64-v4 (AVX-512 F/BW/DQ/VL),
+/// - x86-64-v3 (AVX2 and FMA),
+/// - the baseline (SSE2).
+///
+/// The loader binds each function to the widest clone the CPU supports,
+/// once, through an ifunc resolver. Elsewhere the macro is empty and the
+/// loops are compiled for whatever the build flags select.
+///
+/// OpenMP outlines parallel regions into helper functions that are not
+/// cloned, so kernels keep the work sharing outside: a parallel loop over
+/// blocks of kernel_block points calls a cloned serial SIMD loop per block.
+
+#include <cstddef>
+#include <string_view>
+
+#if defined(VPS_PORTABLE) && defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+#define VPS_TARGET_CLONES \
+    __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#define VPS_HAS_TARGET_CLONES 1
+#else
+#define VPS_TARGET_CLONES
+#define VPS_HAS_TARGET_CLONES 0
+#endif
+
+namespace vps::memory {
+
+/// @brief Vector instruction set levels the hot loops are built for
+enum class Isa {
+    Baseline,  ///< SSE2 on x86-64, or a non-x86 target
+    Avx2,      ///< x86-64-v3: AVX2 and FMA
+    Avx512,    ///< x86-64-v4: AVX-512 F/BW/DQ/VL
+};
+
+/// @brief Points handed to one call of a VPS_TARGET_CLONES loop
+///
+/// A multiple of every lane count, so blocks of an aligned column stay
+/// aligned; large enough that the indirect call is negligible.
+inline constexpr std::size_t kernel_block = 4096;
+
+/// @brief Returns the widest level the running CPU supports
+[[nodiscard]] Isa cpu_isa() noexcept;
+
+/// @brief Returns the level the hot loops actually execute with
+///
+/// In portable builds this is cpu_isa(). Otherwise it is the level the
+/// libraries were compiled for, whatever the CPU offers.
+[[nodiscard]] Isa kernel_isa() noexcept;
+
+/// @brief Returns a short lowercase name ("baseline", "avx2", "avx512")
+[[nodiscard]] std::string_view to_string(Isa isa) noexcept;
+
+} // namespace vps::memory
+
+#endif // VPS_MEMORY_ISA_H
@@ -0,0 +1,39 @@
+#ifndef VPS_MEMORY_NUMA_H
+#define VPS_MEMORY_NUMA_H
+
+/// @file numa.h
+/// @brief NUMA topology discovery and thread pinning
+///
+/// Topology is read from /sys/devices/system/node on Linux, so no libnuma
+/// dependency is needed. Elsewhere, or when sysfs is unavailable, the host
+/// is reported as a single node holding every CPU.
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace vps::memory {
+
+/// @brief One NUMA node and the CPUs this process may run on there
+struct NumaNode {
+    unsigned id = 0;              ///< Kernel node number
+    std::vector<unsigned> cpus;   ///< Usable CPUs, ascending
+};
+
+/// @brief Parses a Linux CPU list such as "0-3,8,10-11"
+/// @throws std::invalid_argument on malformed input
+[[nodiscard]] std::vector<unsigned> parse_cpu_list(std::string_view list);
+
+/// @brief Returns the NUMA nodes that have CPUs usable by this process
+///
+/// Nodes without usable CPUs (memory-only nodes, or nodes excluded by the
+/// process affinity mask) are omitted; the result is never empty.
+[[nodiscard]] std::vector<NumaNode> numa_nodes();
+
+/// @brief Restricts the calling thread to the given CPUs
+/// @return false if pinning is unsupported on this platform or failed
+bool pin_current_thread(std::span<const unsigned> cpus) noexcept;
+
+} // namespace vps::memory
+
+#endif // VPS_MEMORY_NUMA_H
@@ -0,0 +1,101 @@
+#ifndef VPS_MEMORY_TASK_POOL_H
+#define VPS_MEMORY_TASK_POOL_H
+
+/// @file task_pool.h
+/// @brief Persistent work-stealing thread pool, NUMA-aware and pinned
+///
+/// A static OpenMP loop hands every thread the same number of iterations,
+/// which is only balanced when iterations cost the same. Cell-sorted
+/// deposits over a clustered plasma, species of very different sizes or a
+/// step that overlaps I/O are not. TaskPool::parallel_for starts from the
+/// same contiguous split, but a worker that runs dry steals the upper half
+/// of another worker's remaining range, trying workers on its own NUMA
+/// node before crossing to another. Ranges are single atomic words, so
+/// claiming and stealing are lock-free.
+///
+/// Workers persist between calls and are pinned one per usable CPU; the
+/// calling thread joins in as worker 0. Kernels reach the pool through
+/// particles::for_each_block when built with VPS_ENABLE_TASKS.
+///
+/// @code
+/// TaskPool& pool = task_pool();
+/// pool.parallel_for(n_cells, [&](std::size_t c) {
+///     deposit_cell(c);   // cost varies from cell to cell
+/// });
+/// @endcode
+
+#include <vps/memory/numa.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vps::memory {
+
+/// @brief Fork-join pool of pinned workers with range stealing
+class TaskPool {
+public:
+    /// @brief Start one worker per CPU of nodes (minus one for the caller)
+    /// @param nodes Topology to spread over; workers are grouped by node
+    /// @throws std::invalid_argument if nodes has no CPUs
+    explicit TaskPool(std::vector<NumaNode> nodes = numa_nodes());
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /// @brief Stops and joins the workers
+    ~TaskPool();
+
+    /// @brief Returns the number of workers, the calling thread included
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /// @brief Returns the node worker w belongs to
+    [[nodiscard]] unsigned node_of(std::size_t worker) const noexcept;
+
+    /// @brief Calls fn(i) once for every i in [0, n) and waits for all
+    ///
+    /// Called from inside a parallel_for, from another thread while the
+    /// pool is busy, or with n < 2, the loop runs serially on the caller.
+    /// If fn throws, the first exception is rethrown once all workers have
+    /// stopped; indices not yet started are skipped.
+    template <typename Fn>
+    void parallel_for(std::size_t n, Fn&& fn);
+
+    /// @brief Returns the calling worker's index in the running parallel_for
+    ///
+    /// In [0, size()), unique among the workers of one call; 0 outside.
+    [[nodiscard]] static std::size_t worker_index() noexcept;
+
+private:
+    using Body = void (*)(void*, std::size_t);
+
+    /// @brief Runs body(ctx, i) for i in [0, n) on every worker
+    void run(std::size_t n, Body body, void* ctx);
+
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+/// @brief Returns the process-wide pool over the host's NUMA nodes
+///
+/// Created on first use.
+[[nodiscard]] TaskPool& task_pool();
+
+// =============================================================================
+// Template Implementations
+// =============================================================================
+
+template <typename Fn>
+void TaskPool::parallel_for(std::size_t n, Fn&& fn) {
+    using F = std::remove_reference_t<Fn>;
+    run(n, [](void* ctx, std::size_t i) { (*static_cast<F*>(ctx))(i); },
+        const_cast<void*>(static_cast<const void*>(std::addressof(fn))));
+}
+
+} // namespace vps::memory
+
+#endif // VPS_MEMORY_TASK_POOL_H
@@ -0,0 +1,128 @@
+#include "vps/memory/arena.h"
+
+#include <vps/memory/aligned_allocator.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace vps::memory {
+
+namespace {
+
+/// @brief Scratch resource of the calling thread (nullptr: default resource)
+thread_local std::pmr::memory_resource* current_scratch = nullptr;
+
+} // namespace
+
+// =============================================================================
+// StepArena
+// =============================================================================
+
+StepArena::StepArena(std::size_t initial_bytes, std::pmr::memory_resource* upstream)
+    : upstream_(upstream)
+{
+    if (initial_bytes > 0) {
+        grow(initial_bytes);
+    }
+}
+
+StepArena::~StepArena() {
+    release_overflow();
+    if (block_ != nullptr) {
+        upstream_->deallocate(block_, capacity_, default_alignment);
+    }
+}
+
+void StepArena::reset() {
+    high_water_ = std::max(high_water_, used());
+    release_overflow();
+    offset_ = 0;
+    if (high_water_ > capacity_) {
+        grow(high_water_);
+    }
+}
+
+std::size_t StepArena::upstream_allocations() const noexcept {
+    return upstream_allocations_;
+}
+
+std::size_t StepArena::capacity() const noexcept {
+    return capacity_;
+}
+
+std::size_t StepArena::used() const noexcept {
+    return offset_ + overflow_used_;
+}
+
+std::size_t StepArena::high_water() const noexcept {
+    return std::max(high_water_, used());
+}
+
+void* StepArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    const auto base = reinterpret_cast<std::uintptr_t>(block_);
+    const std::size_t start = round_up(base + offset_, alignment) - base;
+    if (block_ != nullptr && start + bytes <= capacity_) {
+        offset_ = start + bytes;
+        return block_ + start;
+    }
+
+    // Block exhausted: chunk from upstream, freed at reset and folded into
+    // the block size so the next step fits
+    const std::size_t chunk_alignment = std::max(alignment, alignof(Overflow));
+    const std::size_t header = round_up(sizeof(Overflow), chunk_alignment);
+    void* chunk = upstream_->allocate(header + bytes, chunk_alignment);
+    ++upstream_allocations_;
+    overflow_ = ::new (chunk) Overflow{overflow_, header + bytes, chunk_alignment};
+    overflow_used_ += bytes + alignment;
+    return static_cast<std::byte*>(chunk) + header;
+}
+
+void StepArena::do_deallocate(void*, std::size_t, std::size_t) {
+    // Monotonic: everything is released together in reset()
+}
+
+bool StepArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void StepArena::grow(std::size_t bytes) {
+    if (block_ != nullptr) {
+        upstream_->deallocate(block_, capacity_, default_alignment);
+        block_ = nullptr;
+        capacity_ = 0;
+    }
+    const std::size_t capacity = round_up(bytes, default_alignment);
+    block_ = static_cast<std::byte*>(upstream_->allocate(capacity, default_alignment));
+    capacity_ = capacity;
+    ++upstream_allocations_;
+}
+
+void StepArena::release_overflow() noexcept {
+    while (overflow_ != nullptr) {
+        Overflow* next = overflow_->next;
+        upstream_->deallocate(overflow_, overflow_->bytes, overflow_->alignment);
+        overflow_ = next;
+    }
+    overflow_used_ = 0;
+}
+
+// =============================================================================
+// Scratch Scope
+// =============================================================================
+
+std::pmr::memory_resource* scratch() noexcept {
+    return current_scratch != nullptr ? current_scratch : std::pmr::get_default_resource();
+}
+
+ScratchScope::ScratchScope(std::pmr::memory_resource& resource) noexcept
+    : previous_(current_scratch)
+{
+    current_scratch = &resource;
+}
+
+ScratchScope::~ScratchScope() {
+    current_scratch = previous_;
+}
+
+} // namespace vps::memory
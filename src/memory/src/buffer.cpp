@@ -0,0 +1,372 @@
+#include "vps/memory/buffer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+#endif
+
+namespace vps::memory {
+
+namespace {
+
+constexpr std::size_t huge_2m = std::size_t{1} << 21;
+constexpr std::size_t huge_1g = std::size_t{1} << 30;
+
+#ifdef __linux__
+/// @brief Maps anonymous read-write memory; nullptr on failure
+void* map_anonymous(std::size_t bytes, int extra_flags) noexcept {
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+/// @brief Maps `bytes` starting on an `alignment` boundary by trimming an oversized mapping
+void* map_aligned(std::size_t bytes, std::size_t alignment) noexcept {
+    const std::size_t span = bytes + alignment;
+    auto* raw = static_cast<std::byte*>(map_anonymous(span, 0));
+    if (raw == nullptr) {
+        return nullptr;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(raw);
+    const std::size_t head = round_up(address, alignment) - address;
+    const std::size_t tail = span - head - bytes;
+    if (head > 0) {
+        ::munmap(raw, head);
+    }
+    if (tail > 0) {
+        ::munmap(raw + head + bytes, tail);
+    }
+    return raw + head;
+}
+
+/// @brief False if the administrator disabled transparent huge pages
+bool transparent_huge_pages_enabled() {
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string mode;
+    return !std::getline(file, mode) || mode.find("[never]") == std::string::npos;
+}
+
+/// @brief Sums AnonHugePages of the mappings overlapping [first, last), per /proc/self/smaps
+///
+/// Each mapping's share is capped at its overlap with the range, in case
+/// the kernel merged the block with a neighbouring mapping.
+std::size_t anon_huge_bytes(std::uintptr_t first, std::uintptr_t last) {
+    std::ifstream smaps("/proc/self/smaps");
+    std::size_t total = 0;
+    std::size_t overlap = 0;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        unsigned long long start = 0;
+        unsigned long long end = 0;
+        if (std::sscanf(line.c_str(), "%llx-%llx ", &start, &end) == 2) {
+            const auto lo = std::max<std::uintptr_t>(start, first);
+            const auto hi = std::min<std::uintptr_t>(end, last);
+            overlap = lo < hi ? hi - lo : 0;
+            continue;
+        }
+        unsigned long long kb = 0;
+        if (overlap > 0 && std::sscanf(line.c_str(), "AnonHugePages: %llu kB", &kb) == 1) {
+            total += std::min<std::size_t>(kb << 10, overlap);
+        }
+    }
+    return total;
+}
+#endif
+
+} // namespace
+
+// =============================================================================
+// Page Size / Policy
+// =============================================================================
+
+std::size_t page_size() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    static const std::size_t size = [] {
+        const long s = ::sysconf(_SC_PAGESIZE);
+        return s > 0 ? static_cast<std::size_t>(s) : std::size_t{4096};
+    }();
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+AllocationPolicy AllocationPolicy::page_aligned() noexcept {
+    AllocationPolicy policy;
+    policy.alignment = page_size();
+    return policy;
+}
+
+AllocationPolicy AllocationPolicy::numa_first_touch() noexcept {
+    AllocationPolicy policy = page_aligned();
+    policy.first_touch = true;
+    return policy;
+}
+
+AllocationPolicy AllocationPolicy::huge(HugePages pages, bool lock_pages) noexcept {
+    AllocationPolicy policy = page_aligned();
+    policy.huge_pages = pages;
+    policy.lock = lock_pages;
+    return policy;
+}
+
+AllocationPolicy AllocationPolicy::out_of_core(std::string directory) {
+    AllocationPolicy policy = page_aligned();
+    policy.spill_directory = std::move(directory);
+    return policy;
+}
+
+bool AllocationPolicy::is_page_aligned() const noexcept {
+    return alignment >= page_size();
+}
+
+std::string_view to_string(Backing backing) noexcept {
+    switch (backing) {
+    case Backing::None:        return "none";
+    case Backing::Heap:        return "heap";
+    case Backing::Mapped:      return "anonymous mapping";
+    case Backing::Huge2M:      return "2 MB huge pages";
+    case Backing::Huge1G:      return "1 GB huge pages";
+    case Backing::File:        return "memory-mapped file";
+    }
+    return "unknown";
+}
+
+// =============================================================================
+// Buffer
+// =============================================================================
+
+Buffer::Buffer(std::size_t bytes, AllocationPolicy policy)
+    : policy_(policy)
+{
+    if (policy_.alignment == 0 || (policy_.alignment & (policy_.alignment - 1)) != 0) {
+        throw std::invalid_argument("Buffer alignment must be a power of two");
+    }
+    if (policy_.alignment < default_alignment) {
+        policy_.alignment = default_alignment;
+    }
+    if (bytes == 0) {
+        return;
+    }
+    if (policy_.is_page_aligned()) {
+        bytes = round_up(bytes, policy_.alignment);
+    }
+    if (!policy_.spill_directory.empty()) {
+        map_file(bytes);
+    } else if (policy_.huge_pages == HugePages::None || !map(bytes)) {
+        data_ = ::operator new(bytes, std::align_val_t{policy_.alignment});
+        size_ = bytes;
+        report_ = {Backing::Heap, page_size(), false};
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    if (policy_.lock) {
+        report_.locked = ::mlock(data_, size_) == 0;
+    }
+#endif
+}
+
+bool Buffer::map(std::size_t bytes) {
+#ifdef __linux__
+    const auto try_hugetlb = [&](std::size_t page, int size_flag, Backing backing) {
+        if (policy_.alignment > page) {
+            return false;
+        }
+        const std::size_t n = round_up(bytes, page);
+        void* p = map_anonymous(n, MAP_HUGETLB | size_flag);
+        if (p == nullptr) {
+            return false;
+        }
+        data_ = p;
+        size_ = n;
+        report_ = {backing, page, false};
+        return true;
+    };
+
+    if (policy_.huge_pages == HugePages::Huge1G &&
+        try_hugetlb(huge_1g, MAP_HUGE_1GB, Backing::Huge1G)) {
+        return true;
+    }
+    if (policy_.huge_pages >= HugePages::Huge2M &&
+        try_hugetlb(huge_2m, MAP_HUGE_2MB, Backing::Huge2M)) {
+        return true;
+    }
+
+    // No reserved huge pages: a 2 MB-aligned mapping the kernel may back with THP
+    const std::size_t n = round_up(bytes, huge_2m);
+    void* p = map_aligned(n, std::max(huge_2m, policy_.alignment));
+    if (p == nullptr) {
+        return false;
+    }
+    data_ = p;
+    size_ = n;
+    report_ = {Backing::Mapped, page_size(), false};
+#ifdef MADV_HUGEPAGE
+    // Only a request: whether pages are huge is decided at first touch
+    report_.thp_advised =
+        ::madvise(p, n, MADV_HUGEPAGE) == 0 && transparent_huge_pages_enabled();
+#endif
+    return true;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+void Buffer::map_file(std::size_t bytes) {
+#if defined(__unix__) || defined(__APPLE__)
+    const std::string& dir = policy_.spill_directory;
+    int fd = -1;
+#ifdef O_TMPFILE
+    // Unnamed from the start: nothing is left behind if the process dies
+    fd = ::open(dir.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+#endif
+    if (fd < 0) {
+        std::string name = dir + "/vps-spill-XXXXXX";
+        std::vector<char> path(name.begin(), name.end());
+        path.push_back('\0');
+        fd = ::mkstemp(path.data());
+        if (fd >= 0) {
+            ::unlink(path.data());
+        }
+    }
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(),
+                                "Cannot create spill file in " + dir);
+    }
+
+    const std::size_t n = round_up(bytes, std::max(page_size(), policy_.alignment));
+    void* p = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(n)) == 0) {
+        p = ::mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int error = errno;
+    ::close(fd);  // the mapping keeps the file alive
+    if (p == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(),
+                                "Cannot map spill file in " + dir);
+    }
+    data_ = p;
+    size_ = n;
+    report_ = {Backing::File, page_size(), false};
+#else
+    (void)bytes;
+    throw std::system_error(std::make_error_code(std::errc::not_supported),
+                            "File-backed buffers need POSIX mmap");
+#endif
+}
+
+void Buffer::advise(std::size_t offset, std::size_t bytes, Advice advice) const noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    if (report_.backing == Backing::Heap || report_.backing == Backing::None ||
+        offset >= size_ || bytes == 0) {
+        return;
+    }
+    if (advice == Advice::DontNeed && report_.backing != Backing::File) {
+        return;
+    }
+    const std::size_t page = page_size();
+    const std::size_t first = offset / page * page;
+    const std::size_t last = std::min(round_up(offset + bytes, page), size_);
+
+    int flag = MADV_NORMAL;
+    switch (advice) {
+    case Advice::Normal:     flag = MADV_NORMAL; break;
+    case Advice::Sequential: flag = MADV_SEQUENTIAL; break;
+    case Advice::WillNeed:   flag = MADV_WILLNEED; break;
+    case Advice::DontNeed:   flag = MADV_DONTNEED; break;
+    }
+    ::madvise(static_cast<std::byte*>(data_) + first, last - first, flag);
+#else
+    (void)offset;
+    (void)bytes;
+    (void)advice;
+#endif
+}
+
+std::size_t Buffer::transparent_huge_bytes() const {
+#ifdef __linux__
+    if (report_.backing != Backing::Mapped) {
+        return 0;
+    }
+    const auto first = reinterpret_cast<std::uintptr_t>(data_);
+    return anon_huge_bytes(first, first + size_);
+#else
+    return 0;
+#endif
+}
+
+Buffer::Buffer(Buffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , policy_(std::move(other.policy_))
+    , report_(std::exchange(other.report_, {}))
+{}
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        policy_ = std::move(other.policy_);
+        report_ = std::exchange(other.report_, {});
+    }
+    return *this;
+}
+
+Buffer::~Buffer() {
+    release();
+}
+
+void Buffer::swap(Buffer& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(policy_, other.policy_);
+    std::swap(report_, other.report_);
+}
+
+void Buffer::release() noexcept {
+    if (data_ == nullptr) {
+        return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    if (report_.locked) {
+        ::munlock(data_, size_);
+    }
+    if (report_.backing != Backing::Heap) {
+        ::munmap(data_, size_);
+    }
+#endif
+    if (report_.backing == Backing::Heap) {
+        ::operator delete(data_, std::align_val_t{policy_.alignment});
+    }
+    data_ = nullptr;
+    size_ = 0;
+    report_ = {};
+}
+
+} // namespace vps::memory
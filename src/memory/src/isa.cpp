@@ -0,0 +1,47 @@
+#include "vps/memory/isa.h"
+
+namespace vps::memory {
+
+Isa cpu_isa() noexcept {
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    const bool v3 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    const bool v4 = v3 && __builtin_cpu_supports("avx512f") &&
+                    __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+                    __builtin_cpu_supports("avx512vl");
+    if (v4) {
+        return Isa::Avx512;
+    }
+    if (v3) {
+        return Isa::Avx2;
+    }
+#endif
+    return Isa::Baseline;
+}
+
+Isa kernel_isa() noexcept {
+#if VPS_HAS_TARGET_CLONES
+    return cpu_isa();
+#elif defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && \
+    defined(__AVX512VL__)
+    return Isa::Avx512;
+#elif defined(__AVX2__) && defined(__FMA__)
+    return Isa::Avx2;
+#else
+    return Isa::Baseline;
+#endif
+}
+
+std::string_view to_string(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::Avx512:
+            return "avx512";
+        case Isa::Avx2:
+            return "avx2";
+        case Isa::Baseline:
+            break;
+    }
+    return "baseline";
+}
+
+} // namespace vps::memory
@@ -0,0 +1,162 @@
+#include "vps/memory/numa.h"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vps::memory {
+
+namespace {
+
+/// @brief Parses one unsigned number, advancing `pos` past it
+unsigned parse_number(std::string_view list, std::size_t& pos) {
+    unsigned value = 0;
+    const auto* first = list.data() + pos;
+    const auto* last = list.data() + list.size();
+    const auto [end, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{} || end == first) {
+        throw std::invalid_argument("Malformed CPU list: " + std::string(list));
+    }
+    pos += static_cast<std::size_t>(end - first);
+    return value;
+}
+
+/// @brief CPUs the process may run on, or every online CPU if unknown
+std::vector<unsigned> allowed_cpus() {
+    std::vector<unsigned> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+#endif
+    const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned cpu = 0; cpu < n; ++cpu) {
+        cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+} // namespace
+
+// =============================================================================
+// Topology
+// =============================================================================
+
+std::vector<unsigned> parse_cpu_list(std::string_view list) {
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+
+    std::vector<unsigned> cpus;
+    std::size_t pos = 0;
+    while (pos < list.size()) {
+        const unsigned first = parse_number(list, pos);
+        unsigned last = first;
+        if (pos < list.size() && list[pos] == '-') {
+            ++pos;
+            last = parse_number(list, pos);
+            if (last < first) {
+                throw std::invalid_argument("Malformed CPU list: " + std::string(list));
+            }
+        }
+        for (unsigned cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        if (pos < list.size()) {
+            if (list[pos] != ',') {
+                throw std::invalid_argument("Malformed CPU list: " + std::string(list));
+            }
+            ++pos;
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+std::vector<NumaNode> numa_nodes() {
+    const std::vector<unsigned> allowed = allowed_cpus();
+    std::vector<NumaNode> nodes;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    for (fs::directory_iterator it("/sys/devices/system/node", ec), end; !ec && it != end;
+         it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+            !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+
+        std::ifstream file(it->path() / "cpulist");
+        std::string list;
+        if (!file || !std::getline(file, list)) {
+            continue;
+        }
+
+        NumaNode node;
+        node.id = static_cast<unsigned>(std::stoul(name.substr(4)));
+        try {
+            for (const unsigned cpu : parse_cpu_list(list)) {
+                if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+        } catch (const std::invalid_argument&) {
+            continue;
+        }
+        if (!node.cpus.empty()) {
+            nodes.push_back(std::move(node));
+        }
+    }
+
+    if (nodes.empty()) {
+        nodes.push_back(NumaNode{0, allowed});
+    }
+    std::sort(nodes.begin(), nodes.end(),
+              [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return nodes;
+}
+
+// =============================================================================
+// Pinning
+// =============================================================================
+
+bool pin_current_thread(std::span<const unsigned> cpus) noexcept {
+#ifdef __linux__
+    if (cpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const unsigned cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+} // namespace vps::memory
@@ -0,0 +1,300 @@
+#include "vps/memory/task_pool.h"
+
+#include <vps/memory/aligned_allocator.h>
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+namespace vps::memory {
+
+namespace {
+
+/// @brief Pool whose parallel_for the calling thread is running, if any
+thread_local const void* current_pool = nullptr;
+
+/// @brief Index of the calling thread among the workers of current_pool
+thread_local std::size_t current_worker = 0;
+
+/// @brief Largest piece of a range a job can describe with 32-bit bounds
+constexpr std::size_t max_job = std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Polls of the generation counter before an idle worker blocks,
+/// unless VPS_TASK_SPIN overrides it
+///
+/// A few dozen cover back-to-back sweeps of one step; longer spins only
+/// take the CPU from MPI progress threads and I/O between steps.
+constexpr std::size_t default_spin_polls = 32;
+
+/// @brief Spin polls from VPS_TASK_SPIN, or default_spin_polls if unset or not a number
+std::size_t spin_polls_from_environment() noexcept {
+    const char* text = std::getenv("VPS_TASK_SPIN");
+    if (text == nullptr) {
+        return default_spin_polls;
+    }
+    std::size_t value = 0;
+    const char* end = text + std::strlen(text);
+    const auto [ptr, ec] = std::from_chars(text, end, value);
+    return (ec == std::errc{} && ptr == end) ? value : default_spin_polls;
+}
+
+constexpr std::uint64_t pack(std::size_t begin, std::size_t end) noexcept {
+    return (static_cast<std::uint64_t>(begin) << 32) | static_cast<std::uint64_t>(end);
+}
+
+constexpr std::size_t range_begin(std::uint64_t range) noexcept {
+    return static_cast<std::size_t>(range >> 32);
+}
+
+constexpr std::size_t range_end(std::uint64_t range) noexcept {
+    return static_cast<std::size_t>(range & 0xffffffffu);
+}
+
+} // namespace
+
+// =============================================================================
+// State
+// =============================================================================
+
+struct TaskPool::State {
+    /// @brief Remaining [begin, end) of one worker, packed into one word
+    struct alignas(default_alignment) Slot {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    std::vector<unsigned> cpu;                   ///< CPU of each worker
+    std::vector<unsigned> node;                  ///< Node of each worker
+    std::vector<std::vector<std::size_t>> victims;  ///< Steal order per worker
+    std::unique_ptr<Slot[]> slots;               ///< One range per worker
+    std::vector<std::thread> threads;            ///< Workers 1 .. size() - 1
+
+    std::mutex busy;                             ///< Held by the running caller
+    std::mutex mutex;
+    std::condition_variable start;               ///< Signals a new generation or stop
+    std::condition_variable done;                ///< Signals pending reached zero
+    std::atomic<std::size_t> generation{0};
+    std::size_t pending = 0;
+    bool stop = false;
+    Body body = nullptr;
+    void* ctx = nullptr;
+    std::size_t offset = 0;                      ///< First index of the current piece
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    std::size_t spin_polls = spin_polls_from_environment();  ///< Polls before blocking
+
+    /// @brief Takes the next index of worker w's own range
+    bool claim(std::size_t w, std::size_t& i) noexcept {
+        auto& range = slots[w].range;
+        std::uint64_t r = range.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::size_t b = range_begin(r);
+            const std::size_t e = range_end(r);
+            if (b >= e) {
+                return false;
+            }
+            if (range.compare_exchange_weak(r, pack(b + 1, e), std::memory_order_acq_rel)) {
+                i = b;
+                return true;
+            }
+        }
+    }
+
+    /// @brief Moves the upper half of some victim's range into worker w's slot
+    bool steal(std::size_t w) noexcept {
+        for (const std::size_t v : victims[w]) {
+            auto& range = slots[v].range;
+            std::uint64_t r = range.load(std::memory_order_relaxed);
+            for (;;) {
+                const std::size_t b = range_begin(r);
+                const std::size_t e = range_end(r);
+                if (b >= e) {
+                    break;
+                }
+                const std::size_t mid = b + (e - b) / 2;
+                if (range.compare_exchange_weak(r, pack(b, mid), std::memory_order_acq_rel)) {
+                    slots[w].range.store(pack(mid, e), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// @brief Runs worker w's share of the current job, then steals until dry
+    void execute(std::size_t w) {
+        const void* outer_pool = std::exchange(current_pool, this);
+        const std::size_t outer_worker = std::exchange(current_worker, w);
+        do {
+            std::size_t i = 0;
+            while (claim(w, i)) {
+                if (failed.load(std::memory_order_relaxed)) {
+                    continue;  // drain without running
+                }
+                try {
+                    body(ctx, offset + i);
+                } catch (...) {
+                    std::lock_guard lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        } while (steal(w));
+        current_pool = outer_pool;
+        current_worker = outer_worker;
+    }
+
+    void work(std::size_t w) {
+        pin_current_thread(std::span<const unsigned>(&cpu[w], 1));
+        std::size_t seen = 0;
+        for (;;) {
+            for (std::size_t k = 0;
+                 k < spin_polls && generation.load(std::memory_order_acquire) == seen; ++k) {
+                std::this_thread::yield();
+            }
+            {
+                std::unique_lock lock(mutex);
+                start.wait(lock, [&] {
+                    return stop || generation.load(std::memory_order_relaxed) != seen;
+                });
+                if (stop) {
+                    return;
+                }
+                seen = generation.load(std::memory_order_relaxed);
+            }
+
+            execute(w);
+
+            std::lock_guard lock(mutex);
+            if (--pending == 0) {
+                done.notify_all();
+            }
+        }
+    }
+
+    void stop_and_join() noexcept {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+        start.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+// =============================================================================
+// TaskPool
+// =============================================================================
+
+TaskPool::TaskPool(std::vector<NumaNode> nodes)
+    : state_(std::make_unique<State>())
+{
+    for (const auto& n : nodes) {
+        for (const unsigned c : n.cpus) {
+            state_->cpu.push_back(c);
+            state_->node.push_back(n.id);
+        }
+    }
+    const std::size_t n_workers = state_->cpu.size();
+    if (n_workers == 0) {
+        throw std::invalid_argument("TaskPool needs at least one CPU");
+    }
+
+    // Steal from the own node first, each list rotated to start after w
+    state_->victims.resize(n_workers);
+    for (std::size_t w = 0; w < n_workers; ++w) {
+        for (const bool local : {true, false}) {
+            for (std::size_t k = 1; k < n_workers; ++k) {
+                const std::size_t v = (w + k) % n_workers;
+                if ((state_->node[v] == state_->node[w]) == local) {
+                    state_->victims[w].push_back(v);
+                }
+            }
+        }
+    }
+    state_->slots = std::make_unique<State::Slot[]>(n_workers);
+
+    state_->threads.reserve(n_workers - 1);
+    try {
+        for (std::size_t w = 1; w < n_workers; ++w) {
+            state_->threads.emplace_back([state = state_.get(), w] { state->work(w); });
+        }
+    } catch (...) {
+        state_->stop_and_join();
+        throw;
+    }
+}
+
+TaskPool::~TaskPool() {
+    state_->stop_and_join();
+}
+
+std::size_t TaskPool::size() const noexcept {
+    return state_->cpu.size();
+}
+
+unsigned TaskPool::node_of(std::size_t worker) const noexcept {
+    return state_->node[worker];
+}
+
+std::size_t TaskPool::worker_index() noexcept {
+    return current_worker;
+}
+
+void TaskPool::run(std::size_t n, Body body, void* ctx) {
+    State& s = *state_;
+    const std::size_t n_workers = size();
+    std::unique_lock busy(s.busy, std::defer_lock);
+    if (n < 2 || n_workers == 1 || current_pool != nullptr || !busy.try_lock()) {
+        // Nested or contended: the caller keeps its worker index
+        for (std::size_t i = 0; i < n; ++i) {
+            body(ctx, i);
+        }
+        return;
+    }
+
+    for (std::size_t offset = 0; offset < n; offset += max_job) {
+        const std::size_t count = std::min(max_job, n - offset);
+        for (std::size_t w = 0; w < n_workers; ++w) {
+            s.slots[w].range.store(pack(count * w / n_workers, count * (w + 1) / n_workers),
+                                   std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard lock(s.mutex);
+            s.body = body;
+            s.ctx = ctx;
+            s.offset = offset;
+            s.pending = s.threads.size();
+            s.error = nullptr;
+            s.failed.store(false, std::memory_order_relaxed);
+            s.generation.fetch_add(1, std::memory_order_release);
+        }
+        s.start.notify_all();
+
+        s.execute(0);
+
+        std::unique_lock lock(s.mutex);
+        s.done.wait(lock, [&] { return s.pending == 0; });
+        if (s.error) {
+            std::rethrow_exception(std::exchange(s.error, nullptr));
+        }
+    }
+}
+
+TaskPool& task_pool() {
+    static TaskPool pool;
+    return pool;
+}
+
+} // namespace vps::memory
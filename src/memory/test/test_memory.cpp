@@ -0,0 +1,477 @@
+#include <gtest/gtest.h>
+#include <vps/memory/aligned_allocator.h>
+#include <vps/memory/arena.h>
+#include <vps/memory/buffer.h>
+#include <vps/memory/isa.h>
+#include <vps/memory/numa.h>
+#include <vps/memory/task_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace vps::memory::test {
+
+// =============================================================================
+// Padding Helper Tests
+// =============================================================================
+
+TEST(AlignedAllocatorTest, RoundUp) {
+    EXPECT_EQ(round_up(0, 8), 0);
+    EXPECT_EQ(round_up(1, 8), 8);
+    EXPECT_EQ(round_up(8, 8), 8);
+    EXPECT_EQ(round_up(9, 8), 16);
+}
+
+TEST(AlignedAllocatorTest, SimdLanes) {
+    EXPECT_EQ(simd_lanes<double> * sizeof(double), default_alignment);
+    EXPECT_EQ(simd_lanes<float> * sizeof(float), default_alignment);
+    EXPECT_EQ((simd_lanes<double, 16>), 2);
+}
+
+// =============================================================================
+// Allocation Tests
+// =============================================================================
+
+TEST(AlignedAllocatorTest, VectorDataIsAligned) {
+    for (std::size_t n : {1, 3, 17, 1000}) {
+        std::vector<double, AlignedAllocator<double>> v(n, 1.0);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % default_alignment, 0);
+    }
+}
+
+TEST(AlignedAllocatorTest, CustomAlignment) {
+    std::vector<float, AlignedAllocator<float, 4096>> v(10);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % 4096, 0);
+}
+
+TEST(AlignedAllocatorTest, Rebind) {
+    using Alloc = AlignedAllocator<double, 128>;
+    using Rebound = std::allocator_traits<Alloc>::rebind_alloc<int>;
+    static_assert(std::is_same_v<Rebound, AlignedAllocator<int, 128>>);
+    EXPECT_TRUE(Alloc{} == Rebound{});
+}
+
+// =============================================================================
+// Buffer Tests
+// =============================================================================
+
+TEST(BufferTest, DefaultIsEmpty) {
+    Buffer b;
+    EXPECT_EQ(b.data(), nullptr);
+    EXPECT_EQ(b.size(), 0);
+}
+
+TEST(BufferTest, AllocationIsAligned) {
+    Buffer b(100);
+    EXPECT_NE(b.data(), nullptr);
+    EXPECT_GE(b.size(), 100);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % default_alignment, 0);
+}
+
+TEST(BufferTest, PageAlignedRoundsToWholePages) {
+    const auto policy = AllocationPolicy::page_aligned();
+    EXPECT_TRUE(policy.is_page_aligned());
+
+    Buffer b(100, policy);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % page_size(), 0);
+    EXPECT_EQ(b.size(), page_size());
+}
+
+TEST(BufferTest, InvalidAlignmentThrows) {
+    AllocationPolicy policy;
+    policy.alignment = 96;
+    EXPECT_THROW(Buffer(64, policy), std::invalid_argument);
+}
+
+TEST(BufferTest, MoveTransfersOwnership) {
+    Buffer a(256);
+    void* p = a.data();
+
+    Buffer b(std::move(a));
+    EXPECT_EQ(b.data(), p);
+    EXPECT_EQ(a.data(), nullptr);  // NOLINT(bugprone-use-after-move)
+
+    Buffer c;
+    c = std::move(b);
+    EXPECT_EQ(c.data(), p);
+    EXPECT_EQ(c.size(), 256);
+}
+
+TEST(BufferTest, FirstTouchPolicy) {
+    const AllocationPolicy policy = AllocationPolicy::numa_first_touch();
+    EXPECT_TRUE(policy.first_touch);
+    EXPECT_TRUE(policy.is_page_aligned());
+    EXPECT_FALSE(AllocationPolicy{}.first_touch);
+}
+
+// =============================================================================
+// Huge Page / Locking Tests
+// =============================================================================
+
+TEST(BufferTest, HeapReport) {
+    Buffer b(1024);
+    EXPECT_EQ(b.report().backing, Backing::Heap);
+    EXPECT_EQ(b.report().page_bytes, page_size());
+    EXPECT_FALSE(b.report().locked);
+
+    EXPECT_EQ(Buffer{}.report().backing, Backing::None);
+}
+
+TEST(BufferTest, HugePagesFallBack) {
+    // Whatever tier is granted, the block is mapped, page-aligned and usable
+    const std::size_t bytes = 3 * 1024 * 1024;
+    Buffer b(bytes, AllocationPolicy::huge(HugePages::Huge1G));
+    const AllocationReport& report = b.report();
+
+#ifdef __linux__
+    EXPECT_NE(report.backing, Backing::Heap);
+#endif
+    ASSERT_GE(b.size(), bytes);
+    EXPECT_EQ(b.size() % report.page_bytes, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % report.page_bytes, 0);
+
+    auto* bytes_ptr = static_cast<unsigned char*>(b.data());
+    bytes_ptr[0] = 1;
+    bytes_ptr[b.size() - 1] = 2;
+    EXPECT_EQ(bytes_ptr[b.size() - 1], 2);
+}
+
+TEST(BufferTest, TransparentHugePagesAreAligned) {
+    Buffer b(100, AllocationPolicy::huge(HugePages::Transparent));
+#ifdef __linux__
+    EXPECT_EQ(b.report().backing, Backing::Mapped);
+    EXPECT_EQ(b.report().page_bytes, page_size());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % (2u << 20), 0);
+    EXPECT_EQ(b.size(), 2u << 20);
+#endif
+}
+
+TEST(BufferTest, TransparentHugeBytesAreMeasured) {
+    Buffer b(4u << 20, AllocationPolicy::huge(HugePages::Transparent));
+    std::fill_n(static_cast<unsigned char*>(b.data()), b.size(), 1);
+
+    // Advice is only a request: whatever the kernel granted lies in the block
+    const std::size_t huge = b.transparent_huge_bytes();
+    EXPECT_LE(huge, b.size());
+    EXPECT_EQ(huge % (2u << 20), 0);
+
+    EXPECT_EQ(Buffer(1024).transparent_huge_bytes(), 0);
+}
+
+TEST(BufferTest, LockIsReported) {
+    AllocationPolicy policy;
+    policy.lock = true;
+    Buffer b(4096, policy);
+
+    // Locking may be refused by RLIMIT_MEMLOCK; the block is usable either way
+    ASSERT_NE(b.data(), nullptr);
+    static_cast<char*>(b.data())[0] = 'x';
+
+    Buffer moved(std::move(b));
+    EXPECT_EQ(b.report().backing, Backing::None);  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(moved.report().backing, Backing::Heap);
+}
+
+TEST(BufferTest, BackingNames) {
+    EXPECT_EQ(to_string(Backing::Huge2M), "2 MB huge pages");
+    EXPECT_EQ(to_string(Backing::Heap), "heap");
+    EXPECT_EQ(to_string(Backing::File), "memory-mapped file");
+}
+
+// =============================================================================
+// Out-of-Core Tests
+// =============================================================================
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(BufferTest, FileBackedBlock) {
+    const auto policy = AllocationPolicy::out_of_core(::testing::TempDir());
+    EXPECT_TRUE(policy.is_page_aligned());
+
+    Buffer b(3 * page_size() + 1, policy);
+    EXPECT_TRUE(b.file_backed());
+    EXPECT_EQ(b.report().backing, Backing::File);
+    EXPECT_EQ(b.size(), 4 * page_size());
+
+    // A fresh spill file reads as zeros
+    auto* values = static_cast<std::uint64_t*>(b.data());
+    const std::size_t n = b.size() / sizeof(std::uint64_t);
+    EXPECT_EQ(values[n - 1], 0u);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = i;
+    }
+
+    // Dropping pages of a file-backed block writes them back, it does not lose them
+    b.advise(0, b.size(), Advice::DontNeed);
+    b.advise(0, b.size(), Advice::WillNeed);
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+
+    Buffer moved(std::move(b));
+    EXPECT_TRUE(moved.file_backed());
+    EXPECT_FALSE(b.file_backed());
+}
+
+TEST(BufferTest, MissingSpillDirectoryThrows) {
+    const auto policy = AllocationPolicy::out_of_core("/nonexistent/vps-spill");
+    EXPECT_THROW(Buffer(1024, policy), std::system_error);
+}
+#endif
+
+TEST(BufferTest, DontNeedIgnoredInMemory) {
+    Buffer b(2 * page_size(), AllocationPolicy::huge(HugePages::Transparent));
+    auto* bytes = static_cast<std::uint8_t*>(b.data());
+    bytes[0] = 42;
+
+    b.advise(0, b.size(), Advice::DontNeed);
+
+    EXPECT_EQ(bytes[0], 42);
+}
+
+// =============================================================================
+// NUMA Topology Tests
+// =============================================================================
+
+TEST(NumaTest, ParseCpuList) {
+    EXPECT_EQ(parse_cpu_list("0-3,8,10-11\n"),
+              (std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpu_list("5"), (std::vector<unsigned>{5}));
+    EXPECT_TRUE(parse_cpu_list("").empty());
+}
+
+TEST(NumaTest, ParseCpuListRejectsMalformed) {
+    EXPECT_THROW((void)parse_cpu_list("1-"), std::invalid_argument);
+    EXPECT_THROW((void)parse_cpu_list("3-1"), std::invalid_argument);
+    EXPECT_THROW((void)parse_cpu_list("a,b"), std::invalid_argument);
+}
+
+TEST(NumaTest, HostHasAtLeastOneNode) {
+    const auto nodes = numa_nodes();
+    ASSERT_FALSE(nodes.empty());
+    for (const auto& node : nodes) {
+        EXPECT_FALSE(node.cpus.empty());
+    }
+}
+
+TEST(NumaTest, PinToOwnNode) {
+    const auto nodes = numa_nodes();
+    bool pinned = false;
+    bool pinned_empty = true;
+    // Pin a scratch thread so the test runner keeps its affinity
+    std::thread worker([&] {
+        pinned = pin_current_thread(nodes.front().cpus);
+        pinned_empty = pin_current_thread({});
+    });
+    worker.join();
+#ifdef __linux__
+    EXPECT_TRUE(pinned);
+#endif
+    EXPECT_FALSE(pinned_empty);
+}
+
+// =============================================================================
+// ISA Dispatch Tests
+// =============================================================================
+
+namespace {
+
+template <typename T>
+VPS_TARGET_CLONES void scale(T* values, std::size_t n, T factor) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] *= factor;
+    }
+}
+
+} // namespace
+
+TEST(IsaTest, Names) {
+    EXPECT_EQ(to_string(Isa::Baseline), "baseline");
+    EXPECT_EQ(to_string(Isa::Avx2), "avx2");
+    EXPECT_EQ(to_string(Isa::Avx512), "avx512");
+}
+
+TEST(IsaTest, KernelsRunOnTheCpu) {
+    // Dispatched kernels use exactly what the CPU offers; otherwise the
+    // binary could only have started on a CPU at least as wide
+    if (VPS_HAS_TARGET_CLONES) {
+        EXPECT_EQ(kernel_isa(), cpu_isa());
+    } else {
+        EXPECT_LE(static_cast<int>(kernel_isa()), static_cast<int>(cpu_isa()));
+    }
+}
+
+TEST(IsaTest, BlockIsWholeRegisters) {
+    EXPECT_EQ(kernel_block % simd_lanes<float>, 0u);
+    EXPECT_EQ(kernel_block % simd_lanes<std::uint8_t>, 0u);
+}
+
+TEST(IsaTest, ClonedFunctionRuns) {
+    std::vector<double> values(37, 2.0);
+    scale(values.data(), values.size(), 1.5);
+    for (const double v : values) {
+        EXPECT_DOUBLE_EQ(v, 3.0);
+    }
+}
+
+// =============================================================================
+// Step Arena Tests
+// =============================================================================
+
+TEST(StepArenaTest, AllocationsAreAligned) {
+    StepArena arena(1024);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(100, 64);
+    void* c = arena.allocate(8, 8);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 8, 0u);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(arena.upstream_allocations(), 1u);  // the block only
+}
+
+TEST(StepArenaTest, SteadyStateDoesNotAllocate) {
+    StepArena arena;
+    const auto one_step = [&] {
+        std::pmr::vector<double> weights(1000, 1.0, &arena);
+        std::pmr::vector<std::uint32_t> keys(5000, 0, &arena);
+        weights.resize(3000);
+    };
+
+    one_step();  // warm-up: everything overflows
+    const std::size_t warm = arena.upstream_allocations();
+    EXPECT_GT(warm, 0u);
+    arena.reset();
+    EXPECT_GE(arena.capacity(), arena.high_water());
+
+    const std::size_t sized = arena.upstream_allocations();
+    for (int step = 0; step < 10; ++step) {
+        arena.reset();
+        one_step();
+    }
+    EXPECT_EQ(arena.upstream_allocations(), sized);
+}
+
+TEST(StepArenaTest, ResetRewinds) {
+    StepArena arena(256);
+    void* first = arena.allocate(64, 64);
+    EXPECT_GE(arena.used(), 64u);
+
+    arena.reset();
+
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.allocate(64, 64), first);
+}
+
+TEST(StepArenaTest, ScopesNest) {
+    StepArena outer;
+    StepArena inner;
+    EXPECT_EQ(scratch(), std::pmr::get_default_resource());
+    {
+        ScratchScope a(outer);
+        EXPECT_EQ(scratch(), &outer);
+        {
+            ScratchScope b(inner);
+            EXPECT_EQ(scratch(), &inner);
+        }
+        EXPECT_EQ(scratch(), &outer);
+
+        // Other threads keep their own (default) scratch resource
+        std::pmr::memory_resource* seen = nullptr;
+        std::thread worker([&] { seen = scratch(); });
+        worker.join();
+        EXPECT_EQ(seen, std::pmr::get_default_resource());
+    }
+    EXPECT_EQ(scratch(), std::pmr::get_default_resource());
+}
+
+// =============================================================================
+// Task Pool Tests
+// =============================================================================
+
+namespace {
+
+/// @brief Two nodes of three workers each, all on the first usable CPU
+std::vector<NumaNode> two_test_nodes() {
+    const unsigned cpu = numa_nodes().front().cpus.front();
+    return {NumaNode{0, {cpu, cpu, cpu}}, NumaNode{1, {cpu, cpu, cpu}}};
+}
+
+} // namespace
+
+TEST(TaskPoolTest, WorkersFollowTopology) {
+    TaskPool pool(two_test_nodes());
+    EXPECT_EQ(pool.size(), 6u);
+    EXPECT_EQ(pool.node_of(0), 0u);
+    EXPECT_EQ(pool.node_of(5), 1u);
+    EXPECT_THROW(TaskPool(std::vector<NumaNode>{}), std::invalid_argument);
+}
+
+TEST(TaskPoolTest, ImbalancedLoopRunsEveryIndexOnce) {
+    TaskPool pool(two_test_nodes());
+    const std::size_t n = 5000;
+    std::vector<std::atomic<int>> hits(n);
+    std::vector<std::atomic<int>> per_worker(pool.size());
+
+    for (int round = 0; round < 3; ++round) {
+        pool.parallel_for(n, [&](std::size_t i) {
+            // The first few indices carry almost all of the work
+            volatile double sink = 0.0;
+            for (std::size_t k = 0; k < (i < 16 ? 20000u : 10u); ++k) {
+                sink = sink + static_cast<double>(k);
+            }
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+            per_worker[TaskPool::worker_index()].fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(hits[i].load(), 3) << i;
+    }
+    int total = 0;
+    for (const auto& count : per_worker) {
+        total += count.load();
+    }
+    EXPECT_EQ(total, 3 * static_cast<int>(n));
+}
+
+TEST(TaskPoolTest, NestedLoopRunsOnCaller) {
+    TaskPool pool(two_test_nodes());
+    std::atomic<int> mismatched{0};
+    std::atomic<int> inner{0};
+
+    pool.parallel_for(64, [&](std::size_t) {
+        const std::size_t outer = TaskPool::worker_index();
+        pool.parallel_for(8, [&](std::size_t) {
+            mismatched += TaskPool::worker_index() != outer ? 1 : 0;
+            ++inner;
+        });
+    });
+
+    EXPECT_EQ(inner.load(), 64 * 8);
+    EXPECT_EQ(mismatched.load(), 0);
+}
+
+TEST(TaskPoolTest, ExceptionReachesCaller) {
+    TaskPool pool(two_test_nodes());
+    EXPECT_THROW(pool.parallel_for(1000,
+                                   [](std::size_t i) {
+                                       if (i == 500) {
+                                           throw std::runtime_error("task failed");
+                                       }
+                                   }),
+                 std::runtime_error);
+
+    // The pool stays usable
+    std::atomic<std::size_t> sum{0};
+    pool.parallel_for(100, [&](std::size_t i) { sum += i; });
+    EXPECT_EQ(sum.load(), 4950u);
+}
+
+} // namespace vps::memory::test
@@ -0,0 +1,101 @@
+/// @file bench_particles.cpp
+/// @brief Throughput benchmarks for the particles module
+///
+/// Sizes span 10^6 to 10^9 points; the largest case needs ~24 GB of memory.
+/// Run a subset with --benchmark_filter, e.g. --benchmark_filter='/1000000$'.
+
+#include <vps/particles/particles.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr double dt = 0.1;
+
+void point_sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(10)->Range(1'000'000, 1'000'000'000)->UseRealTime();
+}
+
+void report_bytes(benchmark::State& state, std::size_t n) {
+    // One load of x and v, one store of x per point
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(3 * n * sizeof(double)));
+}
+
+// =============================================================================
+// Free streaming
+// =============================================================================
+
+/// Baseline: the original layout, plain std::vector without alignment or padding
+void BM_AdvancePositions_StdVector(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<double> x(n, 0.0);
+    std::vector<double> v(n, 1.0);
+
+    for (auto _ : state) {
+        double* xp = x.data();
+        const double* vp = v.data();
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp parallel for simd
+#endif
+        for (std::size_t i = 0; i < n; ++i) {
+            xp[i] += vp[i] * dt;
+        }
+        benchmark::ClobberMemory();
+    }
+    report_bytes(state, n);
+}
+BENCHMARK(BM_AdvancePositions_StdVector)->Apply(point_sizes);
+
+/// Aligned, padded Particles storage
+void BM_AdvancePositions_Particles(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    vps::particles::Particles p(n, 0.0, 1.0, 1.0);
+
+    for (auto _ : state) {
+        vps::particles::advance_positions(p, dt);
+        benchmark::ClobberMemory();
+    }
+    report_bytes(state, n);
+}
+BENCHMARK(BM_AdvancePositions_Particles)->Apply(point_sizes);
+
+// =============================================================================
+// Compaction
+// =============================================================================
+
+/// Removes every 10th point; the copy that restores the input is not timed
+template <bool Ordered>
+void BM_EraseIf(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    vps::particles::Particles source;
+    source.fill_with(n, [](std::size_t i) {
+        return std::array{static_cast<double>(i % 10), 1.0, 1.0};
+    });
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto p = source;
+        const auto x = p.x();
+        state.ResumeTiming();
+
+        const auto absorbed = [&](std::size_t i) { return x[i] == 0.0; };
+        if constexpr (Ordered) {
+            benchmark::DoNotOptimize(p.erase_if(absorbed));
+        } else {
+            benchmark::DoNotOptimize(p.erase_if_unordered(absorbed));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_EraseIf<true>)->RangeMultiplier(10)->Range(1'000'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_EraseIf<false>)->RangeMultiplier(10)->Range(1'000'000, 100'000'000)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,260 @@
+#ifndef VPS_PARTICLES_AOSOA_H
+#define VPS_PARTICLES_AOSOA_H
+
+/// @file aosoa.h
+/// @brief Array-of-Structs-of-Arrays (tiled) container for phase-space points
+///
+/// Pure SoA streams one array per attribute; a gather/scatter kernel that
+/// touches x, v, f and a field walks four or more distant address streams,
+/// which at very large N costs a TLB entry per stream per page. The tiled
+/// layout groups W consecutive points into one tile holding W x, then W v,
+/// then W f values:
+///
+/// @code
+///   | x[0..W) v[0..W) f[0..W) | x[W..2W) v[W..2W) f[W..2W) | ...
+///   ^ tile 0                  ^ tile 1
+/// @endcode
+///
+/// so all attributes of a point sit in the same few cache lines and pages,
+/// while each attribute of a tile is still a contiguous SIMD-width vector.
+
+#include <vps/memory/aligned_allocator.h>
+#include <vps/memory/buffer.h>
+#include <vps/particles/particles.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace vps::particles {
+
+/// @brief Tiled (AoSoA) container of phase-space points
+/// @tparam T Floating-point type of x, v and f
+/// @tparam W Points per tile (SIMD width), typically 8 or 16
+///
+/// Kernels iterate tiles(); each Tile exposes fixed-width arrays, so inner
+/// loops have a compile-time trip count and no remainder:
+///
+/// @code
+/// TiledParticles<double, 8> p(particles);
+/// for (auto& tile : p.tiles()) {
+///     for (std::size_t l = 0; l < 8; ++l) tile.x[l] += tile.v[l] * dt;
+/// }
+/// @endcode
+///
+/// Lanes of the last tile beyond size() are padding: element-wise kernels
+/// may update them, reductions and scatters must stop at size().
+template <std::floating_point T, std::size_t W>
+class TiledParticles {
+    static_assert(W > 0 && (W & (W - 1)) == 0, "Tile width must be a power of two");
+
+public:
+    // =========================================================================
+    // Type Aliases
+    // =========================================================================
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// @brief Points per tile
+    static constexpr size_type width = W;
+
+    /// @brief W points, stored attribute by attribute
+    struct alignas(memory::default_alignment) Tile {
+        std::array<T, W> x;  ///< Positions
+        std::array<T, W> v;  ///< Velocities
+        std::array<T, W> f;  ///< Distribution function values
+    };
+
+    // =========================================================================
+    // Constructors
+    // =========================================================================
+
+    /// @brief Default constructor - creates empty container
+    TiledParticles() = default;
+
+    /// @brief Construct with reserved capacity (in points)
+    explicit TiledParticles(size_type capacity) { reserve(capacity); }
+
+    /// @brief Construct by re-tiling a SoA container
+    explicit TiledParticles(const BasicParticles<T>& particles) {
+        resize(particles.size());
+        for (size_type i = 0; i < particles.size(); ++i) {
+            x(i) = particles.x(i);
+            v(i) = particles.v(i);
+            f(i) = particles.f(i);
+        }
+    }
+
+    TiledParticles(const TiledParticles& other)
+        : storage_(other.storage_.size(), other.storage_.policy())
+        , size_(other.size_)
+        , tile_capacity_(other.tile_capacity_)
+    {
+        if (other.storage_.size() > 0) {
+            std::memcpy(storage_.data(), other.storage_.data(), other.storage_.size());
+        }
+    }
+
+    TiledParticles(TiledParticles&& other) noexcept
+        : storage_(std::move(other.storage_))
+        , size_(std::exchange(other.size_, 0))
+        , tile_capacity_(std::exchange(other.tile_capacity_, 0))
+    {}
+
+    TiledParticles& operator=(const TiledParticles& other) {
+        if (this != &other) {
+            TiledParticles copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    TiledParticles& operator=(TiledParticles&& other) noexcept {
+        storage_ = std::move(other.storage_);
+        size_ = std::exchange(other.size_, 0);
+        tile_capacity_ = std::exchange(other.tile_capacity_, 0);
+        return *this;
+    }
+
+    ~TiledParticles() = default;
+
+    // =========================================================================
+    // Capacity
+    // =========================================================================
+
+    /// @brief Returns the number of phase-space points
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+
+    /// @brief Returns the number of tiles in use (ceil(size / W))
+    [[nodiscard]] size_type n_tiles() const noexcept { return (size_ + W - 1) / W; }
+
+    /// @brief Returns the capacity in points (a multiple of W)
+    [[nodiscard]] size_type capacity() const noexcept { return tile_capacity_ * W; }
+
+    /// @brief Checks if the container is empty
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Reserves memory for at least n points
+    void reserve(size_type n) {
+        const size_type tiles = (n + W - 1) / W;
+        if (tiles > tile_capacity_) {
+            reallocate(tiles);
+        }
+    }
+
+    /// @brief Resizes to n points; new points are zero
+    void resize(size_type n) {
+        const size_type old_tiles = n_tiles();
+        const size_type new_tiles = (n + W - 1) / W;
+        if (new_tiles > tile_capacity_) {
+            reallocate(std::max(new_tiles, 2 * tile_capacity_));
+        }
+        // Fresh tiles are zeroed; points re-exposed inside a live tile are cleared
+        std::fill(tile_data() + old_tiles, tile_data() + std::max(old_tiles, new_tiles), Tile{});
+        for (size_type i = size_; i < std::min(n, old_tiles * W); ++i) {
+            Tile& tile = tile_data()[i / W];
+            tile.x[i % W] = tile.v[i % W] = tile.f[i % W] = T{};
+        }
+        size_ = n;
+    }
+
+    /// @brief Clears all points (capacity is kept)
+    void clear() noexcept { size_ = 0; }
+
+    // =========================================================================
+    // Element Access
+    // =========================================================================
+
+    /// @brief Access x value at index i
+    [[nodiscard]] T& x(size_type i) noexcept { return tile_of(i).x[i % W]; }
+    [[nodiscard]] const T& x(size_type i) const noexcept { return tile_of(i).x[i % W]; }
+
+    /// @brief Access v value at index i
+    [[nodiscard]] T& v(size_type i) noexcept { return tile_of(i).v[i % W]; }
+    [[nodiscard]] const T& v(size_type i) const noexcept { return tile_of(i).v[i % W]; }
+
+    /// @brief Access f value at index i
+    [[nodiscard]] T& f(size_type i) noexcept { return tile_of(i).f[i % W]; }
+    [[nodiscard]] const T& f(size_type i) const noexcept { return tile_of(i).f[i % W]; }
+
+    /// @brief Returns the tiles in use; the last one may be partially filled
+    [[nodiscard]] std::span<Tile> tiles() noexcept { return {tile_data(), n_tiles()}; }
+    [[nodiscard]] std::span<const Tile> tiles() const noexcept {
+        return {tile_data(), n_tiles()};
+    }
+
+    // =========================================================================
+    // Modifiers
+    // =========================================================================
+
+    /// @brief Adds a new phase-space point
+    void push_back(T x_val, T v_val, T f_val) {
+        const size_type i = size_;
+        resize(i + 1);
+        x(i) = x_val;
+        v(i) = v_val;
+        f(i) = f_val;
+    }
+
+private:
+    [[nodiscard]] Tile* tile_data() noexcept { return static_cast<Tile*>(storage_.data()); }
+    [[nodiscard]] const Tile* tile_data() const noexcept {
+        return static_cast<const Tile*>(storage_.data());
+    }
+
+    [[nodiscard]] Tile& tile_of(size_type i) noexcept {
+        assert(i < size_ && "Index out of bounds");
+        return tile_data()[i / W];
+    }
+    [[nodiscard]] const Tile& tile_of(size_type i) const noexcept {
+        assert(i < size_ && "Index out of bounds");
+        return tile_data()[i / W];
+    }
+
+    /// @brief The single growth path: moves all tiles into a new slab
+    void reallocate(size_type new_tiles) {
+        memory::Buffer slab(new_tiles * sizeof(Tile), storage_.policy());
+        if (n_tiles() > 0) {
+            std::memcpy(slab.data(), storage_.data(), n_tiles() * sizeof(Tile));
+        }
+        storage_ = std::move(slab);
+        tile_capacity_ = new_tiles;
+    }
+
+    memory::Buffer storage_;       ///< Slab of tiles
+    size_type size_ = 0;           ///< Number of live points
+    size_type tile_capacity_ = 0;  ///< Tiles allocated
+};
+
+// =============================================================================
+// Free Functions
+// =============================================================================
+
+/// @brief Advances tiled particle positions by velocity * dt (free streaming)
+///
+/// Parallel over tiles, fixed-width SIMD inside each tile.
+template <std::floating_point T, std::size_t W>
+void advance_positions(TiledParticles<T, W>& particles, std::type_identity_t<T> dt) {
+    const auto tiles = particles.tiles();
+    const auto n = tiles.size();
+
+    parallel_for(n, [&](std::size_t t) {
+        auto& tile = tiles[t];
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp simd
+#endif
+        for (std::size_t l = 0; l < W; ++l) {
+            tile.x[l] += tile.v[l] * dt;
+        }
+    }, W);
+}
+
+} // namespace vps::particles
+
+#endif // VPS_PARTICLES_AOSOA_H
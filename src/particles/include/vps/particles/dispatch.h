@@ -0,0 +1,166 @@
+#ifndef VPS_PARTICLES_DISPATCH_H
+#define VPS_PARTICLES_DISPATCH_H
+
+/// @file dispatch.h
+/// @brief Parallel driver for runtime-dispatched SIMD loops
+///
+/// Loops marked VPS_TARGET_CLONES (see vps/memory/isa.h) must not contain
+/// the OpenMP work sharing themselves, since the outlined region would be
+/// compiled for the baseline ISA only. for_each_block splits a range into
+/// blocks of memory::kernel_block points and hands each block to a cloned
+/// serial loop:
+///
+/// @code
+/// template <std::floating_point T>
+/// VPS_TARGET_CLONES void kick_block(T* v, std::size_t n, T dv) noexcept {
+///     #pragma omp simd
+///     for (std::size_t i = 0; i < n; ++i) v[i] += dv;
+/// }
+///
+/// for_each_block(n, [&](std::size_t first, std::size_t count) {
+///     kick_block(v + first, count, dv);
+/// });
+/// @endcode
+///
+/// Forking a team costs microseconds, more than a whole sweep over a few
+/// thousand points. Every sweep therefore asks team_size() how many
+/// threads its size pays for: each thread must get at least
+/// parallel_grain() points, and below two grains the loop runs serially on
+/// the caller. The grain is measured once per process (fork/join latency
+/// over the per-point cost of a streaming loop) unless it is set through
+/// set_parallel_grain() or the VPS_PARALLEL_GRAIN environment variable.
+
+#include <vps/memory/isa.h>
+#include <vps/memory/task_pool.h>
+
+#include <algorithm>
+#include <cstddef>
+
+#ifdef VPS_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace vps::particles {
+
+/// @brief Returns how many threads a kernel sweep may run on
+[[nodiscard]] inline std::size_t max_workers() {
+#if defined(VPS_ENABLE_TASKS)
+    return memory::task_pool().size();
+#elif defined(VPS_ENABLE_OPENMP)
+    return static_cast<std::size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+}
+
+/// @brief Returns the calling thread's index in [0, max_workers()) within a sweep
+[[nodiscard]] inline std::size_t worker_id() noexcept {
+#if defined(VPS_ENABLE_TASKS)
+    return memory::TaskPool::worker_index();
+#elif defined(VPS_ENABLE_OPENMP)
+    return static_cast<std::size_t>(omp_get_thread_num());
+#else
+    return 0;
+#endif
+}
+
+// =============================================================================
+// Granularity
+// =============================================================================
+
+/// @brief Returns the fewest points worth handing to one more thread
+///
+/// Configured on first use: from VPS_PARALLEL_GRAIN if set, else measured
+/// by calibrate_parallel_grain().
+[[nodiscard]] std::size_t parallel_grain();
+
+/// @brief Overrides the grain (e.g. from a parameter-scan configuration)
+/// @param points Minimum points per thread; 0 is treated as 1
+void set_parallel_grain(std::size_t points);
+
+/// @brief Measures fork/join latency and per-point cost and sets the grain
+/// @return The new grain: points a streaming loop takes as long as one fork/join
+std::size_t calibrate_parallel_grain();
+
+/// @brief Returns how many threads a sweep over points should use
+///
+/// points / parallel_grain(), clamped to [1, max_workers()]; 1 means the
+/// sweep runs serially.
+[[nodiscard]] std::size_t team_size(std::size_t points);
+
+/// @brief Returns true if a sweep over points should run in parallel
+///
+/// For the OpenMP reductions that cannot go through parallel_for:
+/// `#pragma omp parallel for if (run_parallel(n))
+/// num_threads(static_cast<int>(team_size(n)))`.
+[[nodiscard]] inline bool run_parallel(std::size_t points) {
+    return team_size(points) > 1;
+}
+
+// =============================================================================
+// Parallel Loops
+// =============================================================================
+
+/// @brief Calls fn(i) for every i in [0, n) on the kernel backend
+/// @param item_points Points of work per index, for team_size()
+///
+/// Built with VPS_ENABLE_TASKS, the indices run on memory::task_pool(),
+/// where idle workers steal from busy ones; otherwise on an OpenMP loop
+/// with a static schedule. The team is sized by team_size(n * item_points),
+/// so small loops run serially. Called from inside a parallel region (a
+/// kernel on one work item of a larger sweep), the loop also runs serially
+/// on the calling thread instead of opening a nested region.
+template <typename Fn>
+void parallel_for(std::size_t n, Fn&& fn, std::size_t item_points = 1) {
+#ifdef VPS_ENABLE_OPENMP
+    const bool nested = omp_in_parallel() != 0;
+#else
+    const bool nested = false;
+#endif
+    const std::size_t team = nested ? 1 : std::min(team_size(n * item_points), n);
+    if (team > 1) {
+#if defined(VPS_ENABLE_TASKS)
+        if (team == max_workers()) {
+            memory::task_pool().parallel_for(n, fn);
+        } else {
+            // Fewer, larger tasks: one contiguous share per team member
+            memory::task_pool().parallel_for(team, [&](std::size_t t) {
+                for (std::size_t i = n * t / team; i < n * (t + 1) / team; ++i) {
+                    fn(i);
+                }
+            });
+        }
+        return;
+#elif defined(VPS_ENABLE_OPENMP)
+        #pragma omp parallel for schedule(static) num_threads(static_cast<int>(team))
+        for (std::size_t i = 0; i < n; ++i) {
+            fn(i);
+        }
+        return;
+#endif
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        fn(i);
+    }
+}
+
+/// @brief Calls fn(first, count) for consecutive blocks covering [0, n)
+///
+/// Blocks go through parallel_for: with OpenMP each thread sweeps a
+/// contiguous range close to the one it first-touched, with the task pool
+/// workers start from the same split and rebalance by stealing. Every
+/// block but the last has memory::kernel_block points, and block starts
+/// keep the alignment of an aligned column.
+template <typename Fn>
+void for_each_block(std::size_t n, Fn&& fn) {
+    constexpr std::size_t block = memory::kernel_block;
+    const std::size_t n_blocks = (n + block - 1) / block;
+    parallel_for(n_blocks, [&](std::size_t b) {
+        const std::size_t first = b * block;
+        fn(first, std::min(block, n - first));
+    }, block);
+}
+
+} // namespace vps::particles
+
+#endif // VPS_PARTICLES_DISPATCH_H
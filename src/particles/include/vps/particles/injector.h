@@ -0,0 +1,126 @@
+#ifndef VPS_PARTICLES_INJECTOR_H
+#define VPS_PARTICLES_INJECTOR_H
+
+/// @file injector.h
+/// @brief Concurrent point injection with one bulk merge per step
+///
+/// Sources and injecting boundaries create points from many threads at
+/// once, but Particles::push_back may reallocate and is not thread-safe.
+/// An Injector gives every thread its own lane, a Particles block only that
+/// thread appends to, so pushes need no locks or atomics. At the end of
+/// the step merge_into() grows the target once and copies all lanes into
+/// it in parallel, one memcpy per lane and column. Lanes keep their
+/// capacity, so a steady injection rate stops allocating after warm-up.
+///
+/// @code
+/// Injector source;
+/// #pragma omp parallel for
+/// for (std::size_t c = 0; c < n_cells; ++c) {
+///     if (emits(c)) source.push(grid.cell_center(c), v0, w);
+/// }
+/// source.merge_into(particles);
+/// @endcode
+
+#include <vps/memory/aligned_allocator.h>
+#include <vps/particles/dispatch.h>
+#include <vps/particles/particles.h>
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+#ifdef VPS_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace vps::particles {
+
+/// @brief Per-thread buffers of new points, merged into a container in bulk
+/// @tparam T Floating-point type of x, v and f
+template <std::floating_point T>
+class BasicInjector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using particles_type = BasicParticles<T>;
+
+    /// @brief Create one lane per thread
+    /// @param n_lanes Number of lanes; 0 selects one per kernel worker
+    ///        (max_workers(), or the OpenMP team size if larger)
+    explicit BasicInjector(size_type n_lanes = 0);
+
+    /// @brief Returns the number of lanes
+    [[nodiscard]] size_type n_lanes() const noexcept;
+
+    /// @brief Returns the number of points waiting to be merged
+    ///
+    /// Not synchronized with concurrent pushes; call between regions.
+    [[nodiscard]] size_type size() const noexcept;
+
+    /// @brief Returns true if no points are waiting
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// @brief Adds a point to the calling thread's lane
+    ///
+    /// Safe to call concurrently from the threads of one parallel region or
+    /// kernel sweep: the lane is the OpenMP thread number inside an OpenMP
+    /// region, else worker_id() (the task pool worker with
+    /// VPS_ENABLE_TASKS), 0 outside both.
+    void push(value_type x_val, value_type v_val, value_type f_val) {
+        push(lane_id(), x_val, v_val, f_val);
+    }
+
+    /// @brief Adds a point to an explicit lane
+    ///
+    /// For threads numbered neither by OpenMP nor by the kernel backend:
+    /// each lane must be used by at most one thread at a time.
+    void push(size_type lane, value_type x_val, value_type v_val, value_type f_val) {
+        assert(lane < lanes_.size() && "Injector lane out of range");
+        lanes_[lane].points.push_back(x_val, v_val, f_val);
+    }
+
+    /// @brief Returns the points waiting in one lane
+    [[nodiscard]] const particles_type& lane(size_type i) const noexcept;
+
+    /// @brief Appends every waiting point to particles and empties the lanes
+    /// @return Number of points appended
+    ///
+    /// particles grows at most once; lanes are then copied in parallel in
+    /// lane order, after the existing points. Call outside parallel regions.
+    size_type merge_into(particles_type& particles);
+
+    /// @brief Drops every waiting point, keeping the lanes' capacity
+    void clear() noexcept;
+
+private:
+    /// @brief One thread's buffer, on its own cache lines
+    struct alignas(memory::default_alignment) Lane {
+        particles_type points;
+    };
+
+    [[nodiscard]] static size_type lane_id() noexcept {
+#if defined(VPS_ENABLE_TASKS) && defined(VPS_ENABLE_OPENMP)
+        // The caller's own OpenMP region rather than a sweep on the pool
+        if (omp_in_parallel() != 0) {
+            return static_cast<size_type>(omp_get_thread_num());
+        }
+#endif
+        return worker_id();
+    }
+
+    std::vector<Lane> lanes_;
+};
+
+/// @brief Double-precision injector (the default)
+using Injector = BasicInjector<double>;
+
+/// @brief Single-precision injector
+using InjectorF = BasicInjector<float>;
+
+extern template class BasicInjector<float>;
+extern template class BasicInjector<double>;
+
+} // namespace vps::particles
+
+#endif // VPS_PARTICLES_INJECTOR_H
@@ -0,0 +1,117 @@
+#ifndef VPS_PARTICLES_MIXED_PARTICLES_H
+#define VPS_PARTICLES_MIXED_PARTICLES_H
+
+/// @file mixed_particles.h
+/// @brief Phase-space points with cell-relative single-precision positions
+///
+/// Storing absolute positions as float loses sub-cell resolution far from
+/// the origin. MixedParticles instead keeps the index of the owning cell and
+/// the offset inside that cell (in units of dx, in [0, 1)), so float
+/// positions stay accurate on any domain while each point costs 16 bytes
+/// instead of the 24 of double x/v/f. Deposits read the cell index directly
+/// and accumulate in double (see vps/kernels/deposit.h).
+
+#include <vps/particles/soa.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace vps::particles {
+
+/// @brief SoA container of (cell, offset, v, f) phase-space points
+///
+/// All four columns share one slab (see soa.h).
+///
+/// @code
+/// MixedParticles p;
+/// p.push_back(3, 0.25f, 1.0f, 0.1f);  // x = x_min + 3.25 * dx
+/// @endcode
+class MixedParticles {
+public:
+    // =========================================================================
+    // Type Aliases
+    // =========================================================================
+    using value_type = float;
+    using cell_type = columns::Cell::value_type;
+    using size_type = std::size_t;
+    using storage_type = SoA<columns::Cell, columns::Offset<float>, columns::V<float>,
+                             columns::F<float>>;
+
+    // =========================================================================
+    // Constructors
+    // =========================================================================
+
+    /// @brief Default constructor - creates empty container
+    MixedParticles() = default;
+
+    /// @brief Construct with reserved capacity
+    /// @param capacity Initial capacity to reserve
+    explicit MixedParticles(size_type capacity);
+
+    // =========================================================================
+    // Capacity
+    // =========================================================================
+
+    /// @brief Returns the number of phase-space points
+    [[nodiscard]] size_type size() const noexcept;
+
+    /// @brief Checks if the container is empty
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// @brief Reserves memory for at least n points
+    void reserve(size_type n);
+
+    /// @brief Resizes the container to contain n points (new points zeroed)
+    void resize(size_type n);
+
+    /// @brief Clears all points
+    void clear() noexcept;
+
+    // =========================================================================
+    // Element Access - Span-based
+    // =========================================================================
+
+    /// @brief Returns a span over the owning cell indices
+    [[nodiscard]] std::span<cell_type> cell() noexcept;
+    [[nodiscard]] std::span<const cell_type> cell() const noexcept;
+
+    /// @brief Returns a span over in-cell offsets, in units of dx, in [0, 1)
+    [[nodiscard]] std::span<value_type> offset() noexcept;
+    [[nodiscard]] std::span<const value_type> offset() const noexcept;
+
+    /// @brief Returns a span over all v (velocity) values
+    [[nodiscard]] std::span<value_type> v() noexcept;
+    [[nodiscard]] std::span<const value_type> v() const noexcept;
+
+    /// @brief Returns a span over all f (distribution function) values
+    [[nodiscard]] std::span<value_type> f() noexcept;
+    [[nodiscard]] std::span<const value_type> f() const noexcept;
+
+    // =========================================================================
+    // Modifiers
+    // =========================================================================
+
+    /// @brief Adds a new phase-space point
+    /// @param cell_val Owning cell index
+    /// @param offset_val Offset inside the cell in units of dx, in [0, 1)
+    /// @param v_val Velocity value
+    /// @param f_val Distribution function value
+    void push_back(cell_type cell_val, value_type offset_val, value_type v_val,
+                   value_type f_val);
+
+    // =========================================================================
+    // Schema Access
+    // =========================================================================
+
+    /// @brief Returns the underlying SoA, for column-generic kernels
+    [[nodiscard]] storage_type& soa() noexcept { return data_; }
+    [[nodiscard]] const storage_type& soa() const noexcept { return data_; }
+
+private:
+    storage_type data_;  ///< Slab holding cell, offset, v and f
+};
+
+} // namespace vps::particles
+
+#endif // VPS_PARTICLES_MIXED_PARTICLES_H
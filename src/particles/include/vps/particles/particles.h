@@ -10,14 +10,30 @@
 /// - Efficient SIMD vectorization
 /// - Cache-friendly access patterns
 /// - Easy parallelization with OpenMP
+///
+/// The container and its kernels are templated on precision: Particles
+/// stores doubles, ParticlesF stores floats and halves the bytes moved per
+/// point in bandwidth-bound pushes.
+///
+/// Every array starts on a memory::default_alignment boundary and is padded
+/// to a whole number of SIMD lanes, so kernels can sweep the padded range
+/// with aligned loads and no remainder loop.
+
+#include <vps/memory/aligned_allocator.h>
+#include <vps/memory/buffer.h>
+#include <vps/particles/soa.h>
 
+#include <concepts>
 #include <cstddef>
+#include <memory>
 #include <span>
-#include <vector>
+#include <type_traits>
+#include <utility>
 
 namespace vps::particles {
 
 /// @brief Struct-of-Arrays container for phase-space points
+/// @tparam T Floating-point type of x, v and f
 ///
 /// Each phase-space point has three properties:
 /// - x: position in configuration space
@@ -25,7 +41,17 @@ namespace vps::particles {
 /// - f: distribution function value (weight)
 ///
 /// Instead of storing an array of structs {x, v, f}, we store three
-/// separate arrays for better memory access patterns.
+/// separate arrays for better memory access patterns. The three arrays are
+/// fixed-offset sub-arrays of one allocation:
+///
+/// @code
+///   | x[0 .. capacity) | v[0 .. capacity) | f[0 .. capacity) |
+///   ^ slab start         ^ + stride          ^ + 2 * stride
+/// @endcode
+///
+/// so growth is a single reallocation and copy for all three. The storage
+/// is the SoA schema ParticleSchema<T>; populations needing extra columns
+/// (species, tracer IDs, ...) use ParticleSchema<T, Extra...> directly.
 ///
 /// @code
 /// Particles p(1000);  // Reserve space for 1000 points
@@ -33,40 +59,66 @@ namespace vps::particles {
 ///
 /// // Access all positions for vectorized operations
 /// auto positions = p.x();
+///
+/// // Padded, alignment-annotated range for hot loops
+/// auto xs = p.aligned_x();  // xs.size() == p.padded_size()
 /// @endcode
-class Particles {
+template <std::floating_point T>
+class BasicParticles {
 public:
     // =========================================================================
     // Type Aliases
     // =========================================================================
-    using value_type = double;
+    using value_type = T;
     using size_type = std::size_t;
-    using container_type = std::vector<value_type>;
+    using storage_type = ParticleSchema<T>;
+
+    /// @brief Byte alignment of x/v/f data
+    static constexpr std::size_t alignment = storage_type::alignment;
+
+    /// @brief Number of values per aligned block; padded_size() is a multiple of this
+    static constexpr size_type lanes = storage_type::lanes;
 
     // =========================================================================
     // Constructors
     // =========================================================================
     
     /// @brief Default constructor - creates empty container
-    Particles() = default;
+    BasicParticles() = default;
 
     /// @brief Construct with reserved capacity
     /// @param capacity Initial capacity to reserve
-    explicit Particles(size_type capacity);
+    explicit BasicParticles(size_type capacity);
+
+    /// @brief Construct with reserved capacity and an allocation policy
+    /// @param capacity Initial capacity to reserve
+    /// @param policy How the slab is allocated, e.g. AllocationPolicy::page_aligned()
+    ///
+    /// With a page-aligned policy each of x, v and f also starts on a page
+    /// boundary, so huge-page advice and mmap backing apply per array.
+    BasicParticles(size_type capacity, memory::AllocationPolicy policy);
 
     /// @brief Construct with initial size and default values
     /// @param size Number of points to create
     /// @param x_val Default x value
     /// @param v_val Default v value  
     /// @param f_val Default f value
-    Particles(size_type size, value_type x_val, value_type v_val, value_type f_val);
+    BasicParticles(size_type size, value_type x_val, value_type v_val, value_type f_val);
+
+    /// @brief Construct with initial size, default values and an allocation policy
+    ///
+    /// With AllocationPolicy::numa_first_touch() the pages are placed by the
+    /// threads that later run the kernels instead of all on the calling
+    /// thread's NUMA node; the zeroing pass uses the kernels' block partition.
+    BasicParticles(size_type size, value_type x_val, value_type v_val, value_type f_val,
+                   memory::AllocationPolicy policy);
 
-    // Default copy/move operations
-    Particles(const Particles&) = default;
-    Particles(Particles&&) noexcept = default;
-    Particles& operator=(const Particles&) = default;
-    Particles& operator=(Particles&&) noexcept = default;
-    ~Particles() = default;
+    // Deep copy, size-resetting move
+    BasicParticles(const BasicParticles&) = default;
+    BasicParticles(BasicParticles&&) noexcept = default;
+    BasicParticles& operator=(const BasicParticles&) = default;
+    BasicParticles& operator=(BasicParticles&&) noexcept = default;
+    ~BasicParticles() = default;
 
     // =========================================================================
     // Capacity
@@ -75,14 +127,40 @@ public:
     /// @brief Returns the number of phase-space points
     [[nodiscard]] size_type size() const noexcept;
     
-    /// @brief Returns the current capacity
+    /// @brief Returns size() rounded up to a multiple of lanes
+    [[nodiscard]] size_type padded_size() const noexcept;
+
+    /// @brief Returns the current capacity (a multiple of lanes)
     [[nodiscard]] size_type capacity() const noexcept;
+
+    /// @brief Returns the allocation policy of the slab
+    [[nodiscard]] const memory::AllocationPolicy& allocation_policy() const noexcept;
+
+    /// @brief Returns how the slab was actually obtained (huge pages, locked, ...)
+    [[nodiscard]] const memory::AllocationReport& allocation_report() const noexcept;
     
     /// @brief Checks if the container is empty
     [[nodiscard]] bool empty() const noexcept;
+
+    /// @brief Returns true if x, v and f live in a memory-mapped spill file
+    ///
+    /// Created with AllocationPolicy::out_of_core(directory); kernels then
+    /// sweep the arrays chunk by chunk through stream().
+    [[nodiscard]] bool file_backed() const noexcept { return data_.file_backed(); }
+
+    /// @brief Calls fn(first, last) over chunks of [0, size()) (see SoA::stream)
+    ///
+    /// File-backed containers prefetch the next chunk and release the
+    /// current one around each call; in memory fn(0, size()) runs once.
+    template <typename Fn>
+    void stream(Fn&& fn, size_type chunk_points = 0) const {
+        data_.stream(std::forward<Fn>(fn), chunk_points);
+    }
     
     /// @brief Reserves memory for at least n points
     /// @param n Minimum capacity to reserve
+    ///
+    /// Reallocates the slab once and copies x, v and f into it.
     void reserve(size_type n);
     
     /// @brief Resizes the container to contain n points
@@ -91,6 +169,12 @@ public:
     
     /// @brief Resizes with specified default values
     void resize(size_type n, value_type x_val, value_type v_val, value_type f_val);
+
+    /// @brief Resizes to n points without writing the new points
+    ///
+    /// New x/v/f values are unspecified until written; use before a bulk
+    /// write pass such as fill_with() or direct span writes.
+    void resize_uninitialized(size_type n);
     
     /// @brief Clears all points
     void clear() noexcept;
@@ -111,6 +195,38 @@ public:
     [[nodiscard]] std::span<value_type> f() noexcept;
     [[nodiscard]] std::span<const value_type> f() const noexcept;
 
+    // =========================================================================
+    // Element Access - Aligned, padded spans (for vectorized kernels)
+    // =========================================================================
+    //
+    // These cover padded_size() elements and carry an assume_aligned hint.
+    // Values in [size(), padded_size()) are unspecified: element-wise kernels
+    // may read and overwrite them, reductions and scatters must stop at size().
+
+    /// @brief Returns the padded, aligned span over x values
+    [[nodiscard]] std::span<value_type> aligned_x() noexcept {
+        return data_.template aligned<columns::X<T>>();
+    }
+    [[nodiscard]] std::span<const value_type> aligned_x() const noexcept {
+        return data_.template aligned<columns::X<T>>();
+    }
+
+    /// @brief Returns the padded, aligned span over v values
+    [[nodiscard]] std::span<value_type> aligned_v() noexcept {
+        return data_.template aligned<columns::V<T>>();
+    }
+    [[nodiscard]] std::span<const value_type> aligned_v() const noexcept {
+        return data_.template aligned<columns::V<T>>();
+    }
+
+    /// @brief Returns the padded, aligned span over f values
+    [[nodiscard]] std::span<value_type> aligned_f() noexcept {
+        return data_.template aligned<columns::F<T>>();
+    }
+    [[nodiscard]] std::span<const value_type> aligned_f() const noexcept {
+        return data_.template aligned<columns::F<T>>();
+    }
+
     // =========================================================================
     // Element Access - Index-based
     // =========================================================================
@@ -140,6 +256,53 @@ public:
     /// @brief Removes the last point
     void pop_back();
 
+    /// @brief Appends a block of points from three equally long spans
+    ///
+    /// One reallocation at most, then one memcpy per array.
+    void append(std::span<const value_type> x_vals, std::span<const value_type> v_vals,
+                std::span<const value_type> f_vals);
+
+    /// @brief Replaces the contents with n points produced by a generator
+    /// @param n Number of points
+    /// @param gen Callable gen(i) returning (x, v, f) for point i as anything
+    ///            that destructures into three values (tuple, array, struct)
+    ///
+    /// The points are written in one parallel pass (OpenMP when enabled), so
+    /// gen must be safe to call concurrently for distinct i.
+    ///
+    /// @code
+    /// p.fill_with(n, [&](std::size_t i) {
+    ///     return std::tuple{x0 + i * dx, v0, 1.0};
+    /// });
+    /// @endcode
+    template <typename Generator>
+    void fill_with(size_type n, Generator gen);
+
+    /// @brief Removes every point i for which pred(i) is true, preserving order
+    /// @return Number of points removed
+    ///
+    /// pred is evaluated once per point in parallel before any point moves,
+    /// so it may read x, v and f through captured spans. Survivors are
+    /// packed in place across all arrays.
+    ///
+    /// @code
+    /// const auto x = p.x();
+    /// p.erase_if([&](std::size_t i) { return x[i] < x_min || x[i] >= x_max; });
+    /// @endcode
+    template <typename Predicate>
+    size_type erase_if(Predicate pred) {
+        return data_.erase_if(pred);
+    }
+
+    /// @brief Like erase_if(), but fills holes from the tail (order not kept)
+    ///
+    /// Moves only as many points as were removed below the new size; use it
+    /// whenever the order of points does not matter (e.g. no CellIndex).
+    template <typename Predicate>
+    size_type erase_if_unordered(Predicate pred) {
+        return data_.erase_if_unordered(pred);
+    }
+
     // =========================================================================
     // Raw Data Access (for interop with C APIs, MPI, etc.)
     // =========================================================================
@@ -156,12 +319,45 @@ public:
     [[nodiscard]] value_type* f_data() noexcept;
     [[nodiscard]] const value_type* f_data() const noexcept;
 
+    // =========================================================================
+    // Schema Access
+    // =========================================================================
+
+    /// @brief Returns the underlying SoA, for column-generic kernels
+    [[nodiscard]] storage_type& soa() noexcept { return data_; }
+    [[nodiscard]] const storage_type& soa() const noexcept { return data_; }
+
 private:
-    container_type x_;  ///< Position values
-    container_type v_;  ///< Velocity values
-    container_type f_;  ///< Distribution function values
+    storage_type data_;  ///< Slab holding x, v and f
 };
 
+/// @brief Double-precision phase-space points (the default)
+using Particles = BasicParticles<double>;
+
+/// @brief Single-precision phase-space points
+using ParticlesF = BasicParticles<float>;
+
+extern template class BasicParticles<float>;
+extern template class BasicParticles<double>;
+
+template <std::floating_point T>
+template <typename Generator>
+void BasicParticles<T>::fill_with(size_type n, Generator gen) {
+    data_.resize_uninitialized(n);
+    value_type* xs = x_data();
+    value_type* vs = v_data();
+    value_type* fs = f_data();
+
+    for_each_block(n, [&](size_type first, size_type count) {
+        for (size_type i = first; i < first + count; ++i) {
+            const auto [x_val, v_val, f_val] = gen(i);
+            xs[i] = static_cast<value_type>(x_val);
+            vs[i] = static_cast<value_type>(v_val);
+            fs[i] = static_cast<value_type>(f_val);
+        }
+    });
+}
+
 // =============================================================================
 // Free Functions
 // =============================================================================
@@ -171,8 +367,25 @@ private:
 /// @param dt Time step
 ///
 /// Implements: x_new = x_old + v * dt
-/// This is parallelized with OpenMP when enabled.
-void advance_positions(Particles& particles, double dt);
+/// Sweeps the aligned, padded range so the loop has no peel or remainder.
+/// This is parallelized with OpenMP when enabled; in VPS_PORTABLE builds
+/// the SIMD loop is dispatched to the widest ISA of the running CPU.
+template <std::floating_point T>
+void advance_positions(BasicParticles<T>& particles, std::type_identity_t<T> dt);
+
+/// @brief Free streaming over explicit column spans
+/// @param x Positions to advance
+/// @param v Velocities, same length as x
+/// @param dt Time step
+///
+/// Column-generic form for any SoA schema carrying x and v:
+/// @code
+/// auto [x, v] = soa.view<columns::X<double>, columns::V<double>>();
+/// advance_positions(x, v, dt);
+/// @endcode
+template <std::floating_point T>
+void advance_positions(std::span<T> x, std::type_identity_t<std::span<const T>> v,
+                       std::type_identity_t<T> dt);
 
 /// @brief Advances particle velocities by acceleration * dt
 /// @param particles The particles to advance  
@@ -180,7 +393,15 @@ void advance_positions(Particles& particles, double dt);
 /// @param dt Time step
 ///
 /// Implements: v_new = v_old + a * dt
-void advance_velocities(Particles& particles, double acceleration, double dt);
+template <std::floating_point T>
+void advance_velocities(BasicParticles<T>& particles,
+                        std::type_identity_t<T> acceleration,
+                        std::type_identity_t<T> dt);
+
+/// @brief Uniform acceleration over an explicit velocity span
+template <std::floating_point T>
+void advance_velocities(std::span<T> v, std::type_identity_t<T> acceleration,
+                        std::type_identity_t<T> dt);
 
 } // namespace vps::particles
 
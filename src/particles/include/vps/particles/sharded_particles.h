@@ -0,0 +1,180 @@
+#ifndef VPS_PARTICLES_SHARDED_PARTICLES_H
+#define VPS_PARTICLES_SHARDED_PARTICLES_H
+
+/// @file sharded_particles.h
+/// @brief Phase-space points partitioned across NUMA nodes
+///
+/// A single Particles container is one slab; even with first-touch
+/// placement, threads of one socket still stream pages of the other once
+/// the OpenMP team spans both. ShardedParticles instead keeps one
+/// Particles per NUMA node, allocated, filled and processed only by
+/// threads pinned to that node, so kernels never cross the interconnect.
+
+#include <vps/memory/numa.h>
+#include <vps/particles/particles.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace vps::particles {
+
+/// @brief One persistent worker thread per NUMA node, pinned to its CPUs
+///
+/// Inside a task, OpenMP parallel regions use a team sized to the node's
+/// CPUs; its threads inherit the worker's affinity and so stay on the node.
+class ShardExecutor {
+public:
+    /// @brief Start one pinned worker per node
+    /// @throws std::invalid_argument if nodes is empty
+    explicit ShardExecutor(std::vector<memory::NumaNode> nodes);
+
+    ShardExecutor(const ShardExecutor&) = delete;
+    ShardExecutor& operator=(const ShardExecutor&) = delete;
+
+    /// @brief Stops and joins the workers
+    ~ShardExecutor();
+
+    /// @brief Returns the number of workers (== nodes)
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /// @brief Returns the node worker i is pinned to
+    [[nodiscard]] const memory::NumaNode& node(std::size_t i) const noexcept;
+
+    /// @brief Runs task(i) on worker i for every worker and waits for all
+    ///
+    /// If tasks throw, the first exception is rethrown after all finish.
+    /// Not reentrant: tasks must not call run() themselves.
+    void run(const std::function<void(std::size_t)>& task);
+
+private:
+    void stop_and_join() noexcept;
+
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+/// @brief Particles split into one shard per NUMA node
+/// @tparam T Floating-point type of x, v and f
+///
+/// @code
+/// ShardedParticles p;  // one shard per node of this host
+/// p.fill_with(n, [](std::size_t i) { return std::tuple{x(i), v(i), f(i)}; });
+/// advance_positions(p, dt);  // each shard advanced on its own node
+/// @endcode
+template <std::floating_point T>
+class BasicShardedParticles {
+public:
+    // =========================================================================
+    // Type Aliases
+    // =========================================================================
+    using value_type = T;
+    using size_type = std::size_t;
+    using particles_type = BasicParticles<T>;
+
+    // =========================================================================
+    // Constructors
+    // =========================================================================
+
+    /// @brief Create one empty shard per node
+    /// @param nodes Topology to shard over; defaults to the host's
+    explicit BasicShardedParticles(std::vector<memory::NumaNode> nodes = memory::numa_nodes());
+
+    // =========================================================================
+    // Capacity and Access
+    // =========================================================================
+
+    /// @brief Returns the number of shards (one per node)
+    [[nodiscard]] size_type n_shards() const noexcept;
+
+    /// @brief Returns the total number of points over all shards
+    [[nodiscard]] size_type size() const noexcept;
+
+    /// @brief Returns shard i
+    [[nodiscard]] particles_type& shard(size_type i) noexcept;
+    [[nodiscard]] const particles_type& shard(size_type i) const noexcept;
+
+    /// @brief Returns the node that owns shard i
+    [[nodiscard]] const memory::NumaNode& node(size_type i) const noexcept;
+
+    // =========================================================================
+    // Bulk Operations
+    // =========================================================================
+
+    /// @brief Replaces the contents with n generated points
+    ///
+    /// Points are split into contiguous ranges proportional to each node's
+    /// CPU count; shard s holds global indices [first_s, first_s + size_s).
+    /// Each shard is allocated and written on its own node (see
+    /// BasicParticles::fill_with for the generator contract).
+    template <typename Generator>
+    void fill_with(size_type n, Generator gen);
+
+    /// @brief Calls fn(shard, i) for every shard on that shard's node; blocks
+    template <typename Fn>
+    void for_each_shard(Fn&& fn);
+
+private:
+    std::vector<particles_type> shards_;
+    std::unique_ptr<ShardExecutor> executor_;
+};
+
+/// @brief Double-precision sharded points
+using ShardedParticles = BasicShardedParticles<double>;
+
+/// @brief Single-precision sharded points
+using ShardedParticlesF = BasicShardedParticles<float>;
+
+extern template class BasicShardedParticles<float>;
+extern template class BasicShardedParticles<double>;
+
+template <std::floating_point T>
+template <typename Generator>
+void BasicShardedParticles<T>::fill_with(size_type n, Generator gen) {
+    // Shard s gets a share of n proportional to its node's CPU count
+    const auto weight = [this](size_type s) { return std::max<size_type>(node(s).cpus.size(), 1); };
+    size_type total_weight = 0;
+    for (size_type s = 0; s < n_shards(); ++s) {
+        total_weight += weight(s);
+    }
+
+    std::vector<size_type> first(n_shards() + 1, 0);
+    size_type weight_before = 0;
+    for (size_type s = 0; s < n_shards(); ++s) {
+        weight_before += weight(s);
+        first[s + 1] = n * weight_before / total_weight;
+    }
+
+    executor_->run([&](size_type s) {
+        const size_type offset = first[s];
+        particles_type local(first[s + 1] - offset, memory::AllocationPolicy::page_aligned());
+        local.fill_with(first[s + 1] - offset, [&](size_type i) { return gen(offset + i); });
+        shards_[s] = std::move(local);
+    });
+}
+
+template <std::floating_point T>
+template <typename Fn>
+void BasicShardedParticles<T>::for_each_shard(Fn&& fn) {
+    executor_->run([&](size_type s) { fn(shards_[s], s); });
+}
+
+// =============================================================================
+// Free Functions
+// =============================================================================
+
+/// @brief Free streaming of every shard on its own node
+template <std::floating_point T>
+void advance_positions(BasicShardedParticles<T>& particles, std::type_identity_t<T> dt) {
+    particles.for_each_shard([dt](BasicParticles<T>& shard, std::size_t) {
+        advance_positions(shard, dt);
+    });
+}
+
+} // namespace vps::particles
+
+#endif // VPS_PARTICLES_SHARDED_PARTICLES_H
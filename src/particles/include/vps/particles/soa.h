@@ -0,0 +1,707 @@
+#ifndef VPS_PARTICLES_SOA_H
+#define VPS_PARTICLES_SOA_H
+
+/// @file soa.h
+/// @brief Compile-time Struct-of-Arrays schema over a single slab
+///
+/// SoA<Cols...> stores one array per column tag, all carved out of one
+/// memory::Buffer at fixed offsets. The set of columns is a template
+/// parameter, so a population only pays for the attributes it declares, and
+/// kernels request spans for exactly the columns they touch:
+///
+/// @code
+/// using namespace vps::particles;
+/// SoA<columns::X<double>, columns::V<double>, columns::F<double>,
+///     columns::SpeciesId, columns::TracerId> p;
+/// p.push_back(0.5, 1.0, 0.1, std::uint16_t{0}, std::uint64_t{42});
+///
+/// auto [x, v] = p.view<columns::X<double>, columns::V<double>>();
+/// advance_positions(x, v, 0.1);
+/// @endcode
+///
+/// Growth, copying and resizing are one operation over the whole slab,
+/// whatever the number of columns.
+
+#include <vps/memory/aligned_allocator.h>
+#include <vps/memory/arena.h>
+#include <vps/memory/buffer.h>
+#include <vps/particles/dispatch.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vps::particles {
+
+// =============================================================================
+// Column Tags
+// =============================================================================
+
+/// @brief A column tag names an attribute and its element type
+template <typename C>
+concept Column = requires { typename C::value_type; } &&
+                 std::is_trivially_copyable_v<typename C::value_type> &&
+                 (sizeof(typename C::value_type) & (sizeof(typename C::value_type) - 1)) == 0;
+
+namespace columns {
+
+/// @brief Position in configuration space
+template <std::floating_point T>
+struct X { using value_type = T; };
+
+/// @brief Velocity
+template <std::floating_point T>
+struct V { using value_type = T; };
+
+/// @brief Distribution function value (weight)
+template <std::floating_point T>
+struct F { using value_type = T; };
+
+/// @brief Species index into a species table
+struct SpeciesId { using value_type = std::uint16_t; };
+
+/// @brief Per-point charge-to-mass ratio q/m
+template <std::floating_point T>
+struct ChargeToMass { using value_type = T; };
+
+/// @brief Stable identifier for tracking individual points
+struct TracerId { using value_type = std::uint64_t; };
+
+/// @brief Index of the point's initial velocity-grid node
+struct VelocityIndex { using value_type = std::uint32_t; };
+
+/// @brief Owning cell index (cell-relative positions)
+struct Cell { using value_type = std::uint32_t; };
+
+/// @brief Offset inside the owning cell, in units of dx
+template <std::floating_point T>
+struct Offset { using value_type = T; };
+
+} // namespace columns
+
+// =============================================================================
+// SoA Container
+// =============================================================================
+
+/// @brief Struct-of-Arrays container whose columns are fixed at compile time
+/// @tparam Cols Distinct column tags
+///
+/// Layout: one slab, column k at byte offset stride * sum(sizeof(col_j), j < k).
+/// The stride (== capacity) is a multiple of the SIMD lane count of the
+/// narrowest column, so every column starts aligned; with a page-aligned
+/// policy every column starts on a page boundary.
+template <Column... Cols>
+class SoA {
+    static_assert(sizeof...(Cols) > 0, "SoA needs at least one column");
+
+    template <typename C>
+    static constexpr std::size_t count_of = (std::size_t{std::is_same_v<C, Cols>} + ...);
+
+    static_assert(((count_of<Cols> == 1) && ...), "SoA column tags must be distinct");
+
+public:
+    // =========================================================================
+    // Type Aliases
+    // =========================================================================
+    using size_type = std::size_t;
+
+    template <Column C>
+    using value_type_of = typename C::value_type;
+
+    /// @brief Byte alignment of every column
+    static constexpr std::size_t alignment = memory::default_alignment;
+
+    /// @brief Number of columns
+    static constexpr size_type n_columns = sizeof...(Cols);
+
+    /// @brief Padding granularity in elements, valid for every column
+    static constexpr size_type lanes =
+        std::max({memory::simd_lanes<typename Cols::value_type>...});
+
+    /// @brief True if C is one of the columns
+    template <typename C>
+    static constexpr bool has = count_of<C> == 1;
+
+    /// @brief Position of column C in Cols...
+    template <Column C>
+        requires has<C>
+    static constexpr size_type index_of = [] {
+        constexpr std::array<bool, n_columns> match{std::is_same_v<C, Cols>...};
+        return static_cast<size_type>(std::find(match.begin(), match.end(), true) -
+                                      match.begin());
+    }();
+
+    // =========================================================================
+    // Constructors
+    // =========================================================================
+
+    /// @brief Default constructor - creates empty container
+    SoA() = default;
+
+    /// @brief Construct with reserved capacity
+    explicit SoA(size_type capacity) : SoA(capacity, memory::AllocationPolicy{}) {}
+
+    /// @brief Construct with reserved capacity and an allocation policy
+    SoA(size_type capacity, memory::AllocationPolicy policy) : storage_(0, policy) {
+        reserve(capacity);
+    }
+
+    /// @brief Deep copy: one allocation, one copy of the whole slab
+    SoA(const SoA& other)
+        : storage_(other.storage_.size(), other.storage_.policy())
+        , size_(other.size_)
+        , stride_(other.stride_)
+    {
+        if (other.storage_.size() > 0) {
+            std::memcpy(storage_.data(), other.storage_.data(), other.storage_.size());
+        }
+    }
+
+    SoA(SoA&& other) noexcept
+        : storage_(std::move(other.storage_))
+        , size_(std::exchange(other.size_, 0))
+        , stride_(std::exchange(other.stride_, 0))
+    {}
+
+    SoA& operator=(const SoA& other) {
+        if (this != &other) {
+            SoA copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SoA& operator=(SoA&& other) noexcept {
+        storage_ = std::move(other.storage_);
+        size_ = std::exchange(other.size_, 0);
+        stride_ = std::exchange(other.stride_, 0);
+        return *this;
+    }
+
+    ~SoA() = default;
+
+    // =========================================================================
+    // Capacity
+    // =========================================================================
+
+    /// @brief Returns the number of points
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+
+    /// @brief Returns size() rounded up to a multiple of lanes
+    [[nodiscard]] size_type padded_size() const noexcept {
+        return memory::round_up(size_, lanes);
+    }
+
+    /// @brief Returns the current capacity (a multiple of lanes)
+    [[nodiscard]] size_type capacity() const noexcept { return stride_; }
+
+    /// @brief Checks if the container is empty
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Returns the allocation policy of the slab
+    [[nodiscard]] const memory::AllocationPolicy& allocation_policy() const noexcept {
+        return storage_.policy();
+    }
+
+    /// @brief Returns how the slab was actually obtained (huge pages, locked, ...)
+    [[nodiscard]] const memory::AllocationReport& allocation_report() const noexcept {
+        return storage_.report();
+    }
+
+    /// @brief Reserves memory for at least n points (one reallocation)
+    void reserve(size_type n) {
+        if (n > stride_) {
+            reallocate(n);
+        }
+    }
+
+    /// @brief Resizes to n points; new points are value-initialized
+    void resize(size_type n) { resize(n, value_type_of<Cols>{}...); }
+
+    /// @brief Resizes to n points; new points take the given column values
+    ///
+    /// The new points are written in parallel with a static schedule, the
+    /// same partition element-wise kernels use.
+    void resize(size_type n, const value_type_of<Cols>&... values) {
+        const size_type old_size = size_;
+        resize_storage(n);
+        if (n > old_size) {
+            fill_static(old_size, n, values...);
+        }
+    }
+
+    /// @brief Resizes to n points without writing the new points
+    ///
+    /// New live values are unspecified until the caller writes them; only
+    /// the padding lanes past n are zeroed. Meant for bulk initialization
+    /// that overwrites every new point anyway, e.g. a parallel fill.
+    void resize_uninitialized(size_type n) {
+        const size_type new_padded = memory::round_up(n, lanes);
+        if (new_padded > stride_) {
+            reallocate(std::max(new_padded, 2 * stride_));
+        }
+        (std::fill(column<Cols>() + n, column<Cols>() + new_padded, value_type_of<Cols>{}), ...);
+        size_ = n;
+    }
+
+    /// @brief Clears all points (capacity is kept)
+    void clear() noexcept { size_ = 0; }
+
+    // =========================================================================
+    // Modifiers
+    // =========================================================================
+
+    /// @brief Appends a block of points, one span per column in column order
+    ///
+    /// All spans must have the same length; each column is copied with one
+    /// memcpy after at most one reallocation.
+    void append(std::span<const value_type_of<Cols>>... values) {
+        const size_type count = std::get<0>(std::tie(values...)).size();
+        assert(((values.size() == count) && ...) && "Column spans differ in length");
+        const size_type old_size = size_;
+        resize_uninitialized(old_size + count);
+        if (count > 0) {
+            (std::memcpy(column<Cols>() + old_size, values.data(),
+                         count * sizeof(value_type_of<Cols>)),
+             ...);
+        }
+    }
+
+    /// @brief Appends one point, values given in column order
+    void push_back(const value_type_of<Cols>&... values) {
+        const size_type i = size_;
+        resize_storage(i + 1);
+        ((column<Cols>()[i] = values), ...);
+    }
+
+    /// @brief Removes the last point
+    void pop_back() noexcept {
+        assert(size_ > 0 && "Cannot pop from empty container");
+        --size_;
+    }
+
+    /// @brief Keeps exactly the points with keep[i] != 0, preserving their order
+    /// @param keep One flag per point (keep.size() == size())
+    /// @return Number of points removed
+    ///
+    /// In place: blocks of points are packed in parallel, then each block's
+    /// survivors are shifted down with one memmove per column.
+    size_type compact(std::span<const std::uint8_t> keep) {
+        assert(keep.size() == size_ && "Keep mask must cover every point");
+        const size_type n_blocks = (size_ + compact_block - 1) / compact_block;
+        std::pmr::vector<size_type> kept(n_blocks, memory::scratch());
+
+        parallel_for(n_blocks, [&](size_type b) {
+            const size_type first = b * compact_block;
+            const size_type last = std::min(first + compact_block, size_);
+            size_type out = first;
+            for (size_type i = first; i < last; ++i) {
+                if (keep[i] != 0) {
+                    if (out != i) {
+                        ((column<Cols>()[out] = column<Cols>()[i]), ...);
+                    }
+                    ++out;
+                }
+            }
+            kept[b] = out - first;
+        }, compact_block);
+
+        // Destinations only move down, so shifting in block order never
+        // overwrites a block that has not been shifted yet
+        size_type dest = 0;
+        for (size_type b = 0; b < n_blocks; ++b) {
+            const size_type first = b * compact_block;
+            if (dest != first && kept[b] > 0) {
+                (std::memmove(column<Cols>() + dest, column<Cols>() + first,
+                              kept[b] * sizeof(value_type_of<Cols>)),
+                 ...);
+            }
+            dest += kept[b];
+        }
+        return shrink_to(dest);
+    }
+
+    /// @brief Keeps exactly the points with keep[i] != 0, in any order
+    /// @param keep One flag per point (keep.size() == size())
+    /// @return Number of points removed
+    ///
+    /// Holes below the new size are filled with survivors from above it,
+    /// the k-th hole taking the k-th survivor. Every point is moved at most
+    /// once and all moves run in parallel, so this is the faster choice when
+    /// order does not matter.
+    size_type compact_unordered(std::span<const std::uint8_t> keep) {
+        assert(keep.size() == size_ && "Keep mask must cover every point");
+        const size_type n_blocks = (size_ + compact_block - 1) / compact_block;
+
+        size_type n_kept = 0;
+#ifdef VPS_ENABLE_OPENMP
+        #pragma omp parallel for schedule(static) reduction(+ : n_kept) if (run_parallel(size_)) \
+            num_threads(static_cast<int>(team_size(size_)))
+#endif
+        for (size_type i = 0; i < size_; ++i) {
+            n_kept += keep[i] != 0 ? size_type{1} : size_type{0};
+        }
+
+        // Per block: holes below n_kept and survivors at or above it
+        std::pmr::vector<size_type> holes(n_blocks + 1, 0, memory::scratch());
+        std::pmr::vector<size_type> movers(n_blocks + 1, 0, memory::scratch());
+        parallel_for(n_blocks, [&](size_type b) {
+            const size_type first = b * compact_block;
+            const size_type last = std::min(first + compact_block, size_);
+            size_type h = 0;
+            size_type m = 0;
+            for (size_type i = first; i < last; ++i) {
+                h += i < n_kept && keep[i] == 0 ? size_type{1} : size_type{0};
+                m += i >= n_kept && keep[i] != 0 ? size_type{1} : size_type{0};
+            }
+            holes[b + 1] = h;
+            movers[b + 1] = m;
+        }, compact_block);
+        for (size_type b = 0; b < n_blocks; ++b) {
+            holes[b + 1] += holes[b];
+            movers[b + 1] += movers[b];
+        }
+        assert(holes[n_blocks] == movers[n_blocks]);
+
+        parallel_for(n_blocks, [&](size_type b) {
+            if (holes[b + 1] == holes[b]) {
+                return;
+            }
+            // Locate the survivor whose rank equals this block's first hole rank
+            const size_type rank = holes[b];
+            const size_type c = static_cast<size_type>(
+                std::upper_bound(movers.begin(), movers.end(), rank) - movers.begin()) - 1;
+            size_type j = std::max(c * compact_block, n_kept);
+            for (size_type skip = rank - movers[c];; ++j) {
+                if (keep[j] != 0) {
+                    if (skip == 0) {
+                        break;
+                    }
+                    --skip;
+                }
+            }
+
+            const size_type first = b * compact_block;
+            const size_type last = std::min(first + compact_block, n_kept);
+            for (size_type i = first; i < last; ++i) {
+                if (keep[i] == 0) {
+                    while (keep[j] == 0) {
+                        ++j;
+                    }
+                    ((column<Cols>()[i] = column<Cols>()[j]), ...);
+                    ++j;
+                }
+            }
+        }, compact_block);
+        return shrink_to(n_kept);
+    }
+
+    /// @brief Removes every point i for which pred(i) is true, preserving order
+    /// @return Number of points removed
+    ///
+    /// pred is evaluated once per point, in parallel, before anything moves,
+    /// so it may read any column through captured spans or pointers.
+    template <typename Predicate>
+    size_type erase_if(Predicate pred) {
+        const auto keep = keep_mask(pred);
+        return compact(keep);
+    }
+
+    /// @brief Removes every point i for which pred(i) is true, in any order
+    /// @return Number of points removed
+    template <typename Predicate>
+    size_type erase_if_unordered(Predicate pred) {
+        const auto keep = keep_mask(pred);
+        return compact_unordered(keep);
+    }
+
+    // =========================================================================
+    // Out-of-Core Streaming
+    // =========================================================================
+
+    /// @brief Bytes per column in one streamed chunk
+    static constexpr size_type stream_chunk_bytes = size_type{64} << 20;
+
+    /// @brief Returns true if the slab lives in a memory-mapped spill file
+    [[nodiscard]] bool file_backed() const noexcept { return storage_.file_backed(); }
+
+    /// @brief Calls fn(first, last) over consecutive chunks covering [0, size())
+    ///
+    /// For a file-backed slab, the next chunk of every column is prefetched
+    /// (Advice::WillNeed) before fn processes the current one, which is
+    /// dropped (Advice::DontNeed) afterwards, so a sweep reads the file
+    /// sequentially and keeps about two chunks per column resident. Chunk
+    /// boundaries are multiples of lanes. For memory-backed slabs fn(0,
+    /// size()) is called once.
+    ///
+    /// @param chunk_points Points per chunk, rounded up to whole pages of
+    ///        every column; 0 selects stream_chunk_bytes per column
+    template <typename Fn>
+    void stream(Fn&& fn, size_type chunk_points = 0) const {
+        if (!file_backed()) {
+            fn(size_type{0}, size_);
+            return;
+        }
+        const size_type chunk = stream_chunk_points(chunk_points);
+        advise_rows(0, std::min(chunk, size_), memory::Advice::WillNeed);
+        for (size_type first = 0; first < size_; first += chunk) {
+            const size_type last = std::min(first + chunk, size_);
+            if (last < size_) {
+                advise_rows(last, std::min(last + chunk, size_) - last, memory::Advice::WillNeed);
+            }
+            fn(first, last);
+            advise_rows(first, last - first, memory::Advice::DontNeed);
+        }
+    }
+
+    // =========================================================================
+    // Column Access
+    // =========================================================================
+
+    /// @brief Returns a span over the live values of column C
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] std::span<value_type_of<C>> get() noexcept {
+        return {column<C>(), size_};
+    }
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] std::span<const value_type_of<C>> get() const noexcept {
+        return {column<C>(), size_};
+    }
+
+    /// @brief Returns the padded, aligned span over column C
+    ///
+    /// Values in [size(), padded_size()) are unspecified: element-wise
+    /// kernels may read and overwrite them, reductions must stop at size().
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] std::span<value_type_of<C>> aligned() noexcept {
+        return {std::assume_aligned<alignment>(column<C>()), padded_size()};
+    }
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] std::span<const value_type_of<C>> aligned() const noexcept {
+        return {std::assume_aligned<alignment>(column<C>()), padded_size()};
+    }
+
+    /// @brief Returns spans over exactly the requested columns
+    template <Column... Cs>
+        requires(has<Cs> && ...)
+    [[nodiscard]] std::tuple<std::span<value_type_of<Cs>>...> view() noexcept {
+        return {get<Cs>()...};
+    }
+    template <Column... Cs>
+        requires(has<Cs> && ...)
+    [[nodiscard]] std::tuple<std::span<const value_type_of<Cs>>...> view() const noexcept {
+        return {get<Cs>()...};
+    }
+
+    /// @brief Access the value of column C at index i
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] value_type_of<C>& at(size_type i) noexcept {
+        assert(i < size_ && "Index out of bounds");
+        return column<C>()[i];
+    }
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] const value_type_of<C>& at(size_type i) const noexcept {
+        assert(i < size_ && "Index out of bounds");
+        return column<C>()[i];
+    }
+
+    /// @brief Returns pointer to the start of column C
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] value_type_of<C>* data() noexcept {
+        return column<C>();
+    }
+    template <Column C>
+        requires has<C>
+    [[nodiscard]] const value_type_of<C>* data() const noexcept {
+        return column<C>();
+    }
+
+private:
+    /// @brief Byte offset of each column per unit of stride
+    static constexpr std::array<size_type, n_columns> column_bytes = [] {
+        std::array<size_type, n_columns> offsets{};
+        constexpr std::array<size_type, n_columns> sizes{sizeof(value_type_of<Cols>)...};
+        for (size_type k = 1; k < n_columns; ++k) {
+            offsets[k] = offsets[k - 1] + sizes[k - 1];
+        }
+        return offsets;
+    }();
+
+    /// @brief Sum of element sizes of all columns
+    static constexpr size_type row_bytes = (sizeof(value_type_of<Cols>) + ...);
+
+    /// @brief Narrowest element size; stride granularity is derived from it
+    static constexpr size_type min_bytes = std::min({sizeof(value_type_of<Cols>)...});
+
+    template <Column C>
+    [[nodiscard]] value_type_of<C>* column() noexcept {
+        return reinterpret_cast<value_type_of<C>*>(static_cast<std::byte*>(storage_.data()) +
+                                                   stride_ * column_bytes[index_of<C>]);
+    }
+    template <Column C>
+    [[nodiscard]] const value_type_of<C>* column() const noexcept {
+        return reinterpret_cast<const value_type_of<C>*>(
+            static_cast<const std::byte*>(storage_.data()) + stride_ * column_bytes[index_of<C>]);
+    }
+
+    /// @brief The single growth path: moves every column into a new slab
+    void reallocate(size_type new_capacity) {
+        const size_type granularity =
+            std::max(lanes, storage_.policy().alignment / min_bytes);
+        const size_type stride = memory::round_up(new_capacity, granularity);
+
+        memory::Buffer slab(stride * row_bytes, storage_.policy());
+        auto* base = static_cast<std::byte*>(slab.data());
+        if (slab.policy().first_touch) {
+            first_touch(base, stride, padded_size());
+        }
+        if (size_ > 0) {
+            ((std::memcpy(base + stride * column_bytes[index_of<Cols>], column<Cols>(),
+                          padded_size() * sizeof(value_type_of<Cols>))),
+             ...);
+        }
+
+        storage_ = std::move(slab);
+        stride_ = stride;
+    }
+
+    /// @brief Zeroes every column of a fresh slab, page placement by first touch
+    ///
+    /// The live rows [0, live) go through for_each_block, the partition
+    /// kernels sweeping the container use, so each thread's pages land on
+    /// its node. The spare rows [live, stride) are split the same way on
+    /// their own, as the best guess for points appended later; splitting
+    /// [0, stride) in one go would hand the live rows to the first part of
+    /// the team only, since growth doubles the stride.
+    static void first_touch(std::byte* base, size_type stride, size_type live) {
+        const auto zero = [&](size_type first, size_type count) {
+            (std::fill_n(reinterpret_cast<value_type_of<Cols>*>(
+                             base + stride * column_bytes[index_of<Cols>]) + first,
+                         count, value_type_of<Cols>{}),
+             ...);
+        };
+        for_each_block(live, zero);
+        for_each_block(stride - live, [&](size_type first, size_type count) {
+            zero(live + first, count);
+        });
+    }
+
+    /// @brief Writes values to [first, last) of every column, block by block
+    /// on the kernel backend
+    void fill_static(size_type first, size_type last, const value_type_of<Cols>&... values) {
+        for_each_block(last - first, [&](size_type offset, size_type count) {
+            (std::fill_n(column<Cols>() + first + offset, count, values), ...);
+        });
+    }
+
+    /// @brief Sets size to n, growing storage and zeroing new padding lanes
+    void resize_storage(size_type n) {
+        const size_type old_padded = padded_size();
+        const size_type new_padded = memory::round_up(n, lanes);
+        if (new_padded > stride_) {
+            reallocate(std::max(new_padded, 2 * stride_));
+        }
+        if (new_padded > old_padded) {
+            // Newly exposed lanes start out zeroed so kernels never read raw memory
+            (std::fill(column<Cols>() + old_padded, column<Cols>() + new_padded,
+                       value_type_of<Cols>{}),
+             ...);
+        }
+        size_ = n;
+    }
+
+    /// @brief Points per streamed chunk (default: stream_chunk_bytes of the
+    /// widest column), rounded so that every column's chunk spans whole pages
+    static size_type stream_chunk_points(size_type requested) noexcept {
+        constexpr size_type max_bytes = std::max({sizeof(value_type_of<Cols>)...});
+        const size_type granularity = std::max(lanes, memory::page_size() / min_bytes);
+        const size_type points = requested > 0 ? requested : stream_chunk_bytes / max_bytes;
+        return memory::round_up(std::max<size_type>(points, 1), granularity);
+    }
+
+    /// @brief Applies advice to rows [first, first + count) of every column
+    void advise_rows(size_type first, size_type count, memory::Advice advice) const noexcept {
+        ((storage_.advise(stride_ * column_bytes[index_of<Cols>] +
+                              first * sizeof(value_type_of<Cols>),
+                          count * sizeof(value_type_of<Cols>), advice)),
+         ...);
+    }
+
+    /// @brief Points per block in compaction; sets the parallel grain
+    static constexpr size_type compact_block = 16384;
+
+    /// @brief Evaluates keep[i] = !pred(i) for every point in parallel
+    ///
+    /// The mask comes from memory::scratch(), like the compaction prefix sums.
+    template <typename Predicate>
+    std::pmr::vector<std::uint8_t> keep_mask(Predicate& pred) const {
+        std::pmr::vector<std::uint8_t> keep(size_, memory::scratch());
+        std::uint8_t* flags = keep.data();
+        for_each_block(size_, [&](size_type first, size_type count) {
+            for (size_type i = first; i < first + count; ++i) {
+                flags[i] = pred(i) ? std::uint8_t{0} : std::uint8_t{1};
+            }
+        });
+        return keep;
+    }
+
+    /// @brief Drops points past n, zeroing the padding lanes; returns points removed
+    size_type shrink_to(size_type n) noexcept {
+        const size_type removed = size_ - n;
+        size_ = n;
+        (std::fill(column<Cols>() + n, column<Cols>() + padded_size(), value_type_of<Cols>{}),
+         ...);
+        return removed;
+    }
+
+    memory::Buffer storage_;  ///< Slab holding every column
+    size_type size_ = 0;      ///< Number of live points
+    size_type stride_ = 0;    ///< Elements per column (== capacity)
+};
+
+// =============================================================================
+// Free Functions
+// =============================================================================
+
+/// @brief Returns a span over column C of an SoA
+template <Column C, Column... Cols>
+    requires(SoA<Cols...>::template has<C>)
+[[nodiscard]] std::span<typename C::value_type> get(SoA<Cols...>& soa) noexcept {
+    return soa.template get<C>();
+}
+
+template <Column C, Column... Cols>
+    requires(SoA<Cols...>::template has<C>)
+[[nodiscard]] std::span<const typename C::value_type> get(const SoA<Cols...>& soa) noexcept {
+    return soa.template get<C>();
+}
+
+/// @brief Phase-space schema: x, v, f followed by optional extra columns
+///
+/// @code
+/// ParticleSchema<double, columns::SpeciesId, columns::ChargeToMass<double>> p;
+/// @endcode
+template <std::floating_point T, Column... Extra>
+using ParticleSchema = SoA<columns::X<T>, columns::V<T>, columns::F<T>, Extra...>;
+
+} // namespace vps::particles
+
+#endif // VPS_PARTICLES_SOA_H
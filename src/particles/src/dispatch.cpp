@@ -0,0 +1,144 @@
+#include "vps/particles/dispatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace vps::particles {
+
+namespace {
+
+/// @brief Bounds of a measured grain, against timer noise on either side
+constexpr std::size_t min_grain = 256;
+constexpr std::size_t max_grain = std::size_t{1} << 22;
+
+/// @brief Points of the streaming loop timed by the calibration
+constexpr std::size_t probe_points = 16384;
+
+/// @brief Timed repetitions; the fastest one counts
+constexpr int probe_reps = 32;
+
+std::atomic<std::size_t> grain{0};
+std::once_flag configured;
+
+using steady = std::chrono::steady_clock;
+
+/// @brief Seconds of the fastest of probe_reps calls to fn
+template <typename Fn>
+double fastest(Fn&& fn) {
+    double best = 0.0;
+    for (int r = 0; r < probe_reps; ++r) {
+        const auto start = steady::now();
+        fn();
+        const double t = std::chrono::duration<double>(steady::now() - start).count();
+        if (r == 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+/// @brief Seconds to fork and join a full team that does nothing
+double fork_join_seconds() {
+#if defined(VPS_ENABLE_TASKS)
+    auto& pool = memory::task_pool();
+    return fastest([&] { pool.parallel_for(pool.size(), [](std::size_t) {}); });
+#elif defined(VPS_ENABLE_OPENMP)
+    return fastest([] {
+        #pragma omp parallel
+        {
+            // empty region: only the fork and the join barrier are timed
+        }
+    });
+#else
+    return 0.0;
+#endif
+}
+
+/// @brief Seconds per point of a serial free-streaming sweep
+double point_seconds() {
+    std::vector<double> x(probe_points, 0.0);
+    std::vector<double> v(probe_points, 1.0);
+    volatile double dt = 1e-3;  // keeps the loop from being folded away
+    const double t = fastest([&] {
+        const double h = dt;
+        for (std::size_t i = 0; i < probe_points; ++i) {
+            x[i] += v[i] * h;
+        }
+    });
+    volatile double sink = x[probe_points / 2];
+    static_cast<void>(sink);
+    return t / static_cast<double>(probe_points);
+}
+
+/// @brief Grain from VPS_PARALLEL_GRAIN, or 0 if unset or not a number
+std::size_t grain_from_environment() noexcept {
+    const char* text = std::getenv("VPS_PARALLEL_GRAIN");
+    if (text == nullptr) {
+        return 0;
+    }
+    std::size_t value = 0;
+    const char* end = text + std::strlen(text);
+    const auto [ptr, ec] = std::from_chars(text, end, value);
+    return (ec == std::errc{} && ptr == end) ? value : 0;
+}
+
+/// @brief fork/join latency over per-point cost, clamped to the grain bounds
+std::size_t measure_grain() {
+    const double per_point = point_seconds();
+    const double ratio = per_point > 0.0 ? fork_join_seconds() / per_point : 0.0;
+    const std::size_t measured =
+        ratio < static_cast<double>(max_grain) ? static_cast<std::size_t>(ratio) : max_grain;
+    return std::clamp(measured, min_grain, max_grain);
+}
+
+/// @brief Sets the grain on first use, from the environment or a measurement
+void configure() {
+    std::call_once(configured, [] {
+        const std::size_t from_environment = grain_from_environment();
+        grain.store(from_environment > 0 ? from_environment : measure_grain(),
+                    std::memory_order_relaxed);
+    });
+}
+
+/// @brief Stores value, which also stands in for the first-use defaults
+void store_grain(std::size_t value) {
+    std::call_once(configured, [value] { grain.store(value, std::memory_order_relaxed); });
+    grain.store(value, std::memory_order_relaxed);
+}
+
+} // namespace
+
+// =============================================================================
+// Granularity
+// =============================================================================
+
+std::size_t parallel_grain() {
+    configure();
+    return grain.load(std::memory_order_relaxed);
+}
+
+void set_parallel_grain(std::size_t points) {
+    store_grain(std::max<std::size_t>(points, 1));
+}
+
+std::size_t calibrate_parallel_grain() {
+    const std::size_t value = measure_grain();
+    store_grain(value);
+    return value;
+}
+
+std::size_t team_size(std::size_t points) {
+    const std::size_t workers = max_workers();
+    if (workers == 1) {
+        return 1;  // nothing to decide, and no calibration to pay for
+    }
+    return std::clamp<std::size_t>(points / parallel_grain(), 1, workers);
+}
+
+} // namespace vps::particles
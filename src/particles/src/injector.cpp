@@ -0,0 +1,104 @@
+#include "vps/particles/injector.h"
+
+#include <vps/particles/dispatch.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace vps::particles {
+
+namespace {
+
+/// @brief One lane per thread that lane_id() can number
+std::size_t default_lanes() {
+#if defined(VPS_ENABLE_TASKS) && defined(VPS_ENABLE_OPENMP)
+    return std::max(max_workers(), static_cast<std::size_t>(omp_get_max_threads()));
+#else
+    return max_workers();
+#endif
+}
+
+} // namespace
+
+// =============================================================================
+// BasicInjector
+// =============================================================================
+
+template <std::floating_point T>
+BasicInjector<T>::BasicInjector(size_type n_lanes)
+    : lanes_(n_lanes > 0 ? n_lanes : default_lanes())
+{}
+
+template <std::floating_point T>
+typename BasicInjector<T>::size_type BasicInjector<T>::n_lanes() const noexcept {
+    return lanes_.size();
+}
+
+template <std::floating_point T>
+typename BasicInjector<T>::size_type BasicInjector<T>::size() const noexcept {
+    size_type total = 0;
+    for (const auto& l : lanes_) {
+        total += l.points.size();
+    }
+    return total;
+}
+
+template <std::floating_point T>
+bool BasicInjector<T>::empty() const noexcept {
+    return size() == 0;
+}
+
+template <std::floating_point T>
+const typename BasicInjector<T>::particles_type&
+BasicInjector<T>::lane(size_type i) const noexcept {
+    return lanes_[i].points;
+}
+
+template <std::floating_point T>
+typename BasicInjector<T>::size_type BasicInjector<T>::merge_into(particles_type& particles) {
+    const size_type n_lanes = lanes_.size();
+    const size_type old_size = particles.size();
+    const size_type added = size();
+    if (added == 0) {
+        return 0;
+    }
+    particles.resize_uninitialized(old_size + added);
+
+    value_type* xs = particles.x().data();
+    value_type* vs = particles.v().data();
+    value_type* fs = particles.f().data();
+
+    parallel_for(n_lanes, [&](size_type l) {
+        // Lane l lands after the existing points and all lanes before it
+        size_type offset = old_size;
+        for (size_type k = 0; k < l; ++k) {
+            offset += lanes_[k].points.size();
+        }
+        const auto& points = lanes_[l].points;
+        const size_type bytes = points.size() * sizeof(value_type);
+        if (bytes > 0) {
+            std::memcpy(xs + offset, points.x().data(), bytes);
+            std::memcpy(vs + offset, points.v().data(), bytes);
+            std::memcpy(fs + offset, points.f().data(), bytes);
+        }
+    }, added / n_lanes);
+
+    clear();
+    return added;
+}
+
+template <std::floating_point T>
+void BasicInjector<T>::clear() noexcept {
+    for (auto& l : lanes_) {
+        l.points.clear();
+    }
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template class BasicInjector<float>;
+template class BasicInjector<double>;
+
+} // namespace vps::particles
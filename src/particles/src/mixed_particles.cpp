@@ -0,0 +1,90 @@
+#include "vps/particles/mixed_particles.h"
+
+namespace vps::particles {
+
+namespace {
+
+using Offset = columns::Offset<float>;
+using V = columns::V<float>;
+using F = columns::F<float>;
+
+} // namespace
+
+// =============================================================================
+// Constructors
+// =============================================================================
+
+MixedParticles::MixedParticles(size_type capacity)
+    : data_(capacity)
+{}
+
+// =============================================================================
+// Capacity
+// =============================================================================
+
+MixedParticles::size_type MixedParticles::size() const noexcept {
+    return data_.size();
+}
+
+bool MixedParticles::empty() const noexcept {
+    return data_.empty();
+}
+
+void MixedParticles::reserve(size_type n) {
+    data_.reserve(n);
+}
+
+void MixedParticles::resize(size_type n) {
+    data_.resize(n);
+}
+
+void MixedParticles::clear() noexcept {
+    data_.clear();
+}
+
+// =============================================================================
+// Element Access - Span-based
+// =============================================================================
+
+std::span<MixedParticles::cell_type> MixedParticles::cell() noexcept {
+    return data_.get<columns::Cell>();
+}
+
+std::span<const MixedParticles::cell_type> MixedParticles::cell() const noexcept {
+    return data_.get<columns::Cell>();
+}
+
+std::span<MixedParticles::value_type> MixedParticles::offset() noexcept {
+    return data_.get<Offset>();
+}
+
+std::span<const MixedParticles::value_type> MixedParticles::offset() const noexcept {
+    return data_.get<Offset>();
+}
+
+std::span<MixedParticles::value_type> MixedParticles::v() noexcept {
+    return data_.get<V>();
+}
+
+std::span<const MixedParticles::value_type> MixedParticles::v() const noexcept {
+    return data_.get<V>();
+}
+
+std::span<MixedParticles::value_type> MixedParticles::f() noexcept {
+    return data_.get<F>();
+}
+
+std::span<const MixedParticles::value_type> MixedParticles::f() const noexcept {
+    return data_.get<F>();
+}
+
+// =============================================================================
+// Modifiers
+// =============================================================================
+
+void MixedParticles::push_back(cell_type cell_val, value_type offset_val, value_type v_val,
+                               value_type f_val) {
+    data_.push_back(cell_val, offset_val, v_val, f_val);
+}
+
+} // namespace vps::particles
@@ -1,7 +1,10 @@
 #include "vps/particles/particles.h"
+#include "vps/particles/dispatch.h"
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <utility>
 
 #ifdef VPS_ENABLE_OPENMP
 #include <omp.h>
@@ -9,195 +12,317 @@
 
 namespace vps::particles {
 
+namespace {
+
+template <std::floating_point T>
+using X = columns::X<T>;
+
+template <std::floating_point T>
+using V = columns::V<T>;
+
+template <std::floating_point T>
+using F = columns::F<T>;
+
+/// @brief x[i] += v[i] * dt for one block, cloned per ISA
+template <std::floating_point T>
+VPS_TARGET_CLONES void push_block(T* x, const T* v, std::size_t n, T dt) noexcept {
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] += v[i] * dt;
+    }
+}
+
+/// @brief v[i] += dv for one block, cloned per ISA
+template <std::floating_point T>
+VPS_TARGET_CLONES void kick_block(T* v, std::size_t n, T dv) noexcept {
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp simd
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] += dv;
+    }
+}
+
+} // namespace
+
 // =============================================================================
 // Constructors
 // =============================================================================
 
-Particles::Particles(size_type capacity) {
-    reserve(capacity);
-}
+template <std::floating_point T>
+BasicParticles<T>::BasicParticles(size_type capacity)
+    : data_(capacity)
+{}
 
-Particles::Particles(size_type size, value_type x_val, value_type v_val, value_type f_val)
-    : x_(size, x_val)
-    , v_(size, v_val)
-    , f_(size, f_val) 
+template <std::floating_point T>
+BasicParticles<T>::BasicParticles(size_type capacity, memory::AllocationPolicy policy)
+    : data_(capacity, policy)
 {}
 
+template <std::floating_point T>
+BasicParticles<T>::BasicParticles(size_type size, value_type x_val, value_type v_val,
+                                  value_type f_val) {
+    data_.resize(size, x_val, v_val, f_val);
+}
+
+template <std::floating_point T>
+BasicParticles<T>::BasicParticles(size_type size, value_type x_val, value_type v_val,
+                                  value_type f_val, memory::AllocationPolicy policy)
+    : data_(size, policy)
+{
+    data_.resize(size, x_val, v_val, f_val);
+}
+
 // =============================================================================
 // Capacity
 // =============================================================================
 
-Particles::size_type Particles::size() const noexcept {
-    return x_.size();
+template <std::floating_point T>
+typename BasicParticles<T>::size_type BasicParticles<T>::size() const noexcept {
+    return data_.size();
 }
 
-Particles::size_type Particles::capacity() const noexcept {
-    return x_.capacity();
+template <std::floating_point T>
+typename BasicParticles<T>::size_type BasicParticles<T>::padded_size() const noexcept {
+    return data_.padded_size();
 }
 
-bool Particles::empty() const noexcept {
-    return x_.empty();
+template <std::floating_point T>
+typename BasicParticles<T>::size_type BasicParticles<T>::capacity() const noexcept {
+    return data_.capacity();
 }
 
-void Particles::reserve(size_type n) {
-    x_.reserve(n);
-    v_.reserve(n);
-    f_.reserve(n);
+template <std::floating_point T>
+const memory::AllocationPolicy& BasicParticles<T>::allocation_policy() const noexcept {
+    return data_.allocation_policy();
 }
 
-void Particles::resize(size_type n) {
-    x_.resize(n);
-    v_.resize(n);
-    f_.resize(n);
+template <std::floating_point T>
+const memory::AllocationReport& BasicParticles<T>::allocation_report() const noexcept {
+    return data_.allocation_report();
 }
 
-void Particles::resize(size_type n, value_type x_val, value_type v_val, value_type f_val) {
-    x_.resize(n, x_val);
-    v_.resize(n, v_val);
-    f_.resize(n, f_val);
+template <std::floating_point T>
+bool BasicParticles<T>::empty() const noexcept {
+    return data_.empty();
 }
 
-void Particles::clear() noexcept {
-    x_.clear();
-    v_.clear();
-    f_.clear();
+template <std::floating_point T>
+void BasicParticles<T>::reserve(size_type n) {
+    data_.reserve(n);
+}
+
+template <std::floating_point T>
+void BasicParticles<T>::resize(size_type n) {
+    data_.resize(n);
+}
+
+template <std::floating_point T>
+void BasicParticles<T>::resize(size_type n, value_type x_val, value_type v_val, value_type f_val) {
+    data_.resize(n, x_val, v_val, f_val);
+}
+
+template <std::floating_point T>
+void BasicParticles<T>::resize_uninitialized(size_type n) {
+    data_.resize_uninitialized(n);
+}
+
+template <std::floating_point T>
+void BasicParticles<T>::clear() noexcept {
+    data_.clear();
 }
 
 // =============================================================================
 // Element Access - Span-based
 // =============================================================================
 
-std::span<Particles::value_type> Particles::x() noexcept {
-    return x_;
+template <std::floating_point T>
+std::span<typename BasicParticles<T>::value_type> BasicParticles<T>::x() noexcept {
+    return data_.template get<X<T>>();
 }
 
-std::span<const Particles::value_type> Particles::x() const noexcept {
-    return x_;
+template <std::floating_point T>
+std::span<const typename BasicParticles<T>::value_type> BasicParticles<T>::x() const noexcept {
+    return data_.template get<X<T>>();
 }
 
-std::span<Particles::value_type> Particles::v() noexcept {
-    return v_;
+template <std::floating_point T>
+std::span<typename BasicParticles<T>::value_type> BasicParticles<T>::v() noexcept {
+    return data_.template get<V<T>>();
 }
 
-std::span<const Particles::value_type> Particles::v() const noexcept {
-    return v_;
+template <std::floating_point T>
+std::span<const typename BasicParticles<T>::value_type> BasicParticles<T>::v() const noexcept {
+    return data_.template get<V<T>>();
 }
 
-std::span<Particles::value_type> Particles::f() noexcept {
-    return f_;
+template <std::floating_point T>
+std::span<typename BasicParticles<T>::value_type> BasicParticles<T>::f() noexcept {
+    return data_.template get<F<T>>();
 }
 
-std::span<const Particles::value_type> Particles::f() const noexcept {
-    return f_;
+template <std::floating_point T>
+std::span<const typename BasicParticles<T>::value_type> BasicParticles<T>::f() const noexcept {
+    return data_.template get<F<T>>();
 }
 
 // =============================================================================
 // Element Access - Index-based
 // =============================================================================
 
-Particles::value_type& Particles::x(size_type i) noexcept {
-    assert(i < size() && "Index out of bounds");
-    return x_[i];
+template <std::floating_point T>
+typename BasicParticles<T>::value_type& BasicParticles<T>::x(size_type i) noexcept {
+    return data_.template at<X<T>>(i);
 }
 
-const Particles::value_type& Particles::x(size_type i) const noexcept {
-    assert(i < size() && "Index out of bounds");
-    return x_[i];
+template <std::floating_point T>
+const typename BasicParticles<T>::value_type& BasicParticles<T>::x(size_type i) const noexcept {
+    return data_.template at<X<T>>(i);
 }
 
-Particles::value_type& Particles::v(size_type i) noexcept {
-    assert(i < size() && "Index out of bounds");
-    return v_[i];
+template <std::floating_point T>
+typename BasicParticles<T>::value_type& BasicParticles<T>::v(size_type i) noexcept {
+    return data_.template at<V<T>>(i);
 }
 
-const Particles::value_type& Particles::v(size_type i) const noexcept {
-    assert(i < size() && "Index out of bounds");
-    return v_[i];
+template <std::floating_point T>
+const typename BasicParticles<T>::value_type& BasicParticles<T>::v(size_type i) const noexcept {
+    return data_.template at<V<T>>(i);
 }
 
-Particles::value_type& Particles::f(size_type i) noexcept {
-    assert(i < size() && "Index out of bounds");
-    return f_[i];
+template <std::floating_point T>
+typename BasicParticles<T>::value_type& BasicParticles<T>::f(size_type i) noexcept {
+    return data_.template at<F<T>>(i);
 }
 
-const Particles::value_type& Particles::f(size_type i) const noexcept {
-    assert(i < size() && "Index out of bounds");
-    return f_[i];
+template <std::floating_point T>
+const typename BasicParticles<T>::value_type& BasicParticles<T>::f(size_type i) const noexcept {
+    return data_.template at<F<T>>(i);
 }
 
 // =============================================================================
 // Modifiers
 // =============================================================================
 
-void Particles::push_back(value_type x_val, value_type v_val, value_type f_val) {
-    x_.push_back(x_val);
-    v_.push_back(v_val);
-    f_.push_back(f_val);
+template <std::floating_point T>
+void BasicParticles<T>::push_back(value_type x_val, value_type v_val, value_type f_val) {
+    data_.push_back(x_val, v_val, f_val);
+}
+
+template <std::floating_point T>
+void BasicParticles<T>::pop_back() {
+    data_.pop_back();
 }
 
-void Particles::pop_back() {
-    assert(!empty() && "Cannot pop from empty container");
-    x_.pop_back();
-    v_.pop_back();
-    f_.pop_back();
+template <std::floating_point T>
+void BasicParticles<T>::append(std::span<const value_type> x_vals,
+                               std::span<const value_type> v_vals,
+                               std::span<const value_type> f_vals) {
+    data_.append(x_vals, v_vals, f_vals);
 }
 
 // =============================================================================
 // Raw Data Access
 // =============================================================================
 
-Particles::value_type* Particles::x_data() noexcept {
-    return x_.data();
+template <std::floating_point T>
+typename BasicParticles<T>::value_type* BasicParticles<T>::x_data() noexcept {
+    return data_.template data<X<T>>();
 }
 
-const Particles::value_type* Particles::x_data() const noexcept {
-    return x_.data();
+template <std::floating_point T>
+const typename BasicParticles<T>::value_type* BasicParticles<T>::x_data() const noexcept {
+    return data_.template data<X<T>>();
 }
 
-Particles::value_type* Particles::v_data() noexcept {
-    return v_.data();
+template <std::floating_point T>
+typename BasicParticles<T>::value_type* BasicParticles<T>::v_data() noexcept {
+    return data_.template data<V<T>>();
 }
 
-const Particles::value_type* Particles::v_data() const noexcept {
-    return v_.data();
+template <std::floating_point T>
+const typename BasicParticles<T>::value_type* BasicParticles<T>::v_data() const noexcept {
+    return data_.template data<V<T>>();
 }
 
-Particles::value_type* Particles::f_data() noexcept {
-    return f_.data();
+template <std::floating_point T>
+typename BasicParticles<T>::value_type* BasicParticles<T>::f_data() noexcept {
+    return data_.template data<F<T>>();
 }
 
-const Particles::value_type* Particles::f_data() const noexcept {
-    return f_.data();
+template <std::floating_point T>
+const typename BasicParticles<T>::value_type* BasicParticles<T>::f_data() const noexcept {
+    return data_.template data<F<T>>();
 }
 
 // =============================================================================
 // Free Functions
 // =============================================================================
 
-void advance_positions(Particles& particles, double dt) {
-    auto x = particles.x();
-    auto v = particles.v();
-    const auto n = particles.size();
+template <std::floating_point T>
+void advance_positions(BasicParticles<T>& particles, std::type_identity_t<T> dt) {
+    T* const xs = particles.aligned_x().data();
+    const T* const vs = particles.aligned_v().data();
+    const auto padded = particles.padded_size();
+
+    // One chunk in memory; file-backed containers are swept chunk by chunk.
+    // Chunk and block starts are multiples of lanes, so every block stays aligned.
+    particles.stream([&](std::size_t first, std::size_t last) {
+        const auto n = std::min(memory::round_up(last, BasicParticles<T>::lanes), padded) - first;
+        for_each_block(n, [&](std::size_t b, std::size_t count) {
+            push_block(xs + first + b, vs + first + b, count, dt);
+        });
+    });
+}
 
-#ifdef VPS_ENABLE_OPENMP
-    #pragma omp parallel for simd
-#endif
-    for (std::size_t i = 0; i < n; ++i) {
-        x[i] += v[i] * dt;
-    }
+template <std::floating_point T>
+void advance_positions(std::span<T> x, std::type_identity_t<std::span<const T>> v,
+                       std::type_identity_t<T> dt) {
+    assert(x.size() == v.size() && "Column spans differ in length");
+    for_each_block(x.size(), [&](std::size_t first, std::size_t count) {
+        push_block(x.data() + first, v.data() + first, count, dt);
+    });
 }
 
-void advance_velocities(Particles& particles, double acceleration, double dt) {
-    auto v = particles.v();
-    const auto n = particles.size();
-    const double dv = acceleration * dt;
+template <std::floating_point T>
+void advance_velocities(BasicParticles<T>& particles,
+                        std::type_identity_t<T> acceleration,
+                        std::type_identity_t<T> dt) {
+    T* const v = particles.aligned_v().data();
+    const T dv = acceleration * dt;
+    for_each_block(particles.padded_size(), [&](std::size_t first, std::size_t count) {
+        kick_block(v + first, count, dv);
+    });
+}
 
-#ifdef VPS_ENABLE_OPENMP
-    #pragma omp parallel for simd
-#endif
-    for (std::size_t i = 0; i < n; ++i) {
-        v[i] += dv;
-    }
+template <std::floating_point T>
+void advance_velocities(std::span<T> v, std::type_identity_t<T> acceleration,
+                        std::type_identity_t<T> dt) {
+    const T dv = acceleration * dt;
+    for_each_block(v.size(), [&](std::size_t first, std::size_t count) {
+        kick_block(v.data() + first, count, dv);
+    });
 }
 
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template class BasicParticles<float>;
+template class BasicParticles<double>;
+
+template void advance_positions(BasicParticles<float>&, float);
+template void advance_positions(BasicParticles<double>&, double);
+
+template void advance_positions(std::span<float>, std::span<const float>, float);
+template void advance_positions(std::span<double>, std::span<const double>, double);
+
+template void advance_velocities(BasicParticles<float>&, float, float);
+template void advance_velocities(BasicParticles<double>&, double, double);
+
+template void advance_velocities(std::span<float>, float, float);
+template void advance_velocities(std::span<double>, double, double);
+
 } // namespace vps::particles
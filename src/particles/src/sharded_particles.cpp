@@ -0,0 +1,175 @@
+#include "vps/particles/sharded_particles.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef VPS_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace vps::particles {
+
+// =============================================================================
+// ShardExecutor
+// =============================================================================
+
+struct ShardExecutor::State {
+    std::vector<memory::NumaNode> nodes;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable start;       ///< Signals a new generation or stop
+    std::condition_variable done;        ///< Signals pending reached zero
+    const std::function<void(std::size_t)>* task = nullptr;
+    std::size_t generation = 0;
+    std::size_t pending = 0;
+    bool stop = false;
+    std::exception_ptr error;
+
+    void work(std::size_t i) {
+        memory::pin_current_thread(nodes[i].cpus);
+#ifdef VPS_ENABLE_OPENMP
+        omp_set_num_threads(static_cast<int>(nodes[i].cpus.size()));
+#endif
+        std::size_t seen = 0;
+        for (;;) {
+            const std::function<void(std::size_t)>* current = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                start.wait(lock, [&] { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+                current = task;
+            }
+
+            std::exception_ptr failure;
+            try {
+                (*current)(i);
+            } catch (...) {
+                failure = std::current_exception();
+            }
+
+            std::lock_guard lock(mutex);
+            if (failure && !error) {
+                error = failure;
+            }
+            if (--pending == 0) {
+                done.notify_all();
+            }
+        }
+    }
+};
+
+ShardExecutor::ShardExecutor(std::vector<memory::NumaNode> nodes)
+    : state_(std::make_unique<State>())
+{
+    if (nodes.empty()) {
+        throw std::invalid_argument("ShardExecutor needs at least one node");
+    }
+    state_->nodes = std::move(nodes);
+    state_->threads.reserve(state_->nodes.size());
+    try {
+        for (std::size_t i = 0; i < state_->nodes.size(); ++i) {
+            state_->threads.emplace_back([state = state_.get(), i] { state->work(i); });
+        }
+    } catch (...) {
+        stop_and_join();
+        throw;
+    }
+}
+
+ShardExecutor::~ShardExecutor() {
+    stop_and_join();
+}
+
+void ShardExecutor::stop_and_join() noexcept {
+    {
+        std::lock_guard lock(state_->mutex);
+        state_->stop = true;
+    }
+    state_->start.notify_all();
+    for (auto& thread : state_->threads) {
+        thread.join();
+    }
+}
+
+std::size_t ShardExecutor::size() const noexcept {
+    return state_->nodes.size();
+}
+
+const memory::NumaNode& ShardExecutor::node(std::size_t i) const noexcept {
+    return state_->nodes[i];
+}
+
+void ShardExecutor::run(const std::function<void(std::size_t)>& task) {
+    std::unique_lock lock(state_->mutex);
+    state_->task = &task;
+    state_->pending = state_->threads.size();
+    state_->error = nullptr;
+    ++state_->generation;
+    state_->start.notify_all();
+
+    state_->done.wait(lock, [&] { return state_->pending == 0; });
+    state_->task = nullptr;
+    if (state_->error) {
+        std::rethrow_exception(std::exchange(state_->error, nullptr));
+    }
+}
+
+// =============================================================================
+// BasicShardedParticles
+// =============================================================================
+
+template <std::floating_point T>
+BasicShardedParticles<T>::BasicShardedParticles(std::vector<memory::NumaNode> nodes)
+    : executor_(std::make_unique<ShardExecutor>(std::move(nodes)))
+{
+    shards_.resize(executor_->size());
+}
+
+template <std::floating_point T>
+typename BasicShardedParticles<T>::size_type
+BasicShardedParticles<T>::n_shards() const noexcept {
+    return shards_.size();
+}
+
+template <std::floating_point T>
+typename BasicShardedParticles<T>::size_type BasicShardedParticles<T>::size() const noexcept {
+    size_type total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.size();
+    }
+    return total;
+}
+
+template <std::floating_point T>
+typename BasicShardedParticles<T>::particles_type&
+BasicShardedParticles<T>::shard(size_type i) noexcept {
+    return shards_[i];
+}
+
+template <std::floating_point T>
+const typename BasicShardedParticles<T>::particles_type&
+BasicShardedParticles<T>::shard(size_type i) const noexcept {
+    return shards_[i];
+}
+
+template <std::floating_point T>
+const memory::NumaNode& BasicShardedParticles<T>::node(size_type i) const noexcept {
+    return executor_->node(i);
+}
+
+// =============================================================================
+// Explicit Instantiations
+// =============================================================================
+
+template class BasicShardedParticles<float>;
+template class BasicShardedParticles<double>;
+
+} // namespace vps::particles
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <vps/particles/aosoa.h>
+
+#include <cstdint>
+
+namespace vps::particles::test {
+
+// =============================================================================
+// TiledParticles Tests
+// =============================================================================
+
+using Tiled8 = TiledParticles<double, 8>;
+using Tiled16F = TiledParticles<float, 16>;
+
+TEST(TiledParticlesTest, DefaultConstruction) {
+    Tiled8 p;
+    EXPECT_TRUE(p.empty());
+    EXPECT_EQ(p.size(), 0);
+    EXPECT_EQ(p.n_tiles(), 0);
+    EXPECT_TRUE(p.tiles().empty());
+}
+
+TEST(TiledParticlesTest, TileLayout) {
+    // x, v and f of one tile are W-wide blocks back to back
+    EXPECT_EQ(sizeof(Tiled8::Tile), 3 * 8 * sizeof(double));
+    EXPECT_EQ(sizeof(Tiled16F::Tile), 3 * 16 * sizeof(float));
+    EXPECT_EQ(alignof(Tiled8::Tile), memory::default_alignment);
+}
+
+TEST(TiledParticlesTest, CapacityIsWholeTiles) {
+    Tiled8 p(10);
+    EXPECT_EQ(p.capacity(), 16);
+    EXPECT_TRUE(p.empty());
+}
+
+TEST(TiledParticlesTest, PushBackAndAccess) {
+    Tiled8 p;
+    for (int i = 0; i < 20; ++i) {
+        p.push_back(i, 10.0 * i, 100.0 * i);
+    }
+
+    EXPECT_EQ(p.size(), 20);
+    EXPECT_EQ(p.n_tiles(), 3);
+    for (std::size_t i = 0; i < 20; ++i) {
+        EXPECT_DOUBLE_EQ(p.x(i), static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(p.v(i), 10.0 * static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(p.f(i), 100.0 * static_cast<double>(i));
+    }
+}
+
+TEST(TiledParticlesTest, TilesExposeFixedWidthBlocks) {
+    Tiled8 p;
+    for (int i = 0; i < 12; ++i) {
+        p.push_back(i, -i, 1.0);
+    }
+
+    const auto tiles = p.tiles();
+    ASSERT_EQ(tiles.size(), 2);
+    EXPECT_DOUBLE_EQ(tiles[1].x[0], 8.0);
+    EXPECT_DOUBLE_EQ(tiles[1].v[3], -11.0);
+
+    // Padding lanes of the last tile are zero
+    for (std::size_t l = 4; l < 8; ++l) {
+        EXPECT_DOUBLE_EQ(tiles[1].x[l], 0.0);
+        EXPECT_DOUBLE_EQ(tiles[1].f[l], 0.0);
+    }
+
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&tile) % memory::default_alignment, 0);
+    }
+}
+
+TEST(TiledParticlesTest, ResizeAfterShrinkZeroes) {
+    Tiled8 p;
+    for (int i = 0; i < 10; ++i) {
+        p.push_back(1.0, 2.0, 3.0);
+    }
+    p.resize(3);
+    p.resize(10);
+
+    for (std::size_t i = 3; i < 10; ++i) {
+        EXPECT_DOUBLE_EQ(p.x(i), 0.0);
+        EXPECT_DOUBLE_EQ(p.v(i), 0.0);
+        EXPECT_DOUBLE_EQ(p.f(i), 0.0);
+    }
+    EXPECT_DOUBLE_EQ(p.x(2), 1.0);
+}
+
+TEST(TiledParticlesTest, FromParticles) {
+    ParticlesF soa;
+    for (int i = 0; i < 37; ++i) {
+        soa.push_back(0.5f * i, 1.0f, 0.25f * i);
+    }
+
+    Tiled16F tiled(soa);
+    ASSERT_EQ(tiled.size(), soa.size());
+    EXPECT_EQ(tiled.n_tiles(), 3);
+    for (std::size_t i = 0; i < soa.size(); ++i) {
+        EXPECT_FLOAT_EQ(tiled.x(i), soa.x(i));
+        EXPECT_FLOAT_EQ(tiled.v(i), soa.v(i));
+        EXPECT_FLOAT_EQ(tiled.f(i), soa.f(i));
+    }
+}
+
+TEST(TiledParticlesTest, CopyAndMove) {
+    Tiled8 a;
+    a.push_back(1.0, 2.0, 3.0);
+
+    Tiled8 b(a);
+    b.x(0) = 5.0;
+    EXPECT_DOUBLE_EQ(a.x(0), 1.0);
+    EXPECT_DOUBLE_EQ(b.x(0), 5.0);
+
+    Tiled8 c(std::move(b));
+    EXPECT_EQ(c.size(), 1);
+    EXPECT_TRUE(b.empty());  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(TiledParticlesTest, AdvancePositionsMatchesSoA) {
+    Particles soa;
+    for (int i = 0; i < 29; ++i) {
+        soa.push_back(0.1 * i, 1.0 - 0.05 * i, 1.0);
+    }
+    Tiled8 tiled(soa);
+
+    advance_positions(soa, 0.3);
+    advance_positions(tiled, 0.3);
+
+    for (std::size_t i = 0; i < soa.size(); ++i) {
+        EXPECT_DOUBLE_EQ(tiled.x(i), soa.x(i));
+    }
+}
+
+} // namespace vps::particles::test
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <vps/memory/task_pool.h>
+#include <vps/particles/dispatch.h>
+#include <vps/particles/injector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace vps::particles::test {
+
+// =============================================================================
+// Injector Tests
+// =============================================================================
+
+TEST(InjectorTest, MergeAppendsAfterExistingPoints) {
+    Particles p(3, 0.5, 1.0, 2.0);
+    Injector source(2);
+    source.push(0, 0.1, 0.2, 0.3);
+    source.push(1, 0.4, 0.5, 0.6);
+    source.push(0, 0.7, 0.8, 0.9);
+    EXPECT_EQ(source.size(), 3u);
+
+    EXPECT_EQ(source.merge_into(p), 3u);
+
+    ASSERT_EQ(p.size(), 6u);
+    EXPECT_DOUBLE_EQ(p.x(2), 0.5);
+    // Lane order: lane 0's points, then lane 1's
+    EXPECT_DOUBLE_EQ(p.x(3), 0.1);
+    EXPECT_DOUBLE_EQ(p.v(4), 0.8);
+    EXPECT_DOUBLE_EQ(p.f(5), 0.6);
+    EXPECT_TRUE(source.empty());
+}
+
+TEST(InjectorTest, MergeEmptyLeavesTarget) {
+    Particles p(4, 0.5, 1.0, 2.0);
+    Injector source;
+    EXPECT_GE(source.n_lanes(), 1u);
+
+    EXPECT_EQ(source.merge_into(p), 0u);
+    EXPECT_EQ(p.size(), 4u);
+}
+
+TEST(InjectorTest, ParallelPushesAreAllMerged) {
+    const std::size_t n = 20000;
+    Particles p;
+    Injector source;
+
+#ifdef VPS_ENABLE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto id = static_cast<double>(i);
+        source.push(id, -id, 2.0 * id);
+    }
+    ASSERT_EQ(source.size(), n);
+    source.merge_into(p);
+
+    ASSERT_EQ(p.size(), n);
+    std::vector<double> ids(p.x().begin(), p.x().end());
+    std::sort(ids.begin(), ids.end());
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(ids[i], static_cast<double>(i));
+    }
+    // Columns stay together through the merge
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(p.v(i), -p.x(i));
+        ASSERT_DOUBLE_EQ(p.f(i), 2.0 * p.x(i));
+    }
+}
+
+TEST(InjectorTest, KernelSweepPushesAreAllMerged) {
+    const std::size_t n = 20000;
+    const std::size_t saved = parallel_grain();
+    set_parallel_grain(1);  // a full team even on a small sweep
+    Particles p;
+    Injector source;
+
+    parallel_for(n, [&](std::size_t i) {
+        const auto id = static_cast<double>(i);
+        source.push(id, -id, 2.0 * id);
+    });
+    set_parallel_grain(saved);
+    ASSERT_EQ(source.size(), n);
+    source.merge_into(p);
+
+    ASSERT_EQ(p.size(), n);
+    std::vector<double> ids(p.x().begin(), p.x().end());
+    std::sort(ids.begin(), ids.end());
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(ids[i], static_cast<double>(i));
+    }
+}
+
+#ifdef VPS_ENABLE_TASKS
+TEST(InjectorTest, PoolWorkersPushToOwnLanes) {
+    // Several workers on one CPU, so the sweep is concurrent on any host
+    const unsigned cpu = memory::numa_nodes().front().cpus.front();
+    memory::TaskPool pool({memory::NumaNode{0, {cpu, cpu, cpu, cpu}}});
+    const std::size_t n = 20000;
+    Injector source(pool.size());
+
+    pool.parallel_for(n, [&](std::size_t i) {
+        source.push(static_cast<double>(i), 0.0, 1.0);
+    });
+
+    ASSERT_EQ(source.size(), n);
+    Particles p;
+    source.merge_into(p);
+    std::vector<double> ids(p.x().begin(), p.x().end());
+    std::sort(ids.begin(), ids.end());
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(ids[i], static_cast<double>(i));
+    }
+}
+#endif
+
+TEST(InjectorTest, ExplicitLanesFromThreads) {
+    InjectorF source(4);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&source, t] {
+            for (int i = 0; i < 1000; ++i) {
+                source.push(t, static_cast<float>(t), 0.0f, 1.0f);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ParticlesF p;
+    source.merge_into(p);
+
+    ASSERT_EQ(p.size(), 4000u);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        ASSERT_FLOAT_EQ(p.x(i), static_cast<float>(i / 1000));
+    }
+}
+
+TEST(InjectorTest, LanesKeepCapacityAcrossSteps) {
+    Injector source(1);
+    Particles p;
+    for (int i = 0; i < 100; ++i) {
+        source.push(0, 0.0, 0.0, 1.0);
+    }
+    source.merge_into(p);
+    const std::size_t capacity = source.lane(0).capacity();
+
+    for (int i = 0; i < 100; ++i) {
+        source.push(0, 0.0, 0.0, 1.0);
+    }
+    EXPECT_EQ(source.lane(0).capacity(), capacity);
+    source.merge_into(p);
+    EXPECT_EQ(p.size(), 200u);
+}
+
+} // namespace vps::particles::test
@@ -1,8 +1,17 @@
 #include <gtest/gtest.h>
+#include <vps/particles/dispatch.h>
 #include <vps/particles/particles.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <numeric>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace vps::particles::test {
 
@@ -146,6 +155,103 @@ TEST(ParticlesTest, RawDataAccess) {
     EXPECT_DOUBLE_EQ(p.x(0), 999.0);
 }
 
+TEST(ParticlesTest, AlignedSpansArePaddedAndAligned) {
+    Particles p(Particles::lanes + 1, 1.0, 2.0, 3.0);
+
+    EXPECT_EQ(p.padded_size(), 2 * Particles::lanes);
+    for (auto span : {p.aligned_x(), p.aligned_v(), p.aligned_f()}) {
+        EXPECT_EQ(span.size(), p.padded_size());
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(span.data()) % Particles::alignment, 0);
+    }
+    EXPECT_EQ(p.aligned_x().data(), p.x_data());
+}
+
+TEST(ParticlesTest, PaddingTracksSize) {
+    Particles p;
+    EXPECT_EQ(p.padded_size(), 0);
+
+    p.push_back(1.0, 2.0, 3.0);
+    EXPECT_EQ(p.padded_size(), Particles::lanes);
+
+    p.resize(Particles::lanes);
+    EXPECT_EQ(p.padded_size(), Particles::lanes);
+
+    p.pop_back();
+    EXPECT_EQ(p.size(), Particles::lanes - 1);
+    EXPECT_EQ(p.padded_size(), Particles::lanes);
+}
+
+TEST(ParticlesTest, ResizeAfterShrinkOverwritesPadding) {
+    Particles p(4, 1.0, 2.0, 3.0);
+    p.resize(1);
+    p.resize(4);
+
+    // Points re-exposed from the padding are value-initialized, not stale
+    EXPECT_DOUBLE_EQ(p.x(3), 0.0);
+    EXPECT_DOUBLE_EQ(p.v(3), 0.0);
+    EXPECT_DOUBLE_EQ(p.f(3), 0.0);
+}
+
+TEST(ParticlesTest, ColumnsShareOneSlab) {
+    Particles p(100);
+
+    // x, v and f are fixed-offset sub-arrays of one allocation
+    EXPECT_EQ(p.v_data() - p.x_data(), static_cast<std::ptrdiff_t>(p.capacity()));
+    EXPECT_EQ(p.f_data() - p.v_data(), static_cast<std::ptrdiff_t>(p.capacity()));
+}
+
+TEST(ParticlesTest, GrowthPreservesAllColumns) {
+    Particles p(2);
+    for (int i = 0; i < 1000; ++i) {
+        p.push_back(i, 2.0 * i, 3.0 * i);
+    }
+
+    EXPECT_GE(p.capacity(), 1000);
+    EXPECT_EQ(p.v_data() - p.x_data(), static_cast<std::ptrdiff_t>(p.capacity()));
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        const auto d = static_cast<double>(i);
+        EXPECT_DOUBLE_EQ(p.x(i), d);
+        EXPECT_DOUBLE_EQ(p.v(i), 2.0 * d);
+        EXPECT_DOUBLE_EQ(p.f(i), 3.0 * d);
+    }
+}
+
+TEST(ParticlesTest, PageAlignedColumns) {
+    const auto policy = memory::AllocationPolicy::page_aligned();
+    Particles p(10, policy);
+    p.resize(10, 1.0, 2.0, 3.0);
+
+    EXPECT_TRUE(p.allocation_policy().is_page_aligned());
+    for (const double* data : {p.x_data(), p.v_data(), p.f_data()}) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(data) % memory::page_size(), 0);
+    }
+    EXPECT_DOUBLE_EQ(p.f(9), 3.0);
+
+    // Copies keep the policy
+    Particles q(p);
+    EXPECT_TRUE(q.allocation_policy().is_page_aligned());
+    EXPECT_DOUBLE_EQ(q.v(9), 2.0);
+}
+
+TEST(ParticlesTest, CopyAssignment) {
+    Particles p1(5, 1.0, 2.0, 3.0);
+    Particles p2;
+    p2 = p1;
+
+    p1.x(0) = 999.0;
+    EXPECT_EQ(p2.size(), 5);
+    EXPECT_DOUBLE_EQ(p2.x(0), 1.0);
+    EXPECT_DOUBLE_EQ(p2.f(4), 3.0);
+}
+
+TEST(ParticlesTest, MovedFromIsEmpty) {
+    Particles p1(5, 1.0, 2.0, 3.0);
+    Particles p2(std::move(p1));
+
+    EXPECT_TRUE(p1.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(p1.x().size(), 0);
+}
+
 // =============================================================================
 // Modifier Tests
 // =============================================================================
@@ -176,6 +282,43 @@ TEST(ParticlesTest, PopBack) {
     EXPECT_DOUBLE_EQ(p.x(0), 1.0);
 }
 
+TEST(ParticlesTest, EraseIfAbsorbingBoundary) {
+    Particles p;
+    for (int i = 0; i < 10; ++i) {
+        p.push_back(0.25 * i - 0.5, static_cast<double>(i), 10.0 * i);
+    }
+    const auto x = p.x();
+
+    const auto removed = p.erase_if([&](std::size_t i) { return x[i] < 0.0 || x[i] >= 1.0; });
+
+    EXPECT_EQ(removed, 6);
+    ASSERT_EQ(p.size(), 4);
+    for (std::size_t k = 0; k < p.size(); ++k) {
+        EXPECT_DOUBLE_EQ(p.x(k), 0.25 * static_cast<double>(k));
+        EXPECT_DOUBLE_EQ(p.v(k), static_cast<double>(k + 2));
+        EXPECT_DOUBLE_EQ(p.f(k), 10.0 * static_cast<double>(k + 2));
+    }
+}
+
+TEST(ParticlesTest, EraseIfUnorderedKeepsPointsIntact) {
+    Particles p;
+    p.fill_with(50'000, [](std::size_t i) {
+        const double d = static_cast<double>(i);
+        return std::array{d, 2.0 * d, 3.0 * d};
+    });
+    const auto f = p.f();
+
+    const auto removed = p.erase_if_unordered([&](std::size_t i) { return f[i] < 3.0 * 1000.0; });
+
+    EXPECT_EQ(removed, 1000);
+    ASSERT_EQ(p.size(), 49'000);
+    for (std::size_t k = 0; k < p.size(); ++k) {
+        ASSERT_GE(p.x(k), 1000.0);
+        ASSERT_DOUBLE_EQ(p.v(k), 2.0 * p.x(k));
+        ASSERT_DOUBLE_EQ(p.f(k), 3.0 * p.x(k));
+    }
+}
+
 // =============================================================================
 // Free Function Tests
 // =============================================================================
@@ -230,6 +373,163 @@ TEST(ParticlesTest, FreeStreamingMultipleSteps) {
     EXPECT_NEAR(p.x(0), 1.0, 1e-10);
 }
 
+// =============================================================================
+// Single-Precision Tests
+// =============================================================================
+
+TEST(ParticlesFTest, LanesDoubleForFloat) {
+    EXPECT_EQ(ParticlesF::lanes, 2 * Particles::lanes);
+
+    ParticlesF p(3, 1.0f, 2.0f, 3.0f);
+    EXPECT_EQ(p.padded_size(), ParticlesF::lanes);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.v_data()) % ParticlesF::alignment, 0);
+}
+
+TEST(ParticlesFTest, AdvancePositionsAndVelocities) {
+    ParticlesF p;
+    p.push_back(0.0f, 1.0f, 1.0f);
+    p.push_back(1.0f, -2.0f, 1.0f);
+
+    advance_velocities(p, 2.0f, 0.5f);
+    advance_positions(p, 0.5f);
+
+    EXPECT_FLOAT_EQ(p.v(0), 2.0f);
+    EXPECT_FLOAT_EQ(p.v(1), -1.0f);
+    EXPECT_FLOAT_EQ(p.x(0), 1.0f);
+    EXPECT_FLOAT_EQ(p.x(1), 0.5f);
+}
+
+TEST(ParticlesFTest, DoubleTimeStepConverts) {
+    ParticlesF p(1, 0.0f, 1.0f, 1.0f);
+    advance_positions(p, 0.25);  // dt is taken in the container's precision
+    EXPECT_FLOAT_EQ(p.x(0), 0.25f);
+}
+
+TEST(ParticlesTest, HugePageStorage) {
+    Particles p(16, memory::AllocationPolicy::huge(memory::HugePages::Transparent));
+    for (int i = 0; i < 5000; ++i) {
+        p.push_back(i, 1.0, 2.0);
+    }
+
+    // Growth reallocates with the same policy
+    EXPECT_EQ(p.allocation_policy().huge_pages, memory::HugePages::Transparent);
+#ifdef __linux__
+    EXPECT_NE(p.allocation_report().backing, memory::Backing::Heap);
+#endif
+    EXPECT_DOUBLE_EQ(p.x(4999), 4999.0);
+    EXPECT_DOUBLE_EQ(p.f(0), 2.0);
+}
+
+// =============================================================================
+// Bulk Construction Tests
+// =============================================================================
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(ParticlesTest, OutOfCoreStorage) {
+    Particles p(0, memory::AllocationPolicy::out_of_core(::testing::TempDir()));
+    p.fill_with(10'000, [](std::size_t i) {
+        return std::array{static_cast<double>(i), 1.0, 2.0};
+    });
+
+    // Growth keeps the file backing
+    EXPECT_TRUE(p.file_backed());
+    EXPECT_EQ(p.allocation_report().backing, memory::Backing::File);
+
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    p.stream([&](std::size_t first, std::size_t last) { chunks.emplace_back(first, last); },
+             1000);
+    ASSERT_GT(chunks.size(), 1u);
+    EXPECT_EQ(chunks.front().first, 0u);
+    EXPECT_EQ(chunks.back().second, p.size());
+    for (std::size_t c = 1; c < chunks.size(); ++c) {
+        EXPECT_EQ(chunks[c].first, chunks[c - 1].second);
+        EXPECT_EQ(chunks[c].first % Particles::lanes, 0u);
+    }
+
+    advance_positions(p, 0.5);
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        ASSERT_DOUBLE_EQ(p.x(i), static_cast<double>(i) + 0.5);
+    }
+}
+#endif
+
+TEST(ParticlesTest, StreamInMemoryIsOneChunk) {
+    Particles p(100, 0.0, 1.0, 1.0);
+    int calls = 0;
+    p.stream([&](std::size_t first, std::size_t last) {
+        EXPECT_EQ(first, 0u);
+        EXPECT_EQ(last, 100u);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(ParticlesTest, Append) {
+    Particles p;
+    p.push_back(0.0, 0.0, 0.0);
+
+    const std::vector<double> xs{1.0, 2.0};
+    const std::vector<double> vs{3.0, 4.0};
+    const std::vector<double> fs{5.0, 6.0};
+    p.append(xs, vs, fs);
+
+    ASSERT_EQ(p.size(), 3);
+    EXPECT_DOUBLE_EQ(p.x(1), 1.0);
+    EXPECT_DOUBLE_EQ(p.v(2), 4.0);
+    EXPECT_DOUBLE_EQ(p.f(2), 6.0);
+}
+
+TEST(ParticlesTest, AppendEmpty) {
+    Particles p(2, 1.0, 1.0, 1.0);
+    p.append({}, {}, {});
+    EXPECT_EQ(p.size(), 2);
+}
+
+TEST(ParticlesTest, ResizeUninitialized) {
+    Particles p(3, 1.0, 2.0, 3.0);
+    p.resize_uninitialized(100);
+
+    EXPECT_EQ(p.size(), 100);
+    EXPECT_GE(p.capacity(), 100);
+    // Existing points survive
+    EXPECT_DOUBLE_EQ(p.x(2), 1.0);
+    EXPECT_DOUBLE_EQ(p.f(2), 3.0);
+}
+
+TEST(ParticlesTest, FillWith) {
+    Particles p(4, 9.0, 9.0, 9.0);
+    const std::size_t n = 3 * Particles::lanes + 5;
+
+    p.fill_with(n, [](std::size_t i) {
+        const auto d = static_cast<double>(i);
+        return std::tuple{d, 2.0 * d, 1.0};
+    });
+
+    ASSERT_EQ(p.size(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(p.x(i), static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(p.v(i), 2.0 * static_cast<double>(i));
+        EXPECT_DOUBLE_EQ(p.f(i), 1.0);
+    }
+
+    // Padding past size() stays zero for aligned kernels
+    const auto xs = p.aligned_x();
+    for (std::size_t i = n; i < p.padded_size(); ++i) {
+        EXPECT_DOUBLE_EQ(xs[i], 0.0);
+    }
+}
+
+TEST(ParticlesFTest, FillWithConverts) {
+    ParticlesF p;
+    p.fill_with(8, [](std::size_t i) {
+        return std::array{0.5 * static_cast<double>(i), 1.0, 0.25};
+    });
+
+    ASSERT_EQ(p.size(), 8);
+    EXPECT_FLOAT_EQ(p.x(7), 3.5f);
+    EXPECT_FLOAT_EQ(p.f(0), 0.25f);
+}
+
 // =============================================================================
 // Performance/Stress Tests
 // =============================================================================
@@ -248,4 +548,97 @@ TEST(ParticlesTest, LargeAllocation) {
     EXPECT_DOUBLE_EQ(p.x(n - 1), 0.1);
 }
 
+TEST(ParticlesTest, AdvancePositionsOddSize) {
+    // Size deliberately not a multiple of the SIMD width
+    const std::size_t n = 3 * Particles::lanes + 1;
+    Particles p;
+    for (std::size_t i = 0; i < n; ++i) {
+        p.push_back(static_cast<double>(i), 1.0, 1.0);
+    }
+
+    advance_positions(p, 0.5);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(p.x(i), static_cast<double>(i) + 0.5);
+    }
+}
+
+TEST(ParticlesTest, AdvanceSpansMultipleBlocks) {
+    // Several dispatch blocks plus a partial one
+    const std::size_t n = 2 * memory::kernel_block + 5;
+    Particles p;
+    p.fill_with(n, [](std::size_t i) {
+        return std::tuple{static_cast<double>(i), static_cast<double>(i % 7), 1.0};
+    });
+
+    advance_velocities(p, 2.0, 0.5);
+    advance_positions(p.x(), std::span<const double>(p.v()), 0.25);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const double v = static_cast<double>(i % 7) + 1.0;
+        ASSERT_DOUBLE_EQ(p.v(i), v);
+        ASSERT_DOUBLE_EQ(p.x(i), static_cast<double>(i) + 0.25 * v);
+    }
+}
+
+// =============================================================================
+// Dispatch Block Tests
+// =============================================================================
+
+TEST(DispatchTest, BlocksCoverRangeOnce) {
+    for (const std::size_t n : {std::size_t{0}, std::size_t{1}, memory::kernel_block,
+                                3 * memory::kernel_block + 17}) {
+        std::vector<int> hits(n, 0);
+        for_each_block(n, [&](std::size_t first, std::size_t count) {
+            EXPECT_EQ(first % memory::kernel_block, 0u);
+            EXPECT_LE(count, memory::kernel_block);
+            for (std::size_t i = first; i < first + count; ++i) {
+                ++hits[i];
+            }
+        });
+        EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), static_cast<std::ptrdiff_t>(n));
+    }
+}
+
+TEST(DispatchTest, GrainSizesTheTeam) {
+    const std::size_t saved = parallel_grain();
+    const std::size_t workers = max_workers();
+
+    set_parallel_grain(1000);
+    EXPECT_EQ(parallel_grain(), 1000u);
+    EXPECT_EQ(team_size(0), 1u);
+    EXPECT_EQ(team_size(1999), std::min<std::size_t>(1, workers));
+    EXPECT_EQ(team_size(3000), std::min<std::size_t>(3, workers));
+    EXPECT_EQ(team_size(std::size_t{1} << 40), workers);
+    EXPECT_FALSE(run_parallel(999));
+    EXPECT_EQ(run_parallel(1u << 20), workers > 1);
+
+    set_parallel_grain(0);
+    EXPECT_EQ(parallel_grain(), 1u);
+
+    set_parallel_grain(saved);
+}
+
+TEST(DispatchTest, ParallelForCoversRangeAtAnyGrain) {
+    const std::size_t saved = parallel_grain();
+    for (const std::size_t grain : {std::size_t{1}, std::size_t{1} << 40}) {
+        set_parallel_grain(grain);
+        for (const std::size_t n : {std::size_t{1}, std::size_t{7}, std::size_t{1000}}) {
+            std::vector<int> hits(n, 0);
+            parallel_for(n, [&](std::size_t i) { ++hits[i]; });
+            EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), static_cast<std::ptrdiff_t>(n));
+        }
+    }
+    set_parallel_grain(saved);
+}
+
+TEST(DispatchTest, CalibratedGrainIsBounded) {
+    const std::size_t saved = parallel_grain();
+    const std::size_t grain = calibrate_parallel_grain();
+    EXPECT_EQ(parallel_grain(), grain);
+    EXPECT_GE(grain, 256u);
+    EXPECT_LE(grain, std::size_t{1} << 22);
+    set_parallel_grain(saved);
+}
+
 } // namespace vps::particles::test
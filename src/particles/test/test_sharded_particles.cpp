@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <vps/particles/sharded_particles.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace vps::particles::test {
+
+namespace {
+
+/// Two logical nodes sharing the host's first node, so multi-shard paths
+/// run on single-socket machines too
+std::vector<memory::NumaNode> two_nodes() {
+    const auto host = memory::numa_nodes();
+    return {memory::NumaNode{0, host.front().cpus}, memory::NumaNode{1, host.front().cpus}};
+}
+
+} // namespace
+
+// =============================================================================
+// First-Touch Tests
+// =============================================================================
+
+TEST(FirstTouchTest, ConstructWithPolicy) {
+    const std::size_t n = 3 * Particles::lanes + 1;
+    Particles p(n, 1.0, 2.0, 3.0, memory::AllocationPolicy::numa_first_touch());
+
+    EXPECT_EQ(p.size(), n);
+    EXPECT_TRUE(p.allocation_policy().first_touch);
+    for (std::size_t i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(p.x(i), 1.0);
+        EXPECT_DOUBLE_EQ(p.f(i), 3.0);
+    }
+}
+
+TEST(FirstTouchTest, GrowthKeepsData) {
+    Particles p(4, memory::AllocationPolicy::numa_first_touch());
+    for (int i = 0; i < 1000; ++i) {
+        p.push_back(i, 0.0, 1.0);
+    }
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        EXPECT_DOUBLE_EQ(p.x(i), static_cast<double>(i));
+    }
+}
+
+// =============================================================================
+// ShardedParticles Tests
+// =============================================================================
+
+TEST(ShardedParticlesTest, OneShardPerHostNode) {
+    ShardedParticles p;
+    EXPECT_EQ(p.n_shards(), memory::numa_nodes().size());
+    EXPECT_EQ(p.size(), 0);
+}
+
+TEST(ShardedParticlesTest, EmptyTopologyThrows) {
+    EXPECT_THROW(ShardedParticles(std::vector<memory::NumaNode>{}), std::invalid_argument);
+}
+
+TEST(ShardedParticlesTest, FillSplitsContiguousRanges) {
+    ShardedParticles p(two_nodes());
+    const std::size_t n = 1001;
+    p.fill_with(n, [](std::size_t i) {
+        return std::tuple{static_cast<double>(i), 1.0, 0.5};
+    });
+
+    ASSERT_EQ(p.n_shards(), 2);
+    EXPECT_EQ(p.size(), n);
+    EXPECT_EQ(p.shard(0).size(), n / 2);
+
+    // Global order is shard 0 followed by shard 1
+    std::size_t next = 0;
+    for (std::size_t s = 0; s < p.n_shards(); ++s) {
+        for (std::size_t i = 0; i < p.shard(s).size(); ++i) {
+            EXPECT_DOUBLE_EQ(p.shard(s).x(i), static_cast<double>(next++));
+        }
+    }
+}
+
+TEST(ShardedParticlesTest, ForEachShardVisitsEveryShard) {
+    ShardedParticles p(two_nodes());
+    std::atomic<int> visited{0};
+    p.for_each_shard([&](Particles&, std::size_t s) { visited += 1 << s; });
+    EXPECT_EQ(visited.load(), 0b11);
+}
+
+TEST(ShardedParticlesTest, ForEachShardRethrows) {
+    ShardedParticles p(two_nodes());
+    EXPECT_THROW(p.for_each_shard([](Particles&, std::size_t s) {
+        if (s == 1) {
+            throw std::runtime_error("shard failure");
+        }
+    }), std::runtime_error);
+
+    // The executor stays usable after a failed run
+    std::atomic<int> visited{0};
+    p.for_each_shard([&](Particles&, std::size_t) { ++visited; });
+    EXPECT_EQ(visited.load(), 2);
+}
+
+TEST(ShardedParticlesTest, AdvancePositions) {
+    ShardedParticlesF p(two_nodes());
+    p.fill_with(100, [](std::size_t) { return std::tuple{0.0f, 2.0f, 1.0f}; });
+
+    advance_positions(p, 0.25f);
+
+    for (std::size_t s = 0; s < p.n_shards(); ++s) {
+        for (std::size_t i = 0; i < p.shard(s).size(); ++i) {
+            EXPECT_FLOAT_EQ(p.shard(s).x(i), 0.5f);
+        }
+    }
+}
+
+} // namespace vps::particles::test
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include <vps/memory/arena.h>
+#include <vps/particles/particles.h>
+#include <vps/particles/soa.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace vps::particles::test {
+
+using X = columns::X<double>;
+using V = columns::V<double>;
+using F = columns::F<double>;
+using Tracked = ParticleSchema<double, columns::SpeciesId, columns::ChargeToMass<double>,
+                               columns::TracerId, columns::VelocityIndex>;
+
+// =============================================================================
+// Schema Tests
+// =============================================================================
+
+TEST(SoATest, CompileTimeColumns) {
+    static_assert(Tracked::n_columns == 7);
+    static_assert(Tracked::has<columns::TracerId>);
+    static_assert(!ParticleSchema<double>::has<columns::TracerId>);
+    static_assert(Tracked::index_of<F> == 2);
+    static_assert(Tracked::index_of<columns::VelocityIndex> == 6);
+
+    // Padding must be a whole SIMD block for the narrowest column
+    EXPECT_EQ(Tracked::lanes, memory::simd_lanes<std::uint16_t>);
+}
+
+TEST(SoATest, PushBackAndAccess) {
+    Tracked p;
+    p.push_back(0.5, 1.0, 0.1, std::uint16_t{2}, -1.0, std::uint64_t{42}, std::uint32_t{7});
+
+    ASSERT_EQ(p.size(), 1);
+    EXPECT_DOUBLE_EQ(p.at<X>(0), 0.5);
+    EXPECT_EQ(p.at<columns::SpeciesId>(0), 2);
+    EXPECT_DOUBLE_EQ(p.at<columns::ChargeToMass<double>>(0), -1.0);
+    EXPECT_EQ(get<columns::TracerId>(p)[0], 42);
+    EXPECT_EQ(p.get<columns::VelocityIndex>()[0], 7);
+}
+
+TEST(SoATest, ViewSelectsExactColumns) {
+    Tracked p;
+    p.resize(10, 0.0, 2.0, 1.0, std::uint16_t{0}, 1.0, std::uint64_t{0}, std::uint32_t{0});
+
+    auto [x, v] = p.view<X, V>();
+    static_assert(std::is_same_v<decltype(x), std::span<double>>);
+    EXPECT_EQ(x.size(), 10);
+
+    advance_positions(x, v, 0.5);
+    EXPECT_DOUBLE_EQ(p.at<X>(9), 1.0);
+}
+
+// =============================================================================
+// Layout Tests
+// =============================================================================
+
+TEST(SoATest, ColumnsAlignedInOneSlab) {
+    Tracked p(100);
+
+    const auto* base = reinterpret_cast<const std::byte*>(p.data<X>());
+    const auto* last = reinterpret_cast<const std::byte*>(p.data<columns::VelocityIndex>());
+    EXPECT_EQ(last - base, static_cast<std::ptrdiff_t>(p.capacity() * (3 * 8 + 2 + 8 + 8)));
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.data<columns::SpeciesId>()) % Tracked::alignment,
+              0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.data<columns::TracerId>()) % Tracked::alignment,
+              0);
+}
+
+TEST(SoATest, GrowthMovesEveryColumn) {
+    Tracked p;
+    for (std::uint32_t i = 0; i < 500; ++i) {
+        const double d = i;
+        p.push_back(d, 2 * d, 3 * d, static_cast<std::uint16_t>(i % 3), -d, std::uint64_t{i} << 32,
+                    i);
+    }
+
+    for (std::uint32_t i = 0; i < 500; ++i) {
+        const double d = i;
+        EXPECT_DOUBLE_EQ(p.at<V>(i), 2 * d);
+        EXPECT_EQ(p.at<columns::SpeciesId>(i), i % 3);
+        EXPECT_EQ(p.at<columns::TracerId>(i), std::uint64_t{i} << 32);
+        EXPECT_EQ(p.at<columns::VelocityIndex>(i), i);
+    }
+}
+
+TEST(SoATest, PageAlignedPolicy) {
+    Tracked p(10, memory::AllocationPolicy::page_aligned());
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.data<columns::SpeciesId>()) % memory::page_size(),
+              0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.data<columns::TracerId>()) % memory::page_size(),
+              0);
+}
+
+TEST(SoATest, CopyIsDeep) {
+    ParticleSchema<float, columns::TracerId> a;
+    a.push_back(1.0f, 2.0f, 3.0f, std::uint64_t{9});
+
+    auto b = a;
+    a.at<columns::TracerId>(0) = 0;
+
+    EXPECT_EQ(b.at<columns::TracerId>(0), 9);
+    EXPECT_FLOAT_EQ(b.at<columns::F<float>>(0), 3.0f);
+}
+
+TEST(SoATest, AppendColumnBlocks) {
+    Tracked soa;
+    soa.push_back(0.0, 0.0, 0.0, 7, 1.0, 7, 7);
+
+    const std::vector<double> xs{1.0, 2.0, 3.0};
+    const std::vector<double> vs{4.0, 5.0, 6.0};
+    const std::vector<double> fs{7.0, 8.0, 9.0};
+    const std::vector<std::uint16_t> species{1, 2, 3};
+    const std::vector<double> qm{-1.0, -1.0, 1.0};
+    const std::vector<std::uint64_t> ids{10, 11, 12};
+    const std::vector<std::uint32_t> vidx{0, 1, 2};
+    soa.append(xs, vs, fs, species, qm, ids, vidx);
+
+    ASSERT_EQ(soa.size(), 4);
+    EXPECT_EQ(soa.at<columns::SpeciesId>(0), 7);
+    EXPECT_DOUBLE_EQ(soa.at<X>(3), 3.0);
+    EXPECT_DOUBLE_EQ(soa.at<F>(2), 8.0);
+    EXPECT_EQ(soa.at<columns::TracerId>(1), 10);
+}
+
+TEST(SoATest, ResizeUninitializedZeroesPadding) {
+    SoA<X, V> soa;
+    soa.resize_uninitialized(5);
+    ASSERT_EQ(soa.size(), 5);
+    ASSERT_GT(soa.padded_size(), soa.size());
+
+    const auto x = soa.aligned<X>();
+    for (std::size_t i = soa.size(); i < soa.padded_size(); ++i) {
+        EXPECT_DOUBLE_EQ(x[i], 0.0);
+    }
+}
+
+TEST(SoATest, CompactPreservesOrder) {
+    SoA<X, columns::TracerId> soa;
+    const std::size_t n = 100'000;  // several compaction blocks
+    for (std::size_t i = 0; i < n; ++i) {
+        soa.push_back(static_cast<double>(i), std::uint64_t{i});
+    }
+    std::vector<std::uint8_t> keep(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keep[i] = (i % 3 != 0 && i < 90'000) ? 1 : 0;
+    }
+
+    const auto removed = soa.compact(keep);
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keep[i] != 0) {
+            ASSERT_EQ(soa.at<columns::TracerId>(expected), i);
+            ASSERT_DOUBLE_EQ(soa.at<X>(expected), static_cast<double>(i));
+            ++expected;
+        }
+    }
+    EXPECT_EQ(soa.size(), expected);
+    EXPECT_EQ(removed, n - expected);
+
+    const auto x = soa.aligned<X>();
+    for (std::size_t i = soa.size(); i < soa.padded_size(); ++i) {
+        EXPECT_DOUBLE_EQ(x[i], 0.0);
+    }
+}
+
+TEST(SoATest, CompactUnorderedKeepsSurvivorSet) {
+    SoA<X, columns::TracerId> soa;
+    const std::size_t n = 70'000;
+    for (std::size_t i = 0; i < n; ++i) {
+        soa.push_back(static_cast<double>(i), std::uint64_t{i});
+    }
+    std::vector<std::uint8_t> keep(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keep[i] = (i * 7919) % 5 < 3 ? 1 : 0;
+    }
+
+    const auto removed = soa.compact_unordered(keep);
+
+    std::vector<std::uint64_t> ids(soa.get<columns::TracerId>().begin(),
+                                   soa.get<columns::TracerId>().end());
+    std::sort(ids.begin(), ids.end());
+    std::vector<std::uint64_t> expected;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keep[i] != 0) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(ids, expected);
+    EXPECT_EQ(removed, n - expected.size());
+    for (std::size_t k = 0; k < soa.size(); ++k) {
+        ASSERT_DOUBLE_EQ(soa.at<X>(k), static_cast<double>(soa.at<columns::TracerId>(k)));
+    }
+}
+
+TEST(SoATest, CompactEdgeCases) {
+    SoA<X> soa;
+    EXPECT_EQ(soa.compact({}), 0);
+    EXPECT_EQ(soa.compact_unordered({}), 0);
+
+    soa.push_back(1.0);
+    soa.push_back(2.0);
+    EXPECT_EQ(soa.erase_if([](std::size_t) { return false; }), 0);
+    EXPECT_EQ(soa.size(), 2);
+    EXPECT_EQ(soa.erase_if_unordered([](std::size_t) { return true; }), 2);
+    EXPECT_TRUE(soa.empty());
+}
+
+TEST(SoATest, EraseIfDrawsScratchFromStepArena) {
+    constexpr std::size_t n = 100'000;
+    SoA<X, columns::TracerId> soa;
+    soa.reserve(n);
+
+    memory::StepArena arena;
+    memory::ScratchScope scope(arena);
+    std::size_t warm = 0;
+    for (int step = 0; step < 10; ++step) {
+        arena.reset();
+        if (step == 2) {
+            warm = arena.upstream_allocations();
+        }
+        while (soa.size() < n) {
+            const auto i = static_cast<std::uint32_t>(soa.size());
+            soa.push_back(static_cast<double>(i), i);
+        }
+        const auto x = soa.get<X>();
+        if (step % 2 == 0) {
+            soa.erase_if([&](std::size_t i) { return static_cast<std::size_t>(x[i]) % 3 == 0; });
+        } else {
+            soa.erase_if_unordered([&](std::size_t i) { return i % 5 == 0; });
+        }
+    }
+
+    EXPECT_GT(warm, 0u);
+    EXPECT_EQ(arena.upstream_allocations(), warm);
+    EXPECT_GE(arena.high_water(), n);  // the keep mask, one byte per point
+}
+
+TEST(SoATest, ParticlesExposesSchema) {
+    Particles p(4, 1.0, 2.0, 3.0);
+
+    auto [f] = p.soa().view<F>();
+    EXPECT_EQ(f.data(), p.f_data());
+    EXPECT_EQ(f.size(), 4);
+}
+
+} // namespace vps::particles::test